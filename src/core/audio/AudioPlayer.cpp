@@ -1,5 +1,7 @@
 #include "AudioPlayer.h"
 
+#include <algorithm>  // for max
+
 #include "audio/AudioQueue.h"         // for AudioQueue
 #include "audio/DeviceInfo.h"         // for DeviceInfo
 #include "audio/PortAudioConsumer.h"  // for PortAudioConsumer
@@ -19,11 +21,20 @@ AudioPlayer::AudioPlayer(Control& control, Settings& settings):
 AudioPlayer::~AudioPlayer() { this->stop(); }
 
 auto AudioPlayer::start(fs::path const& file, unsigned int timestamp) -> bool {
+    if (!this->file.empty() && this->file == file) {
+        // Same recording, even if it was played to its end: seek in the decoded audio instead of opening the file
+        // again
+        this->vorbisProducer->seekTo(timestamp);
+        return isPlaying() || play();
+    }
+    stop();
+
     // Start the producer for reading the data
     bool status = this->vorbisProducer->start(file, timestamp);
 
     // Start playing
     if (status) {
+        this->file = file;
         status = status && this->play();
     }
 
@@ -32,6 +43,8 @@ auto AudioPlayer::start(fs::path const& file, unsigned int timestamp) -> bool {
 
 auto AudioPlayer::isPlaying() -> bool { return this->portAudioConsumer->isPlaying(); }
 
+auto AudioPlayer::hasPlayback() const -> bool { return !this->file.empty() && !this->audioQueue->hasStreamEnded(); }
+
 void AudioPlayer::pause() {
     if (!this->portAudioConsumer->isPlaying()) {
         return;
@@ -66,11 +79,20 @@ void AudioPlayer::stop() {
 
     // Reset the queue for the next playback
     this->audioQueue->reset();
+    this->file.clear();
 }
 
-void AudioPlayer::seek(int seconds) {
-    // set seek flag here in vorbisProducer
-    this->vorbisProducer->seek(seconds);
+void AudioPlayer::seek(int seconds) { this->vorbisProducer->seek(seconds); }
+
+auto AudioPlayer::getPlaybackPosition() -> size_t {
+    auto [sampleRate, channels] = this->audioQueue->getAudioAttributes();
+    if (!(sampleRate > 0)) {
+        return 0;
+    }
+    // The popped samples are still in the device buffers for the output latency
+    double seconds = static_cast<double>(this->audioQueue->getPosition()) / sampleRate;
+    seconds = std::max(0.0, seconds - this->portAudioConsumer->getOutputLatency());
+    return static_cast<size_t>(seconds * 1000.0);
 }
 
 auto AudioPlayer::getOutputDevices() -> std::vector<DeviceInfo> { return this->portAudioConsumer->getOutputDevices(); }
@@ -11,8 +11,9 @@
 
 #pragma once
 
-#include <memory>  // for make_unique, unique_ptr
-#include <vector>  // for vector
+#include <cstddef>  // for size_t
+#include <memory>   // for make_unique, unique_ptr
+#include <vector>   // for vector
 
 #include "filesystem.h"  // for path
 
@@ -34,13 +35,26 @@ public:
     auto operator=(AudioPlayer&&) -> AudioPlayer& = delete;
     ~AudioPlayer();
 
+    /**
+     * @brief Play the file from the timestamp (in milliseconds)
+     * If the file is already being played, the playback only seeks to the timestamp.
+     */
     bool start(fs::path const& file, unsigned int timestamp = 0);
     bool isPlaying();
+    /**
+     * @return Whether a file is being played or is paused, and can be continued with play()
+     */
+    bool hasPlayback() const;
     void stop();
     bool play();
     void pause();
     void seek(int seconds);
 
+    /**
+     * @return The position of the sample being heard, in milliseconds since the start of the file
+     */
+    size_t getPlaybackPosition();
+
     std::vector<DeviceInfo> getOutputDevices();
 
     Settings& getSettings();
@@ -50,6 +64,11 @@ private:
     Control& control;
     Settings& settings;
 
+    /**
+     * The file being played, empty once stopped
+     */
+    fs::path file;
+
     std::unique_ptr<AudioQueue<float>> audioQueue;
     std::unique_ptr<PortAudioConsumer> portAudioConsumer;
     std::unique_ptr<VorbisProducer> vorbisProducer;
@@ -13,8 +13,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
+#include <iterator>
 #include <limits>
 #include <mutex>
 
@@ -27,6 +29,7 @@ public:
         this->pushNotified = false;
         this->streamEnd = false;
         internalQueue.clear();
+        this->position = 0;
 
         this->sampleRate = -1;
         this->channels = 0;
@@ -51,6 +54,54 @@ public:
         this->pushLockCondition.notify_one();
     }
 
+    /**
+     * @brief Push the samples only if they continue the queued stream, i.e. if they start at getEndPosition().
+     * Lets a producer drop the samples it read before a call to flush().
+     * @return Whether the samples were pushed
+     */
+    template <typename Iter>
+    bool emplaceAt(size_t framePosition, Iter begI, Iter endI) {
+        std::lock_guard<std::mutex> lock(internalLock);
+        if (framePosition != endPositionUnlocked()) {
+            return false;
+        }
+        std::move(begI, endI, std::front_inserter(internalQueue));
+
+        this->pushNotified = true;
+        this->pushLockCondition.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Drop the queued samples: the stream continues at framePosition, even if it had ended. Wakes up the
+     * producer.
+     */
+    void flush(size_t framePosition) {
+        std::lock_guard<std::mutex> lock(internalLock);
+        internalQueue.clear();
+        this->position = framePosition;
+        this->streamEnd = false;
+
+        this->popNotified = true;
+        this->popLockCondition.notify_one();
+    }
+
+    /**
+     * @return The position in the stream, in frames, of the next frame to be popped
+     */
+    size_t getPosition() {
+        std::lock_guard<std::mutex> lock(internalLock);
+        return this->position;
+    }
+
+    /**
+     * @return The position in the stream, in frames, after the last queued frame
+     */
+    size_t getEndPosition() {
+        std::lock_guard<std::mutex> lock(internalLock);
+        return endPositionUnlocked();
+    }
+
     template <typename InsertIter>
     InsertIter pop(InsertIter insertIter, size_t nSamples) {
         std::lock_guard<std::mutex> lock(internalLock);
@@ -69,6 +120,7 @@ public:
 
         auto ret = std::move(begI, endI, insertIter);
         internalQueue.erase(endI.base(), begI.base());
+        this->position += returnBufferLength / this->channels;
 
         this->popNotified = true;
         this->popLockCondition.notify_one();
@@ -98,6 +150,23 @@ public:
         this->popNotified = false;
     }
 
+    /**
+     * @brief Wait while the stream has ended, until flush() resumes it or signalEndOfStream() is called again
+     */
+    void waitForResume(std::unique_lock<std::mutex>& lock) {
+        assert(lock.mutex() == &this->queueLock);
+        auto resumed = [this]() {
+            std::lock_guard<std::mutex> internal(internalLock);
+            return this->popNotified || !this->streamEnd;
+        };
+        while (!resumed()) {
+            // The notifications are sent without holding queueLock: do not sleep forever on a missed one
+            this->popLockCondition.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        std::lock_guard<std::mutex> internal(internalLock);
+        this->popNotified = false;
+    }
+
     bool hasStreamEnded() {
         std::lock_guard<std::mutex> lock(internalLock);
         return this->streamEnd;
@@ -127,6 +196,11 @@ public:
         return {this->sampleRate, this->channels};
     }
 
+private:
+    size_t endPositionUnlocked() const {
+        return this->channels == 0 ? this->position : this->position + internalQueue.size() / this->channels;
+    }
+
 private:
     std::mutex queueLock;
     std::mutex internalLock;
@@ -139,6 +213,11 @@ private:
     double sampleRate{std::numeric_limits<double>::quiet_NaN()};
     uint32_t channels{0};
 
+    /**
+     * Position in the stream of the next frame to pop, in frames. Only maintained for playback.
+     */
+    size_t position{0};
+
     bool streamEnd{false};
     bool pushNotified{false};
     bool popNotified{false};
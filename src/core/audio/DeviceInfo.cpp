@@ -8,6 +8,13 @@ DeviceInfo::DeviceInfo(portaudio::Device* device, bool selected):
         outputChannels((device->isFullDuplexDevice() || device->isOutputOnlyDevice()) ? device->maxOutputChannels() :
                                                                                         0) {}
 
+DeviceInfo::DeviceInfo(const DeviceInfo& device, bool selected):
+        deviceName(device.deviceName),
+        index(device.index),
+        selected(selected),
+        inputChannels(device.inputChannels),
+        outputChannels(device.outputChannels) {}
+
 auto DeviceInfo::getDeviceName() const -> const std::string& { return deviceName; }
 
 auto DeviceInfo::getIndex() const -> PaDeviceIndex { return index; }
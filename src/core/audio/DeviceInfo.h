@@ -18,6 +18,7 @@
 class DeviceInfo {
 public:
     DeviceInfo(portaudio::Device* device, bool selected);
+    DeviceInfo(const DeviceInfo& device, bool selected);
 
 public:
     const std::string& getDeviceName() const;
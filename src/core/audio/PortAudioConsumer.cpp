@@ -41,6 +41,10 @@ auto PortAudioConsumer::getSelectedOutputDevice() const -> DeviceInfo {
 
 auto PortAudioConsumer::isPlaying() const -> bool { return this->outputStream && this->outputStream->isActive(); }
 
+auto PortAudioConsumer::getOutputLatency() const -> double {
+    return this->outputStream ? this->outputStream->outputLatency() : 0.0;
+}
+
 auto PortAudioConsumer::startPlaying() -> bool {
     // Abort a playback stream if one is currently active
     if (isPlaying()) {
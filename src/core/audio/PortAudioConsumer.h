@@ -30,6 +30,10 @@ public:
     std::vector<DeviceInfo> getOutputDevices() const;
     DeviceInfo getSelectedOutputDevice() const;
     bool isPlaying() const;
+    /**
+     * @return The latency of the output stream in seconds, 0 if there is none
+     */
+    double getOutputLatency() const;
     bool startPlaying();
     int playCallback(const void* inputBuffer, void* outputBuffer, unsigned long framesPerBuffer,
                      const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags);
@@ -1,8 +1,10 @@
 #include "VorbisProducer.h"
 
-#include <algorithm>  // for fill_n, max
-#include <cstdio>     // for size_t, SEEK_CUR, SEEK_SET
-#include <iterator>   // for begin, end
+#include <algorithm>  // for clamp, max, min
+#include <cstddef>    // for ptrdiff_t
+#include <cstdio>     // for size_t, SEEK_SET
+#include <iterator>   // for begin, next
+#include <map>        // for map
 #include <memory>     // for unique_ptr
 #include <string>     // for string
 #include <utility>    // for move
@@ -18,6 +20,19 @@ using namespace xoj;
 
 constexpr auto sample_buffer_size = size_t{16384U};
 
+namespace {
+/**
+ * Frames pushed to the queue at once
+ */
+constexpr sf_count_t CHUNK_FRAMES = 1024;
+
+/**
+ * Decoded blocks kept before and after the playhead, in seconds
+ */
+constexpr sf_count_t BLOCKS_BEHIND = 30;
+constexpr sf_count_t BLOCKS_AHEAD = 10;
+}  // namespace
+
 auto VorbisProducer::start(fs::path const& file, unsigned int timestamp) -> bool {
     SF_INFO sfInfo{};
     auto sfFile = audio::make_snd_file(file, SFM_READ, &sfInfo);
@@ -27,46 +42,104 @@ auto VorbisProducer::start(fs::path const& file, unsigned int timestamp) -> bool
         return false;
     }
 
-    sf_count_t seekPosition = sfInfo.samplerate / 1000 * sf_count_t(timestamp);
-
-    if (seekPosition < sfInfo.frames) {
-        sf_seek(sfFile.get(), seekPosition, SEEK_SET);
-    } else {
+    sf_count_t seekPosition = sf_count_t(sfInfo.samplerate) * sf_count_t(timestamp) / 1000;
+    if (seekPosition >= sfInfo.frames) {
         g_warning("VorbisProducer: Seeking outside of audio file extent");
+        seekPosition = 0;
     }
 
+    this->totalFrames = sfInfo.frames;
     this->audioQueue.setAudioAttributes(sfInfo.samplerate, static_cast<unsigned int>(sfInfo.channels));
+    this->audioQueue.flush(static_cast<size_t>(seekPosition));
 
-    this->producerThread = std::thread([this, sfInfo, sfFile = std::move(sfFile)] {
-        sf_count_t numFrames{1};
-        size_t const bufferSize{size_t(1024U) * size_t(sfInfo.channels)};
-        std::vector<float> sampleBuffer(bufferSize);
-        auto lock = audioQueue.acquire_lock();
+    this->producerThread = std::thread(
+            [this, sfInfo, sfFile = std::move(sfFile)]() mutable { decode(std::move(sfFile), sfInfo); });
+    return true;
+}
 
-        while (!this->stopProducer && numFrames > 0 && !this->audioQueue.hasStreamEnded()) {
-            sampleBuffer.resize(bufferSize);
-            numFrames = sf_readf_float(sfFile.get(), sampleBuffer.data(), 1024);
-            sampleBuffer.resize(size_t(numFrames * sfInfo.channels));
+void VorbisProducer::decode(audio::SNDFileGuard file, SF_INFO info) {
+    const auto channels = static_cast<size_t>(info.channels);
+    const sf_count_t blockFrames = std::max<sf_count_t>(info.samplerate, CHUNK_FRAMES);
 
-            while (this->audioQueue.size() >= sample_buffer_size && !this->audioQueue.hasStreamEnded() &&
-                   !this->stopProducer) {
-                audioQueue.waitForConsumer(lock);
-            }
+    std::map<sf_count_t, std::vector<float>> blocks;
+    sf_count_t filePosition = 0;
 
-            if (auto tmpSeekSeconds = this->seekSeconds.load(); tmpSeekSeconds != 0) {
-                sf_seek(sfFile.get(), tmpSeekSeconds * sfInfo.samplerate, SEEK_CUR);
-                this->seekSeconds -= tmpSeekSeconds;
+    auto decodeBlock = [&](sf_count_t index) -> const std::vector<float>& {
+        if (auto it = blocks.find(index); it != blocks.end()) {
+            return it->second;
+        }
+
+        std::vector<float> samples;
+        const sf_count_t first = index * blockFrames;
+        if (filePosition != first) {
+            filePosition = sf_seek(file.get(), first, SEEK_SET);
+        }
+        if (filePosition == first) {
+            samples.resize(static_cast<size_t>(blockFrames) * channels);
+            sf_count_t numFrames = std::max<sf_count_t>(0, sf_readf_float(file.get(), samples.data(), blockFrames));
+            samples.resize(static_cast<size_t>(numFrames) * channels);
+            filePosition += numFrames;
+        } else {
+            g_warning("VorbisProducer: Could not seek to frame %ld", static_cast<long>(first));
+        }
+        return blocks.emplace(index, std::move(samples)).first->second;
+    };
+
+    auto lock = audioQueue.acquire_lock();
+    while (!this->stopProducer) {
+        if (this->audioQueue.hasStreamEnded()) {
+            // The file was played to its end: a seek resumes the stream, until the producer is stopped
+            this->audioQueue.waitForResume(lock);
+            continue;
+        }
+
+        // The end of the queued audio, or the target of the last seek
+        const auto frame = static_cast<sf_count_t>(this->audioQueue.getEndPosition());
+        const sf_count_t index = frame / blockFrames;
+        const std::vector<float>& block = decodeBlock(index);
+
+        const sf_count_t offset = frame - index * blockFrames;
+        const sf_count_t available = static_cast<sf_count_t>(block.size() / channels) - offset;
+        if (available <= 0) {
+            // End of file: the consumer plays the queued samples and stops
+            this->audioQueue.signalEndOfStream();
+            continue;
+        }
+        auto first = std::next(begin(block), static_cast<std::ptrdiff_t>(static_cast<size_t>(offset) * channels));
+        auto last = std::next(first, static_cast<std::ptrdiff_t>(
+                                             static_cast<size_t>(std::min(available, CHUNK_FRAMES)) * channels));
+        // Dropped if there was a seek in the meantime
+        this->audioQueue.emplaceAt(static_cast<size_t>(frame), first, last);
+
+        // Forget the blocks far from the playhead
+        for (auto it = blocks.begin(); it != blocks.end();) {
+            if (it->first < index - BLOCKS_BEHIND || it->first > index + BLOCKS_AHEAD) {
+                it = blocks.erase(it);
+            } else {
+                ++it;
             }
+        }
 
-            this->audioQueue.emplace(begin(sampleBuffer), end(sampleBuffer));
+        while (this->audioQueue.size() >= sample_buffer_size && !this->audioQueue.hasStreamEnded() &&
+               !this->stopProducer) {
+            // Prebuffer the next blocks while the consumer catches up
+            sf_count_t next = index + 1;
+            while (next <= index + BLOCKS_AHEAD && next * blockFrames < info.frames && blocks.count(next)) {
+                next++;
+            }
+            if (next <= index + BLOCKS_AHEAD && next * blockFrames < info.frames) {
+                decodeBlock(next);
+                continue;
+            }
+            audioQueue.waitForConsumer(lock);
         }
-        this->audioQueue.signalEndOfStream();
-    });
-    return true;
+    }
+    this->audioQueue.signalEndOfStream();
 }
-
 void VorbisProducer::abort() {
     this->stopProducer = true;
+    // Wakes up the producer, if it waits for a seek at the end of the file
+    this->audioQueue.signalEndOfStream();
     // Wait for producer to finish
     stop();
     this->stopProducer = false;
@@ -80,4 +153,25 @@ void VorbisProducer::stop() {
 }
 
 
-void VorbisProducer::seek(int seconds) { this->seekSeconds = seconds; }
+void VorbisProducer::seek(int seconds) {
+    auto [sampleRate, channels] = this->audioQueue.getAudioAttributes();
+    if (!(sampleRate > 0)) {
+        return;
+    }
+    auto frame = static_cast<int64_t>(this->audioQueue.getPosition()) + static_cast<int64_t>(seconds * sampleRate);
+    seekToFrame(frame);
+}
+
+void VorbisProducer::seekTo(size_t timestamp) {
+    auto [sampleRate, channels] = this->audioQueue.getAudioAttributes();
+    if (!(sampleRate > 0)) {
+        return;
+    }
+    seekToFrame(static_cast<int64_t>(static_cast<double>(timestamp) * sampleRate / 1000.0));
+}
+
+void VorbisProducer::seekToFrame(int64_t frame) {
+    frame = std::clamp<int64_t>(frame, 0, std::max<int64_t>(0, this->totalFrames - 1));
+    // The producer resumes from there, using the decoded blocks if possible
+    this->audioQueue.flush(static_cast<size_t>(frame));
+}
@@ -11,14 +11,28 @@
 
 #pragma once
 
-#include <atomic>  // for atomic
-#include <thread>  // for thread
+#include <atomic>   // for atomic
+#include <cstdint>  // for int64_t
+#include <thread>   // for thread
 
+#include <sndfile.h>  // for SF_INFO
+
+#include "SNDFileCpp.h"  // for SNDFileGuard
 #include "filesystem.h"  // for path
 
 template <typename T>
 class AudioQueue;
 
+/**
+ * @brief Decodes an audio file into the playback queue
+ *
+ * The file is decoded in blocks of one second, and the blocks around the playhead are kept: seeking in this window
+ * does not decode anything, the queue is flushed and filled again from the decoded blocks. While the queue is full, the
+ * blocks following the playhead are decoded in advance.
+ *
+ * Once the end of the file is queued, the stream is ended but the producer keeps running until abort(): seeking
+ * resumes the stream.
+ */
 class VorbisProducer final {
 public:
     explicit VorbisProducer(AudioQueue<float>& audioQueue): audioQueue(audioQueue) {}
@@ -26,12 +40,25 @@ public:
     bool start(fs::path const& file, unsigned int timestamp);
     void abort();
     void stop();
+
+    /**
+     * @brief Move the playhead by the given number of seconds
+     */
     void seek(int seconds);
 
+    /**
+     * @brief Move the playhead to the timestamp, in milliseconds
+     */
+    void seekTo(size_t timestamp);
+
+private:
+    void seekToFrame(int64_t frame);
+    void decode(xoj::audio::SNDFileGuard file, SF_INFO info);
+
 private:
     AudioQueue<float>& audioQueue;
     std::thread producerThread{};
 
     std::atomic<bool> stopProducer{false};
-    std::atomic<int> seekSeconds{0};
+    std::atomic<int64_t> totalFrames{0};
 };
@@ -9,7 +9,6 @@
 
 #include "audio/AudioPlayer.h"                   // for AudioPlayer
 #include "audio/AudioRecorder.h"                 // for AudioRecorder
-#include "audio/DeviceInfo.h"                    // for DeviceInfo
 #include "control/Control.h"                     // for Control
 #include "control/settings/Settings.h"           // for Settings
 #include "gui/MainWindow.h"                      // for MainWindow
@@ -21,14 +20,32 @@
 using std::string;
 using std::vector;
 
-AudioController::AudioController(Settings* settings, Control* control):
-        settings(*settings),
-        control(*control),
-        audioRecorder(std::make_unique<AudioRecorder>(*settings)),
-        audioPlayer(std::make_unique<AudioPlayer>(*control, *settings)) {}
+AudioController::AudioController(Settings* settings, Control* control): settings(*settings), control(*control) {}
 
 AudioController::~AudioController() = default;
 
+void AudioController::initAudioSystem() {
+    if (!this->autoSys) {
+        this->autoSys = std::make_unique<portaudio::AutoSystem>();
+    }
+}
+
+auto AudioController::getRecorder() -> AudioRecorder& {
+    if (!this->audioRecorder) {
+        initAudioSystem();
+        this->audioRecorder = std::make_unique<AudioRecorder>(this->settings);
+    }
+    return *this->audioRecorder;
+}
+
+auto AudioController::getPlayer() -> AudioPlayer& {
+    if (!this->audioPlayer) {
+        initAudioSystem();
+        this->audioPlayer = std::make_unique<AudioPlayer>(this->control, this->settings);
+    }
+    return *this->audioPlayer;
+}
+
 
 auto AudioController::startRecording() -> bool {
     if (!this->isRecording()) {
@@ -51,11 +68,13 @@ auto AudioController::startRecording() -> bool {
 
         g_message("Start recording");
 
-        bool isRecording = this->audioRecorder->start(getAudioFolder() / data);
+        bool isRecording = getRecorder().start(getAudioFolder() / data);
 
         if (!isRecording) {
             audioFilename = "";
             this->timestamp = 0;
+            // The device may have been unplugged: look for the devices again on the next try
+            invalidateDevices();
         }
 
         return isRecording;
@@ -64,7 +83,7 @@ auto AudioController::startRecording() -> bool {
 }
 
 auto AudioController::stopRecording() -> bool {
-    if (this->audioRecorder->isRecording()) {
+    if (isRecording()) {
         audioFilename = "";
         this->timestamp = 0;
 
@@ -75,13 +94,14 @@ auto AudioController::stopRecording() -> bool {
     return true;
 }
 
-auto AudioController::isRecording() -> bool { return this->audioRecorder->isRecording(); }
+auto AudioController::isRecording() -> bool { return this->audioRecorder && this->audioRecorder->isRecording(); }
+
+auto AudioController::isPlaying() -> bool { return this->audioPlayer && this->audioPlayer->isPlaying(); }
 
-auto AudioController::isPlaying() -> bool { return this->audioPlayer->isPlaying(); }
+auto AudioController::hasPlayback() const -> bool { return this->audioPlayer && this->audioPlayer->hasPlayback(); }
 
 auto AudioController::startPlayback(fs::path const& file, unsigned int timestamp) -> bool {
-    this->audioPlayer->stop();
-    bool status = this->audioPlayer->start(file, timestamp);
+    bool status = getPlayer().start(file, timestamp);
     if (status) {
         this->control.getWindow()->getToolMenuHandler()->enableAudioPlaybackButtons();
     }
@@ -91,22 +111,34 @@ auto AudioController::startPlayback(fs::path const& file, unsigned int timestamp
 void AudioController::pausePlayback() {
     this->control.getWindow()->getToolMenuHandler()->setAudioPlaybackPaused(true);
 
-    this->audioPlayer->pause();
+    if (this->audioPlayer) {
+        this->audioPlayer->pause();
+    }
 }
 
-void AudioController::seekForwards() { this->audioPlayer->seek(this->settings.getDefaultSeekTime()); }
+void AudioController::seekForwards() {
+    if (this->audioPlayer) {
+        this->audioPlayer->seek(this->settings.getDefaultSeekTime());
+    }
+}
 
-void AudioController::seekBackwards() { this->audioPlayer->seek(-1 * this->settings.getDefaultSeekTime()); }
+void AudioController::seekBackwards() {
+    if (this->audioPlayer) {
+        this->audioPlayer->seek(-1 * this->settings.getDefaultSeekTime());
+    }
+}
 
 void AudioController::continuePlayback() {
     this->control.getWindow()->getToolMenuHandler()->setAudioPlaybackPaused(false);
 
-    this->audioPlayer->play();
+    getPlayer().play();
 }
 
 void AudioController::stopPlayback() {
     this->control.getWindow()->getToolMenuHandler()->disableAudioPlaybackButtons();
-    this->audioPlayer->stop();
+    if (this->audioPlayer) {
+        this->audioPlayer->stop();
+    }
 }
 
 auto AudioController::getAudioFilename() const -> fs::path const& { return this->audioFilename; }
@@ -126,6 +158,46 @@ auto AudioController::getAudioFolder() const -> fs::path {
 
 auto AudioController::getStartTime() const -> size_t { return this->timestamp; }
 
-auto AudioController::getOutputDevices() const -> vector<DeviceInfo> { return this->audioPlayer->getOutputDevices(); }
+auto AudioController::getPlaybackPosition() const -> size_t {
+    return this->audioPlayer ? this->audioPlayer->getPlaybackPosition() : 0;
+}
+
+auto AudioController::getOutputDevices() -> vector<DeviceInfo> {
+    if (!this->outputDevices) {
+        this->outputDevices = getPlayer().getOutputDevices();
+    }
+
+    vector<DeviceInfo> devices;
+    devices.reserve(this->outputDevices->size());
+    for (const auto& device: *this->outputDevices) {
+        devices.emplace_back(device, device.getIndex() == this->settings.getAudioOutputDevice());
+    }
+    return devices;
+}
+
+auto AudioController::getInputDevices() -> vector<DeviceInfo> {
+    if (!this->inputDevices) {
+        this->inputDevices = getRecorder().getInputDevices();
+    }
 
-auto AudioController::getInputDevices() const -> vector<DeviceInfo> { return this->audioRecorder->getInputDevices(); }
+    vector<DeviceInfo> devices;
+    devices.reserve(this->inputDevices->size());
+    for (const auto& device: *this->inputDevices) {
+        devices.emplace_back(device, device.getIndex() == this->settings.getAudioInputDevice());
+    }
+    return devices;
+}
+
+void AudioController::invalidateDevices() {
+    if (isRecording() || isPlaying() || hasPlayback()) {
+        return;
+    }
+
+    this->inputDevices.reset();
+    this->outputDevices.reset();
+
+    // PortAudio only looks for devices on initialization
+    this->audioPlayer.reset();
+    this->audioRecorder.reset();
+    this->autoSys.reset();
+}
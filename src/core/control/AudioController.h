@@ -12,17 +12,18 @@
 #pragma once
 
 #include <cstddef>  // for size_t
-#include <memory>   // for make_unique, unique_ptr
-#include <vector>   // for vector
+#include <memory>    // for make_unique, unique_ptr
+#include <optional>  // for optional
+#include <vector>    // for vector
 
 #include <portaudiocpp/PortAudioCpp.hxx>  // for AutoSystem
 
-#include "filesystem.h"  // for path
+#include "audio/DeviceInfo.h"  // for DeviceInfo
+#include "filesystem.h"        // for path
 
 class AudioPlayer;
 class AudioRecorder;
 class Control;
-class DeviceInfo;
 class Settings;
 
 class AudioController final {
@@ -36,6 +37,10 @@ public:
     bool isRecording();
 
     bool isPlaying();
+    /**
+     * @return Whether a playback is in progress, even if paused
+     */
+    bool hasPlayback() const;
     bool startPlayback(fs::path const& file, unsigned int timestamp);
     void pausePlayback();
     void continuePlayback();
@@ -43,24 +48,52 @@ public:
     void seekForwards();
     void seekBackwards();
 
+    /**
+     * @return The position of the playback in the played file, in milliseconds
+     */
+    size_t getPlaybackPosition() const;
+
     fs::path const& getAudioFilename() const;
     fs::path getAudioFolder() const;
     size_t getStartTime() const;
-    std::vector<DeviceInfo> getOutputDevices() const;
-    std::vector<DeviceInfo> getInputDevices() const;
+
+    /**
+     * The device lists are cached: PortAudio only enumerates the devices when it is initialized. Call
+     * invalidateDevices() first to look for devices plugged in since then.
+     */
+    std::vector<DeviceInfo> getOutputDevices();
+    std::vector<DeviceInfo> getInputDevices();
+
+    /**
+     * @brief Forget the devices found by PortAudio, e.g. because the selected device was unplugged
+     * PortAudio is initialized again (and the devices enumerated again) on the next use. Does nothing while recording,
+     * playing or paused.
+     */
+    void invalidateDevices();
+
+private:
+    /**
+     * Initialize PortAudio, and create the recorder and the player on first use
+     */
+    AudioRecorder& getRecorder();
+    AudioPlayer& getPlayer();
+    void initAudioSystem();
 
 private:
     Settings& settings;
     Control& control;
 
     /**
-     * RAII initializer don't move below the portaudio::System::instance() calls in
-     * AudioRecorder and AudioPlayer
+     * RAII initializer. Created before, and destroyed after, the recorder and the player (they use
+     * portaudio::System::instance())
      * */
-    portaudio::AutoSystem autoSys;
+    std::unique_ptr<portaudio::AutoSystem> autoSys;
     std::unique_ptr<AudioRecorder> audioRecorder;
     std::unique_ptr<AudioPlayer> audioPlayer;
 
+    std::optional<std::vector<DeviceInfo>> inputDevices;
+    std::optional<std::vector<DeviceInfo>> outputDevices;
+
     fs::path audioFilename;
     size_t timestamp = 0;
 };
@@ -1,6 +1,6 @@
 #include "Control.h"
 
-#include <algorithm>  // for max
+#include <algorithm>  // for max, sort, unique
 #include <cstdlib>    // for size_t
 #include <exception>  // for exce...
 #include <iterator>   // for end
@@ -103,13 +103,14 @@
 #include "LatexController.h"                 // for Late...
 #include "PageBackgroundChangeController.h"  // for Page...
 #include "PrintHandler.h"                    // for print
+#include "StartupProfile.h"                  // for StartupProfile
 #include "UndoRedoController.h"              // for Undo...
 #include "config-dev.h"                      // for SETT...
 #include "config.h"                          // for PROJ...
 
 using std::string;
 
-Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath): gtkApp(gtkApp) {
+Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath, StartupProfile& profile): gtkApp(gtkApp) {
     this->undoRedo = new UndoRedoHandler(this);
     this->undoRedo->addUndoRedoListener(this);
     this->isBlocking = false;
@@ -128,11 +129,11 @@ Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath): gtkApp
     this->settings->load();
 
     this->applyPreferredLanguage();
+    profile.phaseDone("Load settings");
 
     this->pageTypes = new PageTypeHandler(gladeSearchPath);
     this->newPageType = std::make_unique<PageTypeMenu>(this->pageTypes, settings, true, true);
-
-    this->audioController = new AudioController(this->settings, this);
+    profile.phaseDone("Load page types");
 
     this->scrollHandler = new ScrollHandler(this);
 
@@ -151,6 +152,7 @@ Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath): gtkApp
     this->toolHandler = new ToolHandler(this, this, this->settings);
     this->toolHandler->loadSettings();
     this->initButtonTool();
+    profile.phaseDone("Load tools");
 
     /**
      * This is needed to update the previews
@@ -166,6 +168,12 @@ Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath): gtkApp
 
     this->pluginController = new PluginController(this);
     this->pluginController->registerToolbar();
+    profile.phaseDone("Load plugins");
+}
+
+void Control::initDeferred(StartupProfile& profile) {
+    getAudioController();
+    profile.phaseDone("Initialize audio");
 }
 
 Control::~Control() {
@@ -272,15 +280,21 @@ auto Control::checkChangedDocument(Control* control) -> bool {
         // call again later
         return true;
     }
+    std::vector<size_t> pages;
+    pages.reserve(control->changedPages.size());
     for (auto const& page: control->changedPages) {
         auto p = control->doc->indexOf(page);
         if (p != npos) {
-            for (DocumentListener* dl: control->changedDocumentListeners) {
-                dl->pageChanged(p);
-            }
+            pages.push_back(p);
         }
     }
     control->changedPages.clear();
+
+    if (!pages.empty()) {
+        std::sort(pages.begin(), pages.end());
+        pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+        for (DocumentListener* dl: control->changedDocumentListeners) { dl->pagesChanged(pages); }
+    }
     control->doc->unlock();
 
     // Call again
@@ -1002,9 +1016,9 @@ void Control::actionPerformed(ActionType type, ActionGroup group, GtkToolButton*
         case ACTION_AUDIO_RECORD: {
             bool result = false;
             if (enabled) {
-                result = audioController->startRecording();
+                result = getAudioController()->startRecording();
             } else {
-                result = audioController->stopRecording();
+                result = getAudioController()->stopRecording();
             }
 
             if (!result) {
@@ -1878,11 +1892,7 @@ void Control::undoRedoChanged() {
     updateWindowTitle();
 }
 
-void Control::undoRedoPageChanged(PageRef page) {
-    if (std::find(begin(this->changedPages), end(this->changedPages), page) == end(this->changedPages)) {
-        this->changedPages.emplace_back(std::move(page));
-    }
-}
+void Control::undoRedoPageChanged(PageRef page) { this->changedPages.emplace(std::move(page)); }
 
 void Control::selectTool(ToolType type) {
     // keep text-selection when switching from text to seletion tool
@@ -2803,7 +2813,9 @@ void Control::quit(bool allowCancel) {
         return;
     }
 
-    audioController->stopRecording();
+    if (this->audioController) {
+        this->audioController->stopRecording();
+    }
     this->scheduler->lock();
     this->scheduler->removeAllJobs();
     this->scheduler->unlock();
@@ -3284,7 +3296,14 @@ auto Control::getSidebar() const -> Sidebar* { return this->sidebar; }
 
 auto Control::getSearchBar() const -> SearchBar* { return this->searchBar; }
 
-auto Control::getAudioController() const -> AudioController* { return this->audioController; }
+auto Control::getAudioController() const -> AudioController* {
+    if (!this->audioController) {
+        this->audioController = new AudioController(this->settings, const_cast<Control*>(this));
+    }
+    return this->audioController;
+}
+
+auto Control::hasAudioController() const -> bool { return this->audioController != nullptr; }
 
 auto Control::getPageTypes() const -> PageTypeHandler* { return this->pageTypes; }
 
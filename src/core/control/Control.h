@@ -13,8 +13,9 @@
 
 #include <cstddef>  // for size_t
 #include <memory>   // for unique_ptr
-#include <string>   // for string, allocator
-#include <vector>   // for vector
+#include <string>         // for string, allocator
+#include <unordered_set>  // for unordered_set
+#include <vector>         // for vector
 
 #include <gdk-pixbuf/gdk-pixbuf.h>  // for GdkPixbuf
 #include <gio/gio.h>                // for GApplication
@@ -61,6 +62,7 @@ class ObjectInputStream;
 class ScrollHandler;
 class SearchBar;
 class Settings;
+class StartupProfile;
 class TextEditor;
 class XournalScheduler;
 class ZoomControl;
@@ -75,7 +77,7 @@ class Control:
         public ClipboardListener,
         public ProgressListener {
 public:
-    Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath);
+    Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath, StartupProfile& profile);
     Control(Control const&) = delete;
     Control(Control&&) = delete;
     auto operator=(Control const&) -> Control& = delete;
@@ -84,6 +86,11 @@ public:
 
     void initWindow(MainWindow* win);
 
+    /**
+     * Initialize the parts which are not needed to show the first window. Called once the window is shown.
+     */
+    void initDeferred(StartupProfile& profile);
+
 public:
     // Menu File
     bool newFile(std::string pageTemplate = "", fs::path filepath = {});
@@ -279,6 +286,10 @@ public:
     Sidebar* getSidebar() const;
     SearchBar* getSearchBar() const;
     AudioController* getAudioController() const;
+    /**
+     * @return Whether the audio controller was already created: getAudioController() creates it on first use
+     */
+    bool hasAudioController() const;
     PageTypeHandler* getPageTypes() const;
     PageTypeMenu* getNewPageType() const;
     PageBackgroundChangeController* getPageBackgroundChangeController() const;
@@ -406,7 +417,10 @@ private:
 
     ScrollHandler* scrollHandler;
 
-    AudioController* audioController;
+    /**
+     * Created by initDeferred(), or on first use if needed before
+     */
+    mutable AudioController* audioController = nullptr;
 
     ToolbarDragDropHandler* dragDropHandler = nullptr;
 
@@ -425,7 +439,7 @@ private:
     /**
      * The pages wihch has changed since the last update (for preview update)
      */
-    std::vector<PageRef> changedPages;
+    std::unordered_set<PageRef> changedPages;
 
     /**
      * DocumentListener instances that are to be updated by checkChangedDocument.
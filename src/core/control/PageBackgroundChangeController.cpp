@@ -3,6 +3,7 @@
 #include <memory>   // for __shared_ptr...
 #include <string>   // for allocator
 #include <utility>  // for move
+#include <vector>   // for vector
 
 #include <gdk-pixbuf/gdk-pixbuf.h>  // for gdk_pixbuf_g...
 #include <gio/gio.h>                // for GFile
@@ -52,13 +53,20 @@ void PageBackgroundChangeController::changeAllPagesBackground(const PageType& pt
 
     auto groupUndoAction = std::make_unique<GroupUndoAction>();
 
+    std::vector<size_t> changedPages;
+    changedPages.reserve(doc->getPageCount());
     for (size_t p = 0; p < doc->getPageCount(); p++) {
         auto undoAction = commitPageTypeChange(p, pt);
         if (undoAction) {
             groupUndoAction->addAction(std::move(undoAction));
+            changedPages.push_back(p);
         }
     }
 
+    // Notify all the pages at once
+    control->firePagesChanged(changedPages);
+    control->updateBackgroundSizeButton();
+
     control->getUndoRedoHandler()->addUndoAction(std::move(groupUndoAction));
 
     ignoreEvent = true;
@@ -88,6 +96,8 @@ void PageBackgroundChangeController::changeCurrentPageBackground(PageType& pageT
 
     auto undoAction = commitPageTypeChange(pageNr, pageType);
     if (undoAction) {
+        control->firePageChanged(pageNr);
+        control->updateBackgroundSizeButton();
         control->getUndoRedoHandler()->addUndoAction(std::move(undoAction));
     }
 
@@ -103,10 +113,6 @@ auto PageBackgroundChangeController::commitPageTypeChange(const size_t pageNum,
         return {};
     }
 
-    Document* doc = control->getDocument();
-    const size_t pageNr = doc->indexOf(page);
-    g_assert(pageNr != npos);
-
     // Get values for Undo / Redo
     const double origW = page->getWidth();
     const double origH = page->getHeight();
@@ -121,9 +127,6 @@ auto PageBackgroundChangeController::commitPageTypeChange(const size_t pageNum,
         g_warning("Found 'Copy' page type. Doing nothing™.");
     }
 
-
-    control->firePageChanged(pageNr);
-    control->updateBackgroundSizeButton();
     return std::make_unique<PageBackgroundChangedUndoAction>(page, origType, origPdfPage, origBackgroundImage, origW,
                                                              origH);
 }
@@ -82,7 +82,7 @@ private:
     bool applyImageBackground(PageRef page);
 
     /**
-     * Perform the page type change.
+     * Perform the page type change. The caller notifies the change of the page.
      */
     auto commitPageTypeChange(size_t pageNum, const PageType& pageType) -> std::unique_ptr<UndoAction>;
 
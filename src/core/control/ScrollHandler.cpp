@@ -132,3 +132,5 @@ auto ScrollHandler::isPageVisible(size_t page, int* visibleHeight) -> bool {
 }
 
 void ScrollHandler::pageChanged(size_t page) { scrollToSpinPage(); }
+
+void ScrollHandler::pagesChanged(const std::vector<size_t>& pages) { scrollToSpinPage(); }
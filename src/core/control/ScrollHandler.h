@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstddef>  // for size_t
+#include <vector>   // for vector
 
 #include "gui/widgets/SpinPageAdapter.h"  // for SpinPageListener
 #include "model/PageRef.h"                // for PageRef
@@ -51,6 +52,7 @@ public:
 
 public:
     void pageChanged(size_t page) override;
+    void pagesChanged(const std::vector<size_t>& pages) override;
 
 private:
     void scrollToSpinPage();
@@ -0,0 +1,35 @@
+#include "StartupProfile.h"
+
+#include <iomanip>  // for setw, setprecision
+#include <utility>  // for move
+
+#include <glib.h>  // for g_get_monotonic_time
+
+StartupProfile::StartupProfile(bool enabled): enabled(enabled), start(g_get_monotonic_time()) {}
+
+void StartupProfile::setEnabled(bool enabled) { this->enabled = enabled; }
+
+auto StartupProfile::isEnabled() const -> bool { return this->enabled; }
+
+void StartupProfile::phaseDone(std::string name) {
+    if (!this->enabled) {
+        return;
+    }
+    this->phases.push_back({std::move(name), g_get_monotonic_time()});
+}
+
+void StartupProfile::report(std::ostream& out) const {
+    if (!this->enabled) {
+        return;
+    }
+
+    out << "Startup profile (ms):" << std::endl;
+    out << std::fixed << std::setprecision(1);
+    int64_t previous = this->start;
+    for (const auto& phase: this->phases) {
+        const double duration = static_cast<double>(phase.end - previous) / 1000.0;
+        const double elapsed = static_cast<double>(phase.end - this->start) / 1000.0;
+        out << std::setw(10) << duration << std::setw(10) << elapsed << "  " << phase.name << std::endl;
+        previous = phase.end;
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * Xournal++
+ *
+ * Timings of the application startup
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstdint>  // for int64_t
+#include <ostream>  // for ostream
+#include <string>   // for string
+#include <vector>   // for vector
+
+/**
+ * @brief Measures the duration of the startup phases, for --startup-profile
+ *
+ * The phases are consecutive: each one lasts from the end of the previous one (or the creation of the profile) to the
+ * call to phaseDone(). Does nothing if disabled.
+ */
+class StartupProfile {
+public:
+    explicit StartupProfile(bool enabled = false);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * @brief Ends the current phase
+     */
+    void phaseDone(std::string name);
+
+    /**
+     * @brief Print the duration of each phase, and the time elapsed since the start
+     */
+    void report(std::ostream& out) const;
+
+private:
+    struct Phase {
+        std::string name;
+        int64_t end;  ///< In microseconds, as g_get_monotonic_time()
+    };
+
+    bool enabled;
+    int64_t start;
+    std::vector<Phase> phases;
+};
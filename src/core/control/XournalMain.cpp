@@ -40,12 +40,13 @@
 #include "util/XojMsgBox.h"                  // for XojMsgBox
 #include "util/i18n.h"                       // for _, FS, _F
 
-#include "Control.h"       // for Control
-#include "ExportHelper.h"  // for exportImg, exportPdf
-#include "config-dev.h"    // for ERRORLOG_DIR
-#include "config-git.h"    // for GIT_BRANCH, GIT_ORIGIN_O...
-#include "config.h"        // for GETTEXT_PACKAGE, ENABLE_NLS
-#include "filesystem.h"    // for path, operator/, exists
+#include "Control.h"         // for Control
+#include "ExportHelper.h"    // for exportImg, exportPdf
+#include "StartupProfile.h"  // for StartupProfile
+#include "config-dev.h"      // for ERRORLOG_DIR
+#include "config-git.h"      // for GIT_BRANCH, GIT_ORIGIN_O...
+#include "config.h"          // for GETTEXT_PACKAGE, ENABLE_NLS
+#include "filesystem.h"      // for path, operator/, exists
 
 namespace {
 
@@ -324,6 +325,8 @@ struct XournalMainPrivate {
     gchar* pdfFilename{};
     gchar* imgFilename{};
     gboolean showVersion = false;
+    gboolean saveUncompressed = false;
+    gboolean saveCompressed = false;
     int openAtPageNumber = 0;  // when no --page is used, the document opens at the page specified in the metadata file
     gchar* exportRange{};
     gchar* exportLayerRange{};
@@ -333,6 +336,9 @@ struct XournalMainPrivate {
     gboolean exportNoBackground = false;
     gboolean exportNoRuling = false;
     gboolean progressiveMode = false;
+    gboolean startupProfile = false;
+    StartupProfile profile;
+    guint firstDrawHandler = 0;
     std::unique_ptr<GladeSearchpath> gladePath;
     std::unique_ptr<Control> control;
     std::unique_ptr<MainWindow> win;
@@ -430,7 +436,34 @@ void on_open_files(GApplication*, gpointer, gint, gchar*, XMPtr) {
     // Todo: implement this, if someone files the bug report
 }
 
+/// Initializes what is not needed to show the first window
+void init_deferred(XMPtr app_data) {
+    app_data->control->initDeferred(app_data->profile);
+
+    auto& globalLatexTemplatePath = app_data->control->getSettings()->latexSettings.globalTemplatePath;
+    if (globalLatexTemplatePath.empty()) {
+        globalLatexTemplatePath = findResourcePath("resources/") / "default_template.tex";
+        g_message("Using default latex template in %s", globalLatexTemplatePath.string().c_str());
+        app_data->control->getSettings()->save();
+    }
+    app_data->profile.phaseDone("Find LaTeX template");
+
+    app_data->profile.report(std::cout);
+}
+
+auto on_first_draw(GtkWidget* window, cairo_t*, XMPtr app_data) -> gboolean {
+    g_signal_handler_disconnect(window, app_data->firstDrawHandler);
+    app_data->firstDrawHandler = 0;
+    app_data->profile.phaseDone("Draw first window");
+
+    // Once the window is drawn, on idle
+    Util::execInUiThread([app_data]() { init_deferred(app_data); }, G_PRIORITY_LOW);
+    return false;
+}
+
 void on_startup(GApplication* application, XMPtr app_data) {
+    app_data->profile.setEnabled(app_data->startupProfile);
+
     initLocalisation();
     ensure_input_model_compatibility();
     const MigrateResult migrateResult = migrateSettings();
@@ -438,8 +471,13 @@ void on_startup(GApplication* application, XMPtr app_data) {
     app_data->gladePath = std::make_unique<GladeSearchpath>();
     initResourcePath(app_data->gladePath.get(), "ui/about.glade");
     initResourcePath(app_data->gladePath.get(), "ui/xournalpp.css", false);
+    app_data->profile.phaseDone("Find resources");
+
+    app_data->control = std::make_unique<Control>(application, app_data->gladePath.get(), app_data->profile);
 
-    app_data->control = std::make_unique<Control>(application, app_data->gladePath.get());
+    if (app_data->saveUncompressed || app_data->saveCompressed) {
+        app_data->control->getSettings()->overrideSaveUncompressed(app_data->saveUncompressed);
+    }
 
     // Set up icons
     {
@@ -473,17 +511,15 @@ void on_startup(GApplication* application, XMPtr app_data) {
             gtk_icon_theme_prepend_search_path(gtk_icon_theme_get_default(), p.c_str());
         }
     }
-
-    auto& globalLatexTemplatePath = app_data->control->getSettings()->latexSettings.globalTemplatePath;
-    if (globalLatexTemplatePath.empty()) {
-        globalLatexTemplatePath = findResourcePath("resources/") / "default_template.tex";
-        g_message("Using default latex template in %s", globalLatexTemplatePath.string().c_str());
-        app_data->control->getSettings()->save();
-    }
+    app_data->profile.phaseDone("Set up icons");
 
     app_data->win = std::make_unique<MainWindow>(app_data->gladePath.get(), app_data->control.get(),
                                                  GTK_APPLICATION(application));
     app_data->control->initWindow(app_data->win.get());
+    app_data->profile.phaseDone("Create main window");
+
+    app_data->firstDrawHandler = g_signal_connect_after(app_data->win->getWindow(), "draw",
+                                                        G_CALLBACK(on_first_draw), app_data);
 
     if (migrateResult.status != MigrateStatus::NotNeeded) {
         Util::execInUiThread(
@@ -530,6 +566,7 @@ void on_startup(GApplication* application, XMPtr app_data) {
     if (!opened) {
         app_data->control->newFile();
     }
+    app_data->profile.phaseDone("Open document");
 
     checkForErrorlog();
     checkForEmergencySave(app_data->control.get());
@@ -603,6 +640,10 @@ auto on_handle_local_options(GApplication*, GVariantDict*, XMPtr app_data) -> gi
 }
 
 void on_shutdown(GApplication*, XMPtr app_data) {
+    if (app_data->firstDrawHandler) {
+        g_signal_handler_disconnect(app_data->win->getWindow(), app_data->firstDrawHandler);
+        app_data->firstDrawHandler = 0;
+    }
     app_data->control->saveSettings();
     app_data->win->getXournal()->clearSelection();
     app_data->control->getScheduler()->stop();
@@ -627,6 +668,14 @@ auto XournalMain::run(int argc, char** argv) -> int {
                                        "<input>", nullptr},
                           GOptionEntry{"version", 0, 0, G_OPTION_ARG_NONE, &app_data.showVersion,
                                        _("Get version of xournalpp"), nullptr},
+                          GOptionEntry{"save-uncompressed", 0, 0, G_OPTION_ARG_NONE, &app_data.saveUncompressed,
+                                       _("Save journals without compression during this session\n"
+                                         "                                 Faster to save and load, but larger files"),
+                                       nullptr},
+                          GOptionEntry{"save-compressed", 0, 0, G_OPTION_ARG_NONE, &app_data.saveCompressed,
+                                       _("Save journals with compression during this session"), nullptr},
+                          GOptionEntry{"startup-profile", 0, 0, G_OPTION_ARG_NONE, &app_data.startupProfile,
+                                       _("Print the duration of each startup phase"), nullptr},
                           GOptionEntry{nullptr}};  // Must be terminated by a nullptr. See gtk doc
     g_application_add_main_option_entries(G_APPLICATION(app), options.data());
 
@@ -1,9 +1,12 @@
 #include "AutosaveJob.h"
 
+#include <memory>  // for unique_ptr
+
 #include <glib.h>  // for g_message, g_warning
 
 #include "control/Control.h"              // for Control
 #include "control/jobs/Job.h"             // for JOB_TYPE_AUTOSAVE, JobType
+#include "control/settings/Settings.h"    // for Settings
 #include "control/xojfile/SaveHandler.h"  // for SaveHandler
 #include "model/Document.h"               // for Document
 #include "undo/UndoRedoHandler.h"         // for UndoRedoHandler
@@ -31,10 +34,13 @@ void AutosaveJob::run() {
     Document* doc = control->getDocument();
 
     doc->lock();
-    handler.prepareSave(doc);
-    auto filepath = doc->getFilepath();
+    std::unique_ptr<Document> snapshot = doc->createSnapshot();
     doc->unlock();
 
+    handler.setCompressed(!control->getSettings()->isSaveUncompressed());
+    handler.prepareSave(snapshot.get());
+    auto filepath = snapshot->getFilepath();
+
     if (filepath.empty()) {
         filepath = Util::getAutosaveFilepath();
     } else {
@@ -101,8 +101,8 @@ auto CustomExportJob::showFilechooser() -> bool {
 /**
  * Create one Graphics file per page
  */
-void CustomExportJob::exportGraphics() {
-    ImageExport imgExport(control->getDocument(), filepath, format, exportBackground, exportRange);
+void CustomExportJob::exportGraphics(Document* doc) {
+    ImageExport imgExport(doc, filepath, format, exportBackground, exportRange);
     if (format == EXPORT_GRAPHICS_PNG) {
         imgExport.setQualityParameter(pngQualityParameter);
     }
@@ -111,15 +111,18 @@ void CustomExportJob::exportGraphics() {
 }
 
 void CustomExportJob::run() {
+    // Export a snapshot, so that the document can be edited during the export
+    Document* doc = control->getDocument();
+    doc->lock();
+    std::unique_ptr<Document> snapshot = doc->createSnapshot();
+    doc->unlock();
+
     if (exportTypeXoj) {
-        SaveJob::updatePreview(control);
-        Document* doc = this->control->getDocument();
+        SaveJob::updatePreview(snapshot.get());
 
         XojExportHandler h;
-        doc->lock();
-        h.prepareSave(doc);
+        h.prepareSave(snapshot.get());
         h.saveTo(filepath, this->control);
-        doc->unlock();
 
         if (!h.getErrorMessage().empty()) {
             this->lastError = FS(_F("Save file error: {1}") % h.getErrorMessage());
@@ -127,11 +130,7 @@ void CustomExportJob::run() {
             callAfterRun();
         }
     } else if (format == EXPORT_GRAPHICS_PDF) {
-        // don't lock the page here for the whole flow, else we get a dead lock...
-        // the ui is blocked, so there should be no changes...
-        Document* doc = control->getDocument();
-
-        std::unique_ptr<XojPdfExport> pdfe = XojPdfExportFactory::createExport(doc, control);
+        std::unique_ptr<XojPdfExport> pdfe = XojPdfExportFactory::createExport(snapshot.get(), control);
 
         pdfe->setExportBackground(exportBackground);
 
@@ -140,7 +139,7 @@ void CustomExportJob::run() {
         }
 
     } else {
-        exportGraphics();
+        exportGraphics(snapshot.get());
     }
 }
 
@@ -21,6 +21,7 @@
 #include "filesystem.h"     // for path
 
 class Control;
+class Document;
 
 
 class CustomExportJob: public BaseExportJob {
@@ -44,7 +45,7 @@ protected:
     /**
      * Create one Graphics file per page
      */
-    void exportGraphics();
+    void exportGraphics(Document* doc);
 
     bool testAndSetFilepath(const fs::path& file) override;
 
@@ -13,7 +13,11 @@
 
 #include <atomic>
 
-enum JobType { JOB_TYPE_BLOCKING, JOB_TYPE_PREVIEW, JOB_TYPE_RENDER, JOB_TYPE_AUTOSAVE };
+/**
+ * JOB_TYPE_RENDER jobs are held back while zooming (see Scheduler::blockRerenderZoom()). JOB_TYPE_PDF_DATA jobs read
+ * data of PDF pages for the tools.
+ */
+enum JobType { JOB_TYPE_BLOCKING, JOB_TYPE_PREVIEW, JOB_TYPE_RENDER, JOB_TYPE_AUTOSAVE, JOB_TYPE_PDF_DATA };
 
 /**
  * A manually ref-counted class representing an asynchronous job to be used with
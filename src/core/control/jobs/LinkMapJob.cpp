@@ -0,0 +1,11 @@
+#include "LinkMapJob.h"
+
+#include <utility>  // for move
+
+LinkMapJob::LinkMapJob(XojPdfPageSPtr page): page(std::move(page)) {}
+
+LinkMapJob::~LinkMapJob() = default;
+
+auto LinkMapJob::getType() -> JobType { return JOB_TYPE_PDF_DATA; }
+
+void LinkMapJob::run() { this->page->getLinkMap(); }
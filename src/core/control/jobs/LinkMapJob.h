@@ -0,0 +1,37 @@
+/*
+ * Xournal++
+ *
+ * A job which extracts the links of a PDF page
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "pdf/base/XojPdfPage.h"  // for XojPdfPageSPtr
+
+#include "Job.h"  // for Job, JobType
+
+/**
+ * @brief Extracts the links of a PDF page in a worker thread, before they are looked up from the UI thread
+ *
+ * The links are cached by the document (see XojPdfPage::getLinkMap()).
+ */
+class LinkMapJob: public Job {
+public:
+    explicit LinkMapJob(XojPdfPageSPtr page);
+
+protected:
+    ~LinkMapJob() override;
+
+public:
+    JobType getType() override;
+
+    void run() override;
+
+private:
+    XojPdfPageSPtr page;
+};
@@ -37,9 +37,11 @@ void PdfExportJob::run() {
     Document* doc = control->getDocument();
 
     doc->lock();
-    std::unique_ptr<XojPdfExport> pdfe = XojPdfExportFactory::createExport(doc, control);
+    std::unique_ptr<Document> snapshot = doc->createSnapshot();
     doc->unlock();
 
+    std::unique_ptr<XojPdfExport> pdfe = XojPdfExportFactory::createExport(snapshot.get(), control);
+
     if (!pdfe->createPdf(this->filepath, false)) {
         this->errorMsg = pdfe->getLastError();
         if (control->getWindow()) {
@@ -1,7 +1,8 @@
 #include "PreviewJob.h"
 
-#include <memory>  // for __s...
-#include <mutex>   // for mutex
+#include <cstdint>  // for uint64_t
+#include <memory>   // for __s...
+#include <mutex>    // for mutex
 #include <vector>  // for vector
 
 #include <glib-object.h>  // for g_o...
@@ -20,6 +21,7 @@
 #include "util/Util.h"                                            // for exe...
 #include "view/DocumentView.h"                                    // for Doc...
 #include "view/LayerView.h"                                       // for Lay...
+#include "view/ThumbnailCache.h"                                 // for Thu...
 #include "view/View.h"                                            // for Con...
 #include "view/background/BackgroundView.h"                       // for BAC...
 
@@ -68,14 +70,20 @@ void PreviewJob::finishPaint() {
 }
 
 void PreviewJob::drawPage() {
-    PageRef page = this->sidebarPreview->page;
     Document* doc = this->sidebarPreview->sidebar->getControl()->getDocument();
     DocumentView view;
     view.setPdfCache(this->sidebarPreview->sidebar->getCache());
     PreviewRenderType type = this->sidebarPreview->getRenderType();
     Layer::Index layer = 0;
 
+    // Draw a snapshot of the page, so that the document is only locked while the page is copied (if it changed).
+    // The thumbnails of unchanged pages are cached: the page is only copied if its thumbnail must be drawn.
     doc->lock();
+    const uint64_t revision = this->sidebarPreview->page->getRevision();
+    const double width = this->sidebarPreview->page->getWidth();
+    const double height = this->sidebarPreview->page->getHeight();
+    PageRef page = type == RENDER_TYPE_PAGE_PREVIEW ? nullptr : doc->getPageSnapshot(this->sidebarPreview->page);
+    doc->unlock();
 
     // getLayer is not defined for page preview
     if (type != RENDER_TYPE_PAGE_PREVIEW) {
@@ -85,10 +93,25 @@ void PreviewJob::drawPage() {
     auto context = xoj::view::Context::createDefault(cr2);
 
     switch (type) {
-        case RENDER_TYPE_PAGE_PREVIEW:
-            // render all layers
-            view.drawPage(page, cr2, true);
+        case RENDER_TYPE_PAGE_PREVIEW: {
+            // render all layers. The previews of unchanged pages are kept by the thumbnail cache, for instance when
+            // the sidebar is recreated.
+            auto thumbnail = xoj::view::ThumbnailCache::getInstance().get(
+                    this->sidebarPreview->page, revision, width, height, width * zoom,
+                    [&](cairo_t* cr) {
+                        doc->lock();
+                        PageRef snapshot = doc->getPageSnapshot(this->sidebarPreview->page);
+                        doc->unlock();
+                        view.drawPage(snapshot, cr, true);
+                    },
+                    true);
+            const double scale = width / cairo_image_surface_get_width(thumbnail.get());
+            cairo_scale(cr2, scale, scale);
+            cairo_set_source_surface(cr2, thumbnail.get(), 0, 0);
+            cairo_pattern_set_filter(cairo_get_source(cr2), CAIRO_FILTER_GOOD);
+            cairo_paint(cr2);
             break;
+        }
 
         case RENDER_TYPE_PAGE_LAYER:
             // render single layer
@@ -121,7 +144,6 @@ void PreviewJob::drawPage() {
     }
 
     cairo_destroy(cr2);
-    doc->unlock();
 }
 
 void PreviewJob::clipToPage() {
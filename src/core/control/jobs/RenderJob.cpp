@@ -1,29 +1,44 @@
 #include "RenderJob.h"
 
-#include <cmath>    // for ceil, floor
-#include <mutex>    // for mutex
-#include <utility>  // for move
-#include <vector>   // for vector
+#include <algorithm>  // for max, min
+#include <cmath>      // for ceil, floor
+#include <mutex>      // for mutex
+#include <thread>     // for thread
+#include <utility>    // for move
+#include <vector>     // for vector
 
 #include <cairo.h>  // for cairo_create, cairo_destroy, cairo_...
 
-#include "control/Control.h"            // for Control
-#include "control/ToolEnums.h"          // for TOOL_PLAY_OBJECT
-#include "control/ToolHandler.h"        // for ToolHandler
-#include "control/jobs/Job.h"           // for JOB_TYPE_RENDER, JobType
-#include "gui/PageView.h"               // for XojPageView
-#include "gui/XournalView.h"            // for XournalView
-#include "gui/widgets/XournalWidget.h"  // for gtk_xournal_repaint_area
-#include "model/Document.h"             // for Document
-#include "model/XojPage.h"              // for Page
-#include "util/Rectangle.h"             // for Rectangle
-#include "util/Util.h"                  // for execInUiThread
-#include "util/raii/CairoWrappers.h"    // for CairoSurfaceSPtr, CairoSPtr
-#include "view/DocumentView.h"          // for DocumentView
-#include "view/Mask.h"                  // for Mask
+#include "control/Control.h"                  // for Control
+#include "control/ToolEnums.h"                // for TOOL_PLAY_OBJECT
+#include "control/ToolHandler.h"              // for ToolHandler
+#include "control/jobs/Job.h"                 // for JOB_TYPE_RENDER, JobType
+#include "gui/PageView.h"                     // for XojPageView
+#include "gui/XournalView.h"                  // for XournalView
+#include "gui/widgets/XournalWidget.h"        // for gtk_xournal_repaint_area
+#include "model/Document.h"                   // for Document
+#include "model/XojPage.h"                    // for Page
+#include "util/Rectangle.h"                   // for Rectangle
+#include "util/Util.h"                        // for execInUiThread
+#include "util/raii/CairoWrappers.h"          // for CairoSurfaceSPtr, CairoSPtr
+#include "view/DocumentView.h"                // for DocumentView
+#include "view/Mask.h"                        // for Mask
+#include "view/background/BackgroundCache.h"  // for BackgroundCache
 
 using xoj::util::Rectangle;
 
+namespace {
+/**
+ * Buffers with fewer pixels are rendered in a single pass (roughly an A4 page at 400% zoom)
+ */
+constexpr double MIN_PIXELS_FOR_BAND_RENDERING = 8'000'000;
+
+/**
+ * Minimal height of a band, in pixels
+ */
+constexpr int MIN_BAND_HEIGHT = 512;
+}  // namespace
+
 RenderJob::RenderJob(XojPageView* view): view(view) {}
 
 auto RenderJob::getSource() -> void* { return this->view; }
@@ -65,7 +80,7 @@ void RenderJob::run() {
                                 Range(0, 0, view->page->getWidth(), view->page->getHeight()), view->xournal->getZoom(),
                                 CAIRO_CONTENT_COLOR_ALPHA);
 
-        renderToBuffer(newMask.get());
+        renderPageToBuffer(newMask);
         {
             std::lock_guard lock(this->view->drawingMutex);
             std::swap(this->view->buffer, newMask);
@@ -94,14 +109,128 @@ void RenderJob::repaintPageArea(double x1, double y1, double x2, double y2) cons
     repaintWidgetArea(view->xournal->getWidget(), x + std::floor(zoom * x1), y + std::floor(zoom * y1), x + std::ceil(zoom * x2), y + std::ceil(zoom * y2));
 }
 
-void RenderJob::renderToBuffer(cairo_t* cr) const {
-    DocumentView localView;
+void RenderJob::initDocumentView(DocumentView& localView) const {
     localView.setMarkAudioStroke(this->view->getXournal()->getControl()->getToolHandler()->getToolType() ==
                                  TOOL_PLAY_OBJECT);
+    localView.setAudioReplay(this->view->getXournal()->getAudioReplay());
     localView.setPdfCache(this->view->xournal->getCache());
+    localView.setImageLoading(xoj::view::LOAD_IMAGES_IN_BACKGROUND);
+}
+
+auto RenderJob::updateBackground() const -> std::shared_ptr<const xoj::view::Mask> {
+    xoj::view::BackgroundCache::Entry background;
+    {
+        std::lock_guard lock(this->view->drawingMutex);
+        background = this->view->background;
+    }
+
+    this->view->xournal->getBackgroundCache()->update(background, this->view->page, this->view->xournal->getZoom(),
+                                                      this->view->xournal->getDpiScaleFactor(),
+                                                      this->view->xournal->getCache());
+
+    std::lock_guard lock(this->view->drawingMutex);
+    this->view->background = background;
+    return background.buffer;
+}
+
+void RenderJob::renderToBuffer(cairo_t* cr) const {
+    DocumentView localView;
+    initDocumentView(localView);
+
+    std::lock_guard<Document> lock(*this->view->xournal->getDocument());
+    updateBackground()->paintTo(cr);
+    localView.drawPageLayers(this->view->page, cr, false);
+}
+
+void RenderJob::renderPageToBuffer(xoj::view::Mask& buffer) const {
+    cairo_surface_t* target = cairo_get_target(buffer.get());
+    const int pixelWidth = cairo_image_surface_get_width(target);
+    const int pixelHeight = cairo_image_surface_get_height(target);
+
+    const int maxBandCount = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    const int bandCount = std::min(maxBandCount, pixelHeight / MIN_BAND_HEIGHT);
+
+    if (bandCount < 2 || static_cast<double>(pixelWidth) * pixelHeight < MIN_PIXELS_FOR_BAND_RENDERING) {
+        renderToBuffer(buffer.get());
+        return;
+    }
 
     std::lock_guard<Document> lock(*this->view->xournal->getDocument());
-    localView.drawPage(this->view->page, cr, false);
+    updateBackground()->paintTo(buffer.get());
+    if (DocumentView::prepareConcurrentDrawing(this->view->page)) {
+        renderBandsToBuffer(buffer, bandCount);
+    } else {
+        DocumentView localView;
+        initDocumentView(localView);
+        localView.drawPageLayers(this->view->page, buffer.get(), false);
+    }
+}
+
+void RenderJob::renderBandsToBuffer(xoj::view::Mask& buffer, int bandCount) const {
+    cairo_t* targetCr = buffer.get();
+    cairo_surface_t* target = cairo_get_target(targetCr);
+
+    double scaleX = 1.0;
+    double scaleY = 1.0;
+    cairo_surface_get_device_scale(target, &scaleX, &scaleY);
+
+    // Size of the buffer in device space (before DPI scaling).
+    // The bands are cut along whole pixels of the device space, so they do not overlap.
+    const int width = static_cast<int>(cairo_image_surface_get_width(target) / scaleX);
+    const int height = static_cast<int>(cairo_image_surface_get_height(target) / scaleY);
+
+    // Transformation from page coordinates to the buffer's device space
+    cairo_matrix_t pageToBuffer;
+    cairo_get_matrix(targetCr, &pageToBuffer);
+
+    DocumentView prototypeView;
+    initDocumentView(prototypeView);
+
+    struct Band {
+        int y;
+        int height;
+        xoj::util::CairoSurfaceSPtr surface;
+    };
+    std::vector<Band> bands(static_cast<size_t>(bandCount));
+
+    std::vector<std::thread> workers;
+    workers.reserve(bands.size() - 1);
+    for (int i = 0; i < bandCount; i++) {
+        Band& band = bands[static_cast<size_t>(i)];
+        band.y = height * i / bandCount;
+        band.height = height * (i + 1) / bandCount - band.y;
+        band.surface.reset(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, static_cast<int>(width * scaleX),
+                                                      static_cast<int>(band.height * scaleY)),
+                           xoj::util::adopt);
+        cairo_surface_set_device_scale(band.surface.get(), scaleX, scaleY);
+
+        auto renderBand = [&band, localView = prototypeView, pageToBuffer, page = this->view->page]() mutable {
+            xoj::util::CairoSPtr cr(cairo_create(band.surface.get()), xoj::util::adopt);
+            cairo_translate(cr.get(), 0, -band.y);
+            cairo_transform(cr.get(), &pageToBuffer);
+            // The band's clip extents only cover the band, so LayerView skips the elements outside of it
+            localView.drawPageLayers(page, cr.get(), false);
+        };
+
+        if (i + 1 < bandCount) {
+            workers.emplace_back(std::move(renderBand));
+        } else {
+            // The last band is rendered by the job's thread
+            renderBand();
+        }
+    }
+    for (auto& worker: workers) {
+        worker.join();
+    }
+
+    // The bands only contain the layers: paint them over the background
+    xoj::util::CairoSaveGuard saveGuard(targetCr);
+    cairo_identity_matrix(targetCr);
+    for (const Band& band: bands) {
+        cairo_set_source_surface(targetCr, band.surface.get(), 0, band.y);
+        cairo_rectangle(targetCr, 0, band.y, width, band.height);
+        cairo_fill(targetCr);
+    }
 }
 
 auto RenderJob::getType() -> JobType { return JOB_TYPE_RENDER; }
@@ -11,12 +11,18 @@
 
 #pragma once
 
+#include <memory>  // for shared_ptr
+
 #include <cairo.h>    // for cairo_surface_t
 #include <gtk/gtk.h>  // for GtkWidget
 
 #include "Job.h"  // for Job, JobType
 
 class XojPageView;
+class DocumentView;
+namespace xoj::view {
+class Mask;
+}  // namespace xoj::view
 namespace xoj::util {
 template <class T>
 class Rectangle;
@@ -45,6 +51,27 @@ private:
 
     void renderToBuffer(cairo_t* cr) const;
 
+    /**
+     * @brief Render the whole page to the buffer.
+     * If the buffer is large, the page is split in horizontal bands, rendered concurrently into separate surfaces and
+     * then composited into the buffer.
+     */
+    void renderPageToBuffer(xoj::view::Mask& buffer) const;
+
+    /**
+     * @brief Render the page in bandCount horizontal bands, each on its own thread, and composite them into the buffer.
+     * The document must be locked and prepared with DocumentView::prepareConcurrentDrawing().
+     */
+    void renderBandsToBuffer(xoj::view::Mask& buffer, int bandCount) const;
+
+    void initDocumentView(DocumentView& localView) const;
+
+    /**
+     * @brief Get the page's rasterized background for the current zoom, rendering it only if it changed.
+     * The document must be locked.
+     */
+    std::shared_ptr<const xoj::view::Mask> updateBackground() const;
+
 private:
     XojPageView* view;
 };
@@ -1,13 +1,14 @@
 #include "SaveJob.h"
 
 #include <cmath>   // for ceil
-#include <memory>  // for __shared_ptr_access
+#include <memory>  // for unique_ptr, __shared_ptr_access
 
 #include <cairo.h>  // for cairo_create, cairo_destroy
 #include <glib.h>   // for g_warning, g_error
 
 #include "control/Control.h"              // for Control
 #include "control/jobs/BlockingJob.h"     // for BlockingJob
+#include "control/settings/Settings.h"    // for Settings
 #include "control/xojfile/SaveHandler.h"  // for SaveHandler
 #include "model/Document.h"               // for Document
 #include "model/PageRef.h"                // for PageRef
@@ -42,13 +43,9 @@ void SaveJob::afterRun() {
     }
 }
 
-void SaveJob::updatePreview(Control* control) {
+void SaveJob::updatePreview(Document* doc) {
     const int previewSize = 128;
 
-    Document* doc = control->getDocument();
-
-    doc->lock();
-
     if (doc->getPageCount() > 0) {
         PageRef page = doc->getPage(0);
 
@@ -89,20 +86,23 @@ void SaveJob::updatePreview(Control* control) {
     } else {
         doc->setPreview(nullptr);
     }
-
-    doc->unlock();
 }
 
 auto SaveJob::save() -> bool {
-    updatePreview(control);
     Document* doc = this->control->getDocument();
-    SaveHandler h;
 
+    // Work on a snapshot, so that the document can be edited while it is saved
     doc->lock();
-    h.prepareSave(doc);
-    fs::path filepath = doc->getFilepath();
+    std::unique_ptr<Document> snapshot = doc->createSnapshot();
     doc->unlock();
 
+    updatePreview(snapshot.get());
+
+    SaveHandler h;
+    h.setCompressed(!control->getSettings()->isSaveUncompressed());
+    h.prepareSave(snapshot.get());
+    fs::path filepath = snapshot->getFilepath();
+
     Util::clearExtensions(filepath, ".pdf");
     auto const target = fs::path{filepath}.concat(".xopp");
     auto const createBackup = doc->shouldCreateBackupOnSave();
@@ -122,8 +122,9 @@ auto SaveJob::save() -> bool {
         }
     }
 
-    doc->lock();
     h.saveTo(target, this->control);
+
+    doc->lock();
     doc->setFilepath(target);
     doc->unlock();
 
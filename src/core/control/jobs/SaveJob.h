@@ -16,6 +16,7 @@
 #include "BlockingJob.h"  // for BlockingJob
 
 class Control;
+class Document;
 
 
 class SaveJob: public BlockingJob {
@@ -30,7 +31,11 @@ public:
 
     bool save();
 
-    static void updatePreview(Control* control);
+    /**
+     * @brief Render the preview of the first page and store it in the document.
+     * The document is not locked: use a snapshot (see Document::createSnapshot()).
+     */
+    static void updatePreview(Document* doc);
 
 protected:
     void afterRun() override;
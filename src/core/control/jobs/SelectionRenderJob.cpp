@@ -0,0 +1,41 @@
+#include "SelectionRenderJob.h"
+
+#include <mutex>    // for lock_guard
+#include <utility>  // for move
+
+SelectionRenderJob::SelectionRenderJob(EditSelectionContents* contents, std::weak_ptr<SelectionRenderTarget> target,
+                                       const SelectionBufferParameters& params):
+        source(contents), target(std::move(target)), params(params) {}
+
+SelectionRenderJob::~SelectionRenderJob() {
+    if (this->buffer) {
+        cairo_surface_destroy(this->buffer);
+        this->buffer = nullptr;
+    }
+}
+
+auto SelectionRenderJob::getType() -> JobType { return JOB_TYPE_RENDER; }
+
+auto SelectionRenderJob::getSource() -> void* { return this->source; }
+
+void SelectionRenderJob::run() {
+    if (auto target = this->target.lock()) {
+        std::lock_guard lock(target->mutex);
+        if (target->contents == nullptr) {
+            // The selection was deleted
+            return;
+        }
+        this->buffer = EditSelectionContents::renderBuffer(*target->contents, this->params);
+    }
+    if (this->buffer) {
+        callAfterRun();
+    }
+}
+
+void SelectionRenderJob::afterRun() {
+    auto target = this->target.lock();
+    if (target && target->contents) {
+        target->contents->setRenderedBuffer(this->buffer, this->params);
+        this->buffer = nullptr;
+    }
+}
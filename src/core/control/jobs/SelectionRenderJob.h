@@ -0,0 +1,58 @@
+/*
+ * Xournal++
+ *
+ * A job which rasterizes the elements of a selection at a new size
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <memory>  // for weak_ptr
+
+#include <cairo.h>  // for cairo_surface_t
+
+#include "control/tools/EditSelectionContents.h"  // for EditSelectionContents, SelectionRenderTarget
+
+#include "Job.h"  // for Job, JobType
+
+/**
+ * @brief Renders the selected elements in a worker thread, while the selection shows its scaled buffer
+ *
+ * The elements are read while holding the mutex of the selection's render target: the selection waits for the
+ * rasterization if it is modified meanwhile. The result is handed to the selection in the UI thread, unless the
+ * selection was deleted in the meantime.
+ */
+class SelectionRenderJob: public Job {
+public:
+    SelectionRenderJob(EditSelectionContents* contents, std::weak_ptr<SelectionRenderTarget> target,
+                       const SelectionBufferParameters& params);
+
+protected:
+    ~SelectionRenderJob() override;
+
+public:
+    JobType getType() override;
+
+    void* getSource() override;
+
+    void run() override;
+
+protected:
+    void afterRun() override;
+
+private:
+    /**
+     * Only used to identify the job in the scheduler: never dereferenced
+     */
+    EditSelectionContents* source;
+
+    std::weak_ptr<SelectionRenderTarget> target;
+
+    SelectionBufferParameters params;
+
+    cairo_surface_t* buffer = nullptr;
+};
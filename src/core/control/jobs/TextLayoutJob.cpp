@@ -0,0 +1,23 @@
+#include "TextLayoutJob.h"
+
+#include <utility>  // for move
+
+#include "control/tools/PdfElemSelection.h"  // for PdfElemSelection
+
+TextLayoutJob::TextLayoutJob(XojPdfPageSPtr page, std::weak_ptr<PdfElemSelection*> target):
+        page(std::move(page)), target(std::move(target)) {}
+
+TextLayoutJob::~TextLayoutJob() = default;
+
+auto TextLayoutJob::getType() -> JobType { return JOB_TYPE_PDF_DATA; }
+
+void TextLayoutJob::run() {
+    this->page->getTextLayout();
+    callAfterRun();
+}
+
+void TextLayoutJob::afterRun() {
+    if (auto selection = this->target.lock()) {
+        (*selection)->textLayoutReady();
+    }
+}
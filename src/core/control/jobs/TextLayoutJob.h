@@ -0,0 +1,47 @@
+/*
+ * Xournal++
+ *
+ * A job which extracts the text layout of a PDF page
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <memory>  // for weak_ptr
+
+#include "pdf/base/XojPdfPage.h"  // for XojPdfPageSPtr
+
+#include "Job.h"  // for Job, JobType
+
+class PdfElemSelection;
+
+/**
+ * @brief Extracts the text layout of a PDF page in a worker thread, for a text selection on this page
+ *
+ * The layout is cached by the document (see XojPdfPage::getTextLayout()). The selection is notified in the UI thread,
+ * unless it was deleted in the meantime.
+ */
+class TextLayoutJob: public Job {
+public:
+    TextLayoutJob(XojPdfPageSPtr page, std::weak_ptr<PdfElemSelection*> target);
+
+protected:
+    ~TextLayoutJob() override;
+
+public:
+    JobType getType() override;
+
+    void run() override;
+
+protected:
+    void afterRun() override;
+
+private:
+    XojPdfPageSPtr page;
+
+    std::weak_ptr<PdfElemSelection*> target;
+};
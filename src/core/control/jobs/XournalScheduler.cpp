@@ -1,14 +1,18 @@
 #include "XournalScheduler.h"
 
-#include <array>   // for array
-#include <deque>   // for _Deque_iterator, deque, operator!=
-#include <mutex>   // for lock_guard
-#include <string>  // for string
+#include <array>    // for array
+#include <deque>    // for _Deque_iterator, deque, operator!=
+#include <mutex>    // for lock_guard
+#include <string>   // for string
+#include <utility>  // for move
 
 #include "control/jobs/Scheduler.h"  // for JOB_PRIORITY_URGENT, JOB_PRIORIT...
 
-#include "PreviewJob.h"  // for PreviewJob
-#include "RenderJob.h"   // for RenderJob
+#include "LinkMapJob.h"          // for LinkMapJob
+#include "PreviewJob.h"          // for PreviewJob
+#include "RenderJob.h"           // for RenderJob
+#include "SelectionRenderJob.h"  // for SelectionRenderJob
+#include "TextLayoutJob.h"       // for TextLayoutJob
 
 class SidebarPreviewBaseEntry;
 class XojPageView;
@@ -117,3 +121,29 @@ void XournalScheduler::addRerenderPage(XojPageView* view) {
     addJob(job, JOB_PRIORITY_URGENT);
     job->unref();
 }
+
+void XournalScheduler::addTextLayout(XojPdfPageSPtr page, std::weak_ptr<PdfElemSelection*> target) {
+    auto* job = new TextLayoutJob(std::move(page), std::move(target));
+    addJob(job, JOB_PRIORITY_URGENT);
+    job->unref();
+}
+
+void XournalScheduler::addLinkMap(XojPdfPageSPtr page) {
+    auto* job = new LinkMapJob(std::move(page));
+    addJob(job, JOB_PRIORITY_URGENT);
+    job->unref();
+}
+
+void XournalScheduler::cancelRerenderPage(XojPageView* view) {
+    removeSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_URGENT, false);
+}
+
+void XournalScheduler::addRerenderSelection(EditSelectionContents* contents,
+                                            std::weak_ptr<SelectionRenderTarget> target,
+                                            const SelectionBufferParameters& params) {
+    removeSource(contents, JOB_TYPE_RENDER, JOB_PRIORITY_URGENT, false);
+
+    auto* job = new SelectionRenderJob(contents, std::move(target), params);
+    addJob(job, JOB_PRIORITY_URGENT);
+    job->unref();
+}
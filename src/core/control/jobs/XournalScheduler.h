@@ -13,12 +13,19 @@
 
 #pragma once
 
+#include <memory>  // for weak_ptr
+
 #include "control/jobs/Job.h"  // for JobType
+#include "pdf/base/XojPdfPage.h"  // for XojPdfPageSPtr
 
 #include "Scheduler.h"  // for JobPriority, Scheduler
 
+class EditSelectionContents;
+class PdfElemSelection;
 class SidebarPreviewBaseEntry;
 class XojPageView;
+struct SelectionBufferParameters;
+struct SelectionRenderTarget;
 
 class XournalScheduler: public Scheduler {
 public:
@@ -41,6 +48,29 @@ public:
     void addRepaintSidebar(SidebarPreviewBaseEntry* preview);
     void addRerenderPage(XojPageView* view);
 
+    /**
+     * Removes the queued RenderJob of the page, if any. Does not wait for a running one.
+     */
+    void cancelRerenderPage(XojPageView* view);
+
+    /**
+     * Rasterizes the selection in the background, replacing its queued SelectionRenderJob if any. A running one is
+     * not waited for: its result is discarded by the selection.
+     */
+    void addRerenderSelection(EditSelectionContents* contents, std::weak_ptr<SelectionRenderTarget> target,
+                              const SelectionBufferParameters& params);
+
+    /**
+     * Extracts the text layout of the PDF page in the background for the text selection. If another job extracts it
+     * first, this one only notifies the selection.
+     */
+    void addTextLayout(XojPdfPageSPtr page, std::weak_ptr<PdfElemSelection*> target);
+
+    /**
+     * Extracts the links of the PDF page in the background, so that looking them up later does not block the UI
+     */
+    void addLinkMap(XojPdfPageSPtr page);
+
     /**
      * Blocks until all currently running Job%s have been executed
      */
@@ -117,6 +117,7 @@ void Settings::loadDefault() {
     // Set this for autosave frequency in minutes.
     this->autosaveTimeout = 3;
     this->autosaveEnabled = true;
+    this->saveUncompressed = false;
 
     this->addHorizontalSpace = false;
     this->addHorizontalSpaceAmount = 150;
@@ -469,6 +470,8 @@ void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur) {
         this->audioFolder = fs::u8path(reinterpret_cast<const char*>(value));
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("autosaveEnabled")) == 0) {
         this->autosaveEnabled = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
+    } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("saveUncompressed")) == 0) {
+        this->saveUncompressed = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("autosaveTimeout")) == 0) {
         this->autosaveTimeout = g_ascii_strtoll(reinterpret_cast<const char*>(value), nullptr, 10);
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("defaultViewModeAttributes")) == 0) {
@@ -983,6 +986,8 @@ void Settings::save() {
     SAVE_BOOL_PROP(autosaveEnabled);
     SAVE_INT_PROP(autosaveTimeout);
 
+    SAVE_BOOL_PROP(saveUncompressed);
+
     SAVE_BOOL_PROP(addHorizontalSpace);
     SAVE_INT_PROP(addHorizontalSpaceAmount);
     SAVE_BOOL_PROP(addVerticalSpace);
@@ -1248,6 +1253,23 @@ void Settings::setAutosaveEnabled(bool autosave) {
     save();
 }
 
+auto Settings::isSaveUncompressed() const -> bool {
+    return this->saveUncompressedOverride.value_or(this->saveUncompressed);
+}
+
+void Settings::setSaveUncompressed(bool uncompressed) {
+    this->saveUncompressedOverride.reset();
+    if (this->saveUncompressed == uncompressed) {
+        return;
+    }
+
+    this->saveUncompressed = uncompressed;
+
+    save();
+}
+
+void Settings::overrideSaveUncompressed(bool uncompressed) { this->saveUncompressedOverride = uncompressed; }
+
 auto Settings::getAddVerticalSpace() const -> bool { return this->addVerticalSpace; }
 
 void Settings::setAddVerticalSpace(bool space) { this->addVerticalSpace = space; }
@@ -11,13 +11,14 @@
 
 #pragma once
 
-#include <cstddef>  // for size_t
-#include <map>      // for map
-#include <memory>   // for make_shared, shared_ptr
-#include <string>   // for string, basic_string
-#include <utility>  // for pair
-#include <vector>   // for vector
-#include <array>    // for array
+#include <cstddef>   // for size_t
+#include <map>       // for map
+#include <memory>    // for make_shared, shared_ptr
+#include <optional>  // for optional
+#include <string>    // for string, basic_string
+#include <utility>   // for pair
+#include <vector>    // for vector
+#include <array>     // for array
 
 #include <gdk/gdk.h>                      // for GdkInputSource, GdkD...
 #include <glib.h>                         // for gchar, gboolean, gint
@@ -275,6 +276,14 @@ public:
     bool isAutosaveEnabled() const;
     void setAutosaveEnabled(bool autosave);
 
+    bool isSaveUncompressed() const;
+    void setSaveUncompressed(bool uncompressed);
+
+    /**
+     * Use (or not) uncompressed saving for this session only, without changing the setting (command line option)
+     */
+    void overrideSaveUncompressed(bool uncompressed);
+
     bool getAddVerticalSpace() const;
     void setAddVerticalSpace(bool space);
     int getAddVerticalSpaceAmount() const;
@@ -840,6 +849,16 @@ private:
      */
     bool autosaveEnabled{};
 
+    /**
+     * Save .xopp files as plain XML, without gzip compression: faster to save and load, but larger
+     */
+    bool saveUncompressed{};
+
+    /**
+     * Value of saveUncompressed given on the command line, not stored
+     */
+    std::optional<bool> saveUncompressedOverride;
+
     /**
      * Allow scroll outside the page display area (horizontal)
      */
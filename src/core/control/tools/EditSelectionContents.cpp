@@ -5,10 +5,12 @@
 #include <iterator>   // for back_insert_iterator
 #include <limits>     // for numeric_limits
 #include <memory>     // for make_unique, __shar...
+#include <mutex>      // for lock_guard
 
-#include <glib.h>  // for g_idle_add, g_sourc...
+#include <glib.h>  // for g_timeout_add, g_sou...
 
 #include "control/Control.h"                      // for Control
+#include "control/jobs/XournalScheduler.h"        // for XournalScheduler
 #include "control/settings/Settings.h"            // for Settings
 #include "control/tools/CursorSelectionType.h"    // for CURSOR_SELECTION_TO...
 #include "gui/PageView.h"                         // for XojPageView
@@ -55,6 +57,12 @@ EditSelectionContents::EditSelectionContents(Rectangle<double> bounds, Rectangle
 }
 
 EditSelectionContents::~EditSelectionContents() {
+    {
+        // Pending rasterizations are dropped
+        std::lock_guard lock(this->renderTarget->mutex);
+        this->renderTarget->contents = nullptr;
+    }
+
     if (this->rescaleId) {
         g_source_remove(this->rescaleId);
         this->rescaleId = 0;
@@ -67,6 +75,7 @@ EditSelectionContents::~EditSelectionContents() {
  * Add an element to the this selection
  */
 void EditSelectionContents::addElement(Element* e, Element::Index order) {
+    std::lock_guard lock(this->renderTarget->mutex);
     g_assert(this->selected.size() == this->insertOrder.size());
     this->selected.emplace_back(e);
     auto item = std::make_pair(e, order);
@@ -75,6 +84,7 @@ void EditSelectionContents::addElement(Element* e, Element::Index order) {
 }
 
 void EditSelectionContents::replaceInsertOrder(std::deque<std::pair<Element*, Element::Index>> newInsertOrder) {
+    std::lock_guard lock(this->renderTarget->mutex);
     this->selected.clear();
     this->selected.reserve(newInsertOrder.size());
     std::transform(begin(newInsertOrder), end(newInsertOrder), std::back_inserter(this->selected),
@@ -100,6 +110,7 @@ auto EditSelectionContents::getInsertOrder() const -> std::deque<std::pair<Eleme
  */
 auto EditSelectionContents::setSize(ToolSize size, const double* thicknessPen, const double* thicknessHighlighter,
                                     const double* thicknessEraser) -> UndoActionPtr {
+    std::lock_guard lock(this->renderTarget->mutex);
     auto undo = std::make_unique<SizeUndoAction>(this->sourcePage, this->sourceLayer);
 
     bool found = false;
@@ -149,6 +160,7 @@ auto EditSelectionContents::setSize(ToolSize size, const double* thicknessPen, c
  * (Or nullptr if nothing done, e.g. because there is only an image)
  */
 auto EditSelectionContents::setFill(int alphaPen, int alphaHighligther) -> UndoActionPtr {
+    std::lock_guard lock(this->renderTarget->mutex);
     auto undo = std::make_unique<FillUndoAction>(this->sourcePage, this->sourceLayer);
 
     bool found = false;
@@ -194,6 +206,7 @@ auto EditSelectionContents::setFill(int alphaPen, int alphaHighligther) -> UndoA
  * (or nullptr if there are no Text elements)
  */
 auto EditSelectionContents::setFont(XojFont& font) -> UndoActionPtr {
+    std::lock_guard lock(this->renderTarget->mutex);
     double x1 = std::numeric_limits<double>::quiet_NaN();
     double x2 = std::numeric_limits<double>::quiet_NaN();
     double y1 = std::numeric_limits<double>::quiet_NaN();
@@ -245,6 +258,7 @@ auto EditSelectionContents::setFont(XojFont& font) -> UndoActionPtr {
  * (Or nullptr if nothing done)
  */
 auto EditSelectionContents::setLineStyle(LineStyle style) -> UndoActionPtr {
+    std::lock_guard lock(this->renderTarget->mutex);
     auto undo = std::make_unique<LineStyleUndoAction>(this->sourcePage, this->sourceLayer);
 
     bool found = false;
@@ -275,6 +289,7 @@ auto EditSelectionContents::setLineStyle(LineStyle style) -> UndoActionPtr {
  * (Or nullptr if nothing done, e.g. because there is only an image)
  */
 auto EditSelectionContents::setColor(Color color) -> UndoActionPtr {
+    std::lock_guard lock(this->renderTarget->mutex);
     auto undo = std::make_unique<ColorUndoAction>(this->sourcePage, this->sourceLayer);
 
     bool found = false;
@@ -304,6 +319,7 @@ auto EditSelectionContents::setColor(Color color) -> UndoActionPtr {
  * the selection is cleared after
  */
 void EditSelectionContents::fillUndoItem(DeleteUndoAction* undo) {
+    std::lock_guard lock(this->renderTarget->mutex);
     Layer* layer = this->sourceLayer;
 
     // Always insert the elements on top
@@ -319,18 +335,53 @@ void EditSelectionContents::fillUndoItem(DeleteUndoAction* undo) {
     this->insertOrder.clear();
 }
 
+auto SelectionBufferParameters::sameSize(const SelectionBufferParameters& other) const -> bool {
+    return width == other.width && height == other.height && zoom == other.zoom;
+}
+
+void EditSelectionContents::scheduleRerender(const BufferParameters& params) {
+    if (this->requestedParameters && this->requestedParameters->sameSize(params)) {
+        // Already waiting for this size, or being rendered
+        return;
+    }
+    this->requestedParameters = params;
+
+    // The user keeps transforming the selection: wait until it settles
+    if (this->rescaleId) {
+        g_source_remove(this->rescaleId);
+    }
+    this->rescaleId = g_timeout_add(RERENDER_DELAY, reinterpret_cast<GSourceFunc>(startRerender), this);
+}
+
 /**
  * Callback to redrawing the buffer asynchron
  */
-auto EditSelectionContents::repaintSelection(EditSelectionContents* selection) -> bool {
-    // delete the selection buffer, force a redraw
-    selection->deleteViewBuffer();
-    selection->sourceView->getXournal()->repaintSelection();
+auto EditSelectionContents::startRerender(EditSelectionContents* selection) -> bool {
     selection->rescaleId = 0;
+    if (selection->requestedParameters) {
+        auto* scheduler = selection->sourceView->getXournal()->getControl()->getScheduler();
+        scheduler->addRerenderSelection(selection, selection->renderTarget, *selection->requestedParameters);
+    }
 
     return false;
 }
 
+void EditSelectionContents::setRenderedBuffer(cairo_surface_t* buffer, const BufferParameters& params) {
+    if (!this->requestedParameters || !this->requestedParameters->sameSize(params) ||
+        params.generation != this->bufferGeneration) {
+        // The selection was transformed or modified since the rasterization started
+        cairo_surface_destroy(buffer);
+        return;
+    }
+    this->requestedParameters.reset();
+
+    if (this->crBuffer) {
+        cairo_surface_destroy(this->crBuffer);
+    }
+    this->crBuffer = buffer;
+    this->sourceView->getXournal()->repaintSelection();
+}
+
 /**
  * Delete our internal View buffer,
  * it will be recreated when the selection is painted next time
@@ -340,6 +391,14 @@ void EditSelectionContents::deleteViewBuffer() {
         cairo_surface_destroy(this->crBuffer);
         this->crBuffer = nullptr;
     }
+
+    // The next paint rasterizes the current elements: drop the pending rasterizations of the previous ones
+    this->bufferGeneration++;
+    this->requestedParameters.reset();
+    if (this->rescaleId) {
+        g_source_remove(this->rescaleId);
+        this->rescaleId = 0;
+    }
 }
 
 /**
@@ -348,6 +407,7 @@ void EditSelectionContents::deleteViewBuffer() {
 void EditSelectionContents::finalizeSelection(Rectangle<double> bounds, Rectangle<double> snappedBounds,
                                               bool aspectRatio, Layer* layer, const PageRef& targetPage,
                                               XojPageView* targetView, UndoRedoHandler* undo) {
+    std::lock_guard lock(this->renderTarget->mutex);
     double fx = bounds.width / this->originalBounds.width;
     double fy = bounds.height / this->originalBounds.height;
 
@@ -494,23 +554,11 @@ void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotati
         this->rotation = rotation;
     }
 
-    if (this->crBuffer == nullptr) {
-        this->crBuffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, static_cast<int>(std::abs(width) * zoom),
-                                                    static_cast<int>(std::abs(height) * zoom));
-        cairo_t* cr2 = cairo_create(this->crBuffer);
-
-        int dx = static_cast<int>(this->relativeX * zoom);
-        int dy = static_cast<int>(this->relativeY * zoom);
-
-        cairo_translate(cr2, fx < 0 ? -width * zoom : 0, fy < 0 ? -height * zoom : 0);
-        cairo_scale(cr2, fx, fy);
-        cairo_translate(cr2, -dx, -dy);
-        cairo_scale(cr2, zoom, zoom);
+    const BufferParameters params = {width, height, fx, fy, zoom, this->relativeX, this->relativeY,
+                                     this->bufferGeneration};
 
-        xoj::view::ElementContainerView view(this);
-        view.draw(xoj::view::Context::createDefault(cr2));
-
-        cairo_destroy(cr2);
+    if (this->crBuffer == nullptr) {
+        this->crBuffer = renderBuffer(*this, params);
     }
 
     cairo_save(cr);
@@ -524,10 +572,10 @@ void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotati
     double sx = static_cast<double>(wTarget) / wImg;
     double sy = static_cast<double>(hTarget) / hImg;
 
-    if (wTarget != wImg || hTarget != hImg || std::abs(rotation) > std::numeric_limits<double>::epsilon()) {
-        if (!this->rescaleId) {
-            this->rescaleId = g_idle_add(reinterpret_cast<GSourceFunc>(repaintSelection), this);
-        }
+    if (wTarget != wImg || hTarget != hImg) {
+        // Scale the current buffer for now, it is rasterized again at the new size in the background.
+        // The rotation is applied to cr by the caller, and needs no new rasterization.
+        scheduleRerender(params);
         cairo_scale(cr, sx, sy);
     }
 
@@ -540,6 +588,29 @@ void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotati
     cairo_restore(cr);
 }
 
+auto EditSelectionContents::renderBuffer(const ElementContainer& elements, const BufferParameters& params)
+        -> cairo_surface_t* {
+    const double zoom = params.zoom;
+    cairo_surface_t* buffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                         static_cast<int>(std::abs(params.width) * zoom),
+                                                         static_cast<int>(std::abs(params.height) * zoom));
+    cairo_t* cr2 = cairo_create(buffer);
+
+    int dx = static_cast<int>(params.relativeX * zoom);
+    int dy = static_cast<int>(params.relativeY * zoom);
+
+    cairo_translate(cr2, params.fx < 0 ? -params.width * zoom : 0, params.fy < 0 ? -params.height * zoom : 0);
+    cairo_scale(cr2, params.fx, params.fy);
+    cairo_translate(cr2, -dx, -dy);
+    cairo_scale(cr2, zoom, zoom);
+
+    xoj::view::ElementContainerView view(&elements);
+    view.draw(xoj::view::Context::createDefault(cr2));
+
+    cairo_destroy(cr2);
+    return buffer;
+}
+
 void EditSelectionContents::serialize(ObjectOutputStream& out) const {
     out.writeObject("EditSelectionContents");
 
@@ -11,9 +11,12 @@
 
 #pragma once
 
-#include <deque>    // for deque
-#include <utility>  // for pair
-#include <vector>   // for vector
+#include <deque>     // for deque
+#include <memory>    // for shared_ptr
+#include <mutex>     // for mutex
+#include <optional>  // for optional
+#include <utility>   // for pair
+#include <vector>    // for vector
 
 #include <cairo.h>  // for cairo_surface_t, cairo_t
 
@@ -36,6 +39,40 @@ class LineStyle;
 class ObjectInputStream;
 class ObjectOutputStream;
 class XojFont;
+class EditSelectionContents;
+
+/**
+ * Size and position of a rasterization of a selection
+ */
+struct SelectionBufferParameters {
+    double width;
+    double height;
+    double fx;
+    double fy;
+    double zoom;
+    double relativeX;
+    double relativeY;
+
+    /**
+     * The content of the selection at the time of the rasterization, see EditSelectionContents::bufferGeneration
+     */
+    unsigned int generation;
+
+    bool sameSize(const SelectionBufferParameters& other) const;
+};
+
+/**
+ * @brief Shared between a selection and its background rasterizations, which only hold a weak reference
+ *
+ * The rasterizations read the elements of the selection while holding the mutex. The selection holds it while it
+ * modifies its elements, and resets contents once it is deleted.
+ */
+struct SelectionRenderTarget {
+    explicit SelectionRenderTarget(EditSelectionContents* contents): contents(contents) {}
+
+    std::mutex mutex;
+    EditSelectionContents* contents;
+};
 
 class EditSelectionContents: public ElementContainer, public Serializable {
 public:
@@ -110,6 +147,20 @@ public:
      */
     void paint(cairo_t* cr, double x, double y, double rotation, double width, double height, double zoom);
 
+    using BufferParameters = SelectionBufferParameters;
+
+    /**
+     * Rasterize the elements into a new surface, as done for the view buffer.
+     * Does not depend on the selection: can be called from any thread, as long as the elements are not modified.
+     */
+    static cairo_surface_t* renderBuffer(const ElementContainer& elements, const BufferParameters& params);
+
+    /**
+     * Called in the UI thread once the elements were rasterized in the background.
+     * Takes ownership of the buffer, which is dropped if the selection has changed in the meantime.
+     */
+    void setRenderedBuffer(cairo_surface_t* buffer, const BufferParameters& params);
+
     /**
      * Finish the editing
      */
@@ -129,9 +180,15 @@ private:
     void deleteViewBuffer();
 
     /**
-     * Callback to redrawing the buffer asynchrony
+     * Rasterize the selection again with the given parameters, once the transformation has not changed for
+     * RERENDER_DELAY ms. Until then, the current buffer is scaled.
+     */
+    void scheduleRerender(const BufferParameters& params);
+
+    /**
+     * Callback starting the background rasterization of the selection
      */
-    static bool repaintSelection(EditSelectionContents* selection);
+    static bool startRerender(EditSelectionContents* selection);
 
 public:
     /**
@@ -215,6 +272,27 @@ private:
      */
     int rescaleId = 0;
 
+    /**
+     * Changed whenever the buffer is deleted because the elements changed: older background rasterizations are dropped
+     */
+    unsigned int bufferGeneration = 0;
+
+    /**
+     * Parameters of the pending or running background rasterization, if any
+     */
+    std::optional<BufferParameters> requestedParameters;
+
+    /**
+     * Shared with the background rasterizations, which only hold a weak reference: the selection may be deleted while
+     * they run. Locked while the elements are modified.
+     */
+    std::shared_ptr<SelectionRenderTarget> renderTarget = std::make_shared<SelectionRenderTarget>(this);
+
+    /**
+     * Delay between the last change of the selection's size and its rasterization at the new size, in ms
+     */
+    static constexpr unsigned int RERENDER_DELAY = 100;
+
     /**
      * Source Page for Undo operations
      */
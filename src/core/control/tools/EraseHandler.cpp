@@ -1,11 +1,13 @@
 #include "EraseHandler.h"
 
-#include <memory>   // for make_unique, unique_ptr
-#include <utility>  // for move
-#include <vector>   // for vector
+#include <algorithm>  // for max, min
+#include <cmath>      // for abs, ceil, floor
+#include <memory>     // for make_unique, unique_ptr
+#include <utility>    // for move
+#include <vector>     // for vector
 
-#include <gdk/gdk.h>  // for GdkRectangle
-#include <glib.h>     // for gint
+#include <gdk/gdk.h>  // for GdkRectangle, GDK_PRIORITY_REDRAW
+#include <glib.h>     // for gint, g_idle_add_full, g_source_remove
 
 #include "control/ToolEnums.h"            // for ERASER_TYPE_DELETE_STROKE
 #include "control/ToolHandler.h"          // for ToolHandler
@@ -35,6 +37,13 @@ EraseHandler::EraseHandler(UndoRedoHandler* undo, Document* doc, const PageRef&
         halfEraserSize(0) {}
 
 EraseHandler::~EraseHandler() {
+    if (this->processingId) {
+        g_source_remove(this->processingId);
+        this->processingId = 0;
+    }
+    // The view may already be gone: do not rerender anything
+    this->queuedPositions.clear();
+
     if (this->eraseDeleteUndoAction) {
         this->finalize();
     }
@@ -42,32 +51,99 @@ EraseHandler::~EraseHandler() {
 
 /**
  * Handle eraser event: "Delete Stroke" and "Standard", Whiteout is not handled here
+ *
+ * The motion events arrive faster than the frames are drawn: the positions are only queued here, and erased all at once
+ * by processQueuedPositions() right before the next redraw.
  */
 void EraseHandler::erase(double x, double y) {
+    if (this->hasLastPosition) {
+        // Fill the path between two samples, so that a fast eraser motion does not skip the strokes it crossed.
+        // Eraser squares at most halfEraserSize apart overlap and cover the swept area.
+        const double halfSize = this->handler->getThickness();
+        const double dx = x - this->lastPosition.x;
+        const double dy = y - this->lastPosition.y;
+        const double distance = std::max(std::abs(dx), std::abs(dy));
+        const int steps = halfSize > 0 ? static_cast<int>(std::min(std::ceil(distance / halfSize),
+                                                                    double(MAX_INTERPOLATED_POSITIONS + 1))) :
+                                         1;
+        for (int i = 1; i < steps; i++) {
+            const double t = static_cast<double>(i) / steps;
+            this->queuedPositions.emplace_back(this->lastPosition.x + t * dx, this->lastPosition.y + t * dy);
+        }
+    }
+    this->queuedPositions.emplace_back(x, y);
+    this->lastPosition = Point(x, y);
+    this->hasLastPosition = true;
+
+    if (!this->processingId) {
+        // Run after the pending input events, but before the redraw
+        this->processingId =
+                g_idle_add_full(GDK_PRIORITY_REDRAW - 1, reinterpret_cast<GSourceFunc>(processQueuedPositionsCallback),
+                                this, nullptr);
+    }
+}
+
+auto EraseHandler::processQueuedPositionsCallback(EraseHandler* handler) -> bool {
+    handler->processingId = 0;
+    handler->processQueuedPositions();
+    return false;
+}
+
+void EraseHandler::processQueuedPositions() {
+    if (this->queuedPositions.empty()) {
+        return;
+    }
+
     this->halfEraserSize = this->handler->getThickness();
-    GdkRectangle eraserRect = {gint(x - halfEraserSize), gint(y - halfEraserSize), gint(halfEraserSize * 2),
-                               gint(halfEraserSize * 2)};
 
-    Range range(x, y);
+    double minX = this->queuedPositions.front().x;
+    double maxX = minX;
+    double minY = this->queuedPositions.front().y;
+    double maxY = minY;
+    for (const Point& p: this->queuedPositions) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+
+    Range range(minX, minY);
+    range.addPoint(maxX, maxY);
 
     Layer* l = page->getSelectedLayer();
 
+    // Query the layer once for the whole swept area. The candidates are copied, since erasing modifies the layer.
+    GdkRectangle sweptRect = {gint(minX - halfEraserSize), gint(minY - halfEraserSize),
+                              gint(maxX - minX + halfEraserSize * 2), gint(maxY - minY + halfEraserSize * 2)};
+    std::vector<Stroke*> candidates;
     for (Element* e: l->getElements()) {
-        if (e->getType() == ELEMENT_STROKE && e->intersectsArea(&eraserRect)) {
-            eraseStroke(l, dynamic_cast<Stroke*>(e), x, y, range);
+        if (e->getType() == ELEMENT_STROKE && e->intersectsArea(&sweptRect)) {
+            candidates.push_back(dynamic_cast<Stroke*>(e));
+        }
+    }
+
+    for (Stroke* s: candidates) {
+        for (const Point& p: this->queuedPositions) {
+            GdkRectangle eraserRect = {gint(p.x - halfEraserSize), gint(p.y - halfEraserSize),
+                                       gint(halfEraserSize * 2), gint(halfEraserSize * 2)};
+            if (s->intersectsArea(&eraserRect) && !eraseStroke(l, s, p.x, p.y, range)) {
+                break;
+            }
         }
     }
 
+    this->queuedPositions.clear();
+
     this->view->rerenderRange(range);
 }
 
-void EraseHandler::eraseStroke(Layer* l, Stroke* s, double x, double y, Range& range) {
+auto EraseHandler::eraseStroke(Layer* l, Stroke* s, double x, double y, Range& range) -> bool {
     ErasableStroke* erasable = s->getErasable();
     if (!erasable) {
         if (this->handler->getEraserType() == ERASER_TYPE_DELETE_STROKE) {
             if (!s->intersects(x, y, halfEraserSize)) {
                 // The stroke does not intersect the eraser square
-                return;
+                return true;
             }
 
             // delete the entire stroke
@@ -76,7 +152,7 @@ void EraseHandler::eraseStroke(Layer* l, Stroke* s, double x, double y, Range& r
             this->doc->unlock();
 
             if (pos == -1) {
-                return;
+                return false;
             }
             range.addPoint(s->getX(), s->getY());
             range.addPoint(s->getX() + s->getElementWidth(), s->getY() + s->getElementHeight());
@@ -91,10 +167,11 @@ void EraseHandler::eraseStroke(Layer* l, Stroke* s, double x, double y, Range& r
             }
 
             this->eraseDeleteUndoAction->addElement(l, s, pos);
+            return false;
         } else {  // Default eraser
             auto pos = l->indexOf(s);
             if (pos == -1) {
-                return;
+                return false;
             }
 
             const double paddingCoeff = PADDING_COEFFICIENT_CAP[s->getStrokeCapStyle()];
@@ -103,7 +180,7 @@ void EraseHandler::eraseStroke(Layer* l, Stroke* s, double x, double y, Range& r
 
             if (intersectionParameters.empty()) {
                 // The stroke does not intersect the eraser square
-                return;
+                return true;
             }
 
             if (this->eraseUndoAction == nullptr) {
@@ -127,15 +204,23 @@ void EraseHandler::eraseStroke(Layer* l, Stroke* s, double x, double y, Range& r
          */
         auto pos = l->indexOf(s);
         if (pos == -1) {
-            return;
+            return false;
         }
         const double paddingCoeff = PADDING_COEFFICIENT_CAP[s->getStrokeCapStyle()];
         const PaddedBox paddedEraserBox{{x, y}, halfEraserSize, halfEraserSize + paddingCoeff * s->getWidth()};
         erasable->erase(paddedEraserBox, range);
     }
+    return true;
 }
 
 void EraseHandler::finalize() {
+    if (this->processingId) {
+        g_source_remove(this->processingId);
+        this->processingId = 0;
+    }
+    processQueuedPositions();
+    this->hasLastPosition = false;
+
     if (this->eraseUndoAction) {
         this->eraseUndoAction->finalize();
         this->eraseUndoAction = nullptr;
@@ -11,7 +11,12 @@
 
 #pragma once
 
+#include <vector>  // for vector
+
+#include <glib.h>  // for guint
+
 #include "model/PageRef.h"  // for PageRef
+#include "model/Point.h"    // for Point
 
 class DeleteUndoAction;
 class Document;
@@ -30,11 +35,32 @@ public:
     virtual ~EraseHandler();
 
 public:
+    /**
+     * Queue an eraser position. The positions received since the last frame are processed together, just before the
+     * next redraw.
+     */
     void erase(double x, double y);
+
+    /**
+     * Process the queued positions and close the undo actions
+     */
     void finalize();
 
 private:
-    void eraseStroke(Layer* l, Stroke* s, double x, double y, Range& range);
+    /**
+     * Erase along the path swept by the queued positions, and rerender the union of the modified areas
+     */
+    void processQueuedPositions();
+
+    /**
+     * Callback processing the queued positions once per frame
+     */
+    static bool processQueuedPositionsCallback(EraseHandler* handler);
+
+    /**
+     * @return false if the whole stroke was deleted
+     */
+    bool eraseStroke(Layer* l, Stroke* s, double x, double y, Range& range);
 
 private:
     PageRef page;
@@ -48,7 +74,28 @@ private:
 
     double halfEraserSize;
 
+    /**
+     * Eraser positions not processed yet, including the positions interpolated between two samples
+     */
+    std::vector<Point> queuedPositions;
+
+    /**
+     * The last queued position, if the eraser is down
+     */
+    Point lastPosition;
+    bool hasLastPosition = false;
+
+    /**
+     * The source id for the processing of the queued positions
+     */
+    guint processingId = 0;
+
 private:
+    /**
+     * Maximum number of eraser positions interpolated between two samples, to bound the work for very long jumps
+     */
+    static constexpr int MAX_INTERPOLATED_POSITIONS = 256;
+
     /**
      * Coefficient for adding padding to the erased sections of strokes.
      * It depends on the stroke cap style ROUND, BUTT or SQUARE.
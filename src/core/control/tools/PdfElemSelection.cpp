@@ -10,21 +10,24 @@
 #include <gdk/gdk.h>  // for GdkRGBA, gdk_cairo_set_source_rgba
 #include <glib.h>     // for g_assert, g_assert_nonnull
 
-#include "control/Control.h"      // for Control
-#include "control/ToolHandler.h"  // for ToolHandler
-#include "gui/PageView.h"         // for XojPageView
-#include "gui/XournalView.h"      // for XournalView
-#include "model/Document.h"       // for Document
-#include "model/PageRef.h"        // for PageRef
-#include "model/XojPage.h"        // for XojPage
-#include "pdf/base/XojPdfPage.h"  // for XojPdfRectangle, XojPdfPageSelectio...
+#include "control/Control.h"                // for Control
+#include "control/ToolHandler.h"            // for ToolHandler
+#include "control/jobs/XournalScheduler.h"  // for XournalScheduler
+#include "gui/PageView.h"                   // for XojPageView
+#include "gui/XournalView.h"                // for XournalView
+#include "model/Document.h"                 // for Document
+#include "model/PageRef.h"                  // for PageRef
+#include "model/XojPage.h"                  // for XojPage
+#include "pdf/base/XojPdfPage.h"            // for XojPdfRectangle, XojPdfPageSelectio...
+#include "pdf/base/XojPdfTextLayout.h"      // for XojPdfTextLayout
 #include "view/overlays/PdfElementSelectionView.h"
 
 PdfElemSelection::PdfElemSelection(double x, double y, Control* control):
         pdf(nullptr),
         bounds({x, y, x, y}),
         finalized(false),
-        viewPool(std::make_shared<xoj::util::DispatchPool<xoj::view::PdfElementSelectionView>>()) {
+        viewPool(std::make_shared<xoj::util::DispatchPool<xoj::view::PdfElementSelectionView>>()),
+        handle(std::make_shared<PdfElemSelection*>(this)) {
 
     if (auto pNr = control->getCurrentPage()->getPdfPageNr(); pNr != npos) {
         Document* doc = control->getDocument();
@@ -33,6 +36,11 @@ PdfElemSelection::PdfElemSelection(double x, double y, Control* control):
         doc->unlock();
 
         this->selectionPageNr = pNr;
+
+        if (this->pdf && !this->pdf->getCachedTextLayout()) {
+            // Extracting the layout of a dense page takes a while: do not block the pointer motions
+            control->getScheduler()->addTextLayout(this->pdf, this->handle);
+        }
     }
 
     this->toolType = control->getToolHandler()->getToolType();
@@ -54,10 +62,14 @@ auto PdfElemSelection::finalizeSelectionAndRepaint(XojPdfPageSelectionStyle styl
 bool PdfElemSelection::finalizeSelection(XojPdfPageSelectionStyle style) {
     this->finalized = true;
 
-    XojPdfPage::TextSelection selection = this->pdf->selectTextLines(this->bounds, style);
+    this->pendingStyle.reset();
+
+    // Blocks if the layout is still being extracted in the background
+    auto layout = this->pdf->getTextLayout();
+    XojPdfPage::TextSelection selection = layout->selectTextLines(this->bounds, style);
     this->selectedTextRegion = std::move(selection.region);
     this->selectedTextRects = std::move(selection.rects);
-    this->selectedText = this->pdf->selectText(this->bounds, style);
+    this->selectedText = layout->selectText(this->bounds, style);
     return !this->selectedTextRects.empty();
 }
 
@@ -94,7 +106,16 @@ void PdfElemSelection::currentPos(double x, double y, XojPdfPageSelectionStyle s
         case XojPdfPageSelectionStyle::Linear:
         case XojPdfPageSelectionStyle::Word:
         case XojPdfPageSelectionStyle::Line:
-            this->selectedTextRegion.reset(this->pdf->selectTextRegion(this->bounds, style), xoj::util::adopt);
+            if (auto layout = this->pdf->getCachedTextLayout()) {
+                this->selectedTextRegion = layout->selectTextRegion(this->bounds, style);
+                this->pendingStyle.reset();
+            } else {
+                // See textLayoutReady()
+                this->pendingStyle = style;
+                if (!this->selectedTextRegion) {
+                    this->selectedTextRegion.reset(cairo_region_create(), xoj::util::adopt);
+                }
+            }
             break;
         case XojPdfPageSelectionStyle::Area: {
             cairo_rectangle_int_t rect;
@@ -113,6 +134,12 @@ void PdfElemSelection::currentPos(double x, double y, XojPdfPageSelectionStyle s
     this->viewPool->dispatch(xoj::view::PdfElementSelectionView::FLAG_DIRTY_REGION_REQUEST, rg);
 }
 
+void PdfElemSelection::textLayoutReady() {
+    if (!this->finalized && this->pendingStyle) {
+        currentPos(this->bounds.x2, this->bounds.y2, *this->pendingStyle);
+    }
+}
+
 auto PdfElemSelection::contains(double x, double y) -> bool {
     if (!this->selectedTextRegion) {
         return false;
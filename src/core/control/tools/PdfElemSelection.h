@@ -11,6 +11,8 @@
 #pragma once
 
 #include <cinttypes>  // for uint64_t
+#include <memory>     // for shared_ptr
+#include <optional>   // for optional
 #include <string>     // for string
 #include <vector>     // for vector
 
@@ -36,8 +38,8 @@ public:
     PdfElemSelection(double x, double y, Control* control);
     PdfElemSelection& operator=(const PdfElemSelection&) = delete;
     PdfElemSelection(const PdfElemSelection&) = delete;
-    PdfElemSelection& operator=(PdfElemSelection&&) = default;
-    PdfElemSelection(PdfElemSelection&&) = default;
+    PdfElemSelection& operator=(PdfElemSelection&&) = delete;
+    PdfElemSelection(PdfElemSelection&&) = delete;
     virtual ~PdfElemSelection();
 
 public:
@@ -49,9 +51,14 @@ public:
     bool finalizeSelection(XojPdfPageSelectionStyle style);
 
     /// Update the (unfinalized) selection bounds with the given
-    /// style.
+    /// style. The selected region is updated once the text layout of
+    /// the page has been extracted in the background.
     void currentPos(double x, double y, XojPdfPageSelectionStyle style);
 
+    /// Called in the UI thread once the text layout of the page has been
+    /// extracted (see TextLayoutJob): updates the selected region.
+    void textLayoutReady();
+
     /// If the selection is a rectangle, returns true iff the given point is
     /// contained in the selection. Returns false on text selection.
     bool contains(double x, double y);
@@ -106,4 +113,11 @@ private:
     bool finalized;
 
     std::shared_ptr<xoj::util::DispatchPool<xoj::view::PdfElementSelectionView>> viewPool;
+
+    /// The style of the last call to currentPos(), if the selected region
+    /// has not been computed because the text layout was not ready.
+    std::optional<XojPdfPageSelectionStyle> pendingStyle;
+
+    /// Weak references to it are handed to the TextLayoutJob
+    std::shared_ptr<PdfElemSelection*> handle;
 };
@@ -1,7 +1,7 @@
 #include "Selection.h"
 
-#include <algorithm>  // for max, min
-#include <cmath>      // for abs, NAN
+#include <algorithm>  // for max, min, clamp
+#include <cmath>      // for abs, ceil, floor
 #include <memory>     // for __shared_ptr_access
 
 #include <gdk/gdk.h>  // for GdkRGBA, gdk_cairo_set_source_rgba
@@ -19,6 +19,12 @@ auto Selection::finalize(PageRef page) -> size_t {
     this->page = page;
     size_t layerId = 0;
 
+    // The tested points of an element span its snapped bounds, and every selection only contains points of its bbox:
+    // elements sticking out of the bbox are rejected without testing their points
+    auto isInSelection = [this](Element* e) {
+        return this->bbox.contains(e->getSnappedBounds()) && e->isInSelection(this);
+    };
+
     if (multiLayer) {
         for (int layerNo = page->getLayers()->size() - 1; layerNo >= 0; layerNo--) {
             Layer* l = page->getLayers()->at(layerNo);
@@ -27,7 +33,7 @@ auto Selection::finalize(PageRef page) -> size_t {
             }
             bool selectionOnLayer = false;
             for (Element* e: l->getElements()) {
-                if (e->isInSelection(this)) {
+                if (isInSelection(e)) {
                     this->selectedElements.push_back(e);
                     selectionOnLayer = true;
                 }
@@ -40,7 +46,7 @@ auto Selection::finalize(PageRef page) -> size_t {
     } else {
         Layer* l = page->getSelectedLayer();
         for (Element* e: l->getElements()) {
-            if (e->isInSelection(this)) {
+            if (isInSelection(e)) {
                 this->selectedElements.push_back(e);
                 layerId = page->getSelectedLayerId();
             }
@@ -96,6 +102,7 @@ RegionSelect::RegionSelect(double x, double y, bool multiLayer): Selection(multi
 void RegionSelect::currentPos(double x, double y) {
     boundaryPoints.emplace_back(x, y);
     bbox.addPoint(x, y);
+    edgeBands.clear();
 
     // at least three points needed
     if (boundaryPoints.size() >= 3) {
@@ -110,66 +117,96 @@ void RegionSelect::currentPos(double x, double y) {
     }
 }
 
-auto RegionSelect::contains(double x, double y) const -> bool {
-    if (boundaryPoints.size() <= 2 || !this->bbox.contains(x, y)) {
-        return false;
+void RegionSelect::buildEdgeBands() const {
+    const size_t edgeCount = boundaryPoints.size();
+    const size_t bandCount =
+            std::clamp(static_cast<size_t>(std::ceil(BANDS_PER_EDGE * static_cast<double>(edgeCount))), size_t(1),
+                       MAX_BANDS);
+    const double height = bbox.maxY - bbox.minY;
+    bandHeight = height > 0 ? height / static_cast<double>(bandCount) : 1.0;
+
+    auto bandOf = [&](double y) {
+        return std::min(static_cast<size_t>(std::max(std::floor((y - bbox.minY) / bandHeight), 0.0)), bandCount - 1);
+    };
+
+    edgeBands.assign(bandCount, {});
+    for (size_t i = 0; i < edgeCount; i++) {
+        const BoundaryPoint& p = boundaryPoints[i == 0 ? edgeCount - 1 : i - 1];
+        const BoundaryPoint& q = boundaryPoints[i];
+        if (p.y == q.y) {
+            // Horizontal edges never cross the ray
+            continue;
+        }
+        const size_t last = bandOf(std::max(p.y, q.y));
+        for (size_t band = bandOf(std::min(p.y, q.y)); band <= last; band++) {
+            edgeBands[band].push_back(i);
+        }
     }
+}
 
-    int hits = 0;
-
-    const BoundaryPoint& last = boundaryPoints.back();
-
-    double lastx = last.x;
-    double lasty = last.y;
-    double curx = NAN, cury = NAN;
+auto RegionSelect::crossesEdge(double x, double y, const BoundaryPoint& p, const BoundaryPoint& q) -> bool {
+    const double lastx = p.x;
+    const double lasty = p.y;
+    const double curx = q.x;
+    const double cury = q.y;
 
-    // Walk the edges of the polygon
-    for (auto pointIterator = boundaryPoints.begin(); pointIterator != boundaryPoints.end();
-         lastx = curx, lasty = cury, ++pointIterator) {
-        curx = pointIterator->x;
-        cury = pointIterator->y;
+    if (cury == lasty) {
+        return false;
+    }
 
-        if (cury == lasty) {
-            continue;
+    int leftx = 0;
+    if (curx < lastx) {
+        if (x >= lastx) {
+            return false;
         }
-
-        int leftx = 0;
-        if (curx < lastx) {
-            if (x >= lastx) {
-                continue;
-            }
-            leftx = static_cast<int>(curx);
-        } else {
-            if (x >= curx) {
-                continue;
-            }
-            leftx = static_cast<int>(lastx);
+        leftx = static_cast<int>(curx);
+    } else {
+        if (x >= curx) {
+            return false;
         }
+        leftx = static_cast<int>(lastx);
+    }
 
-        double test1 = NAN, test2 = NAN;
-        if (cury < lasty) {
-            if (y < cury || y >= lasty) {
-                continue;
-            }
-            if (x < leftx) {
-                hits++;
-                continue;
-            }
-            test1 = x - curx;
-            test2 = y - cury;
-        } else {
-            if (y < lasty || y >= cury) {
-                continue;
-            }
-            if (x < leftx) {
-                hits++;
-                continue;
-            }
-            test1 = x - lastx;
-            test2 = y - lasty;
+    double test1 = 0, test2 = 0;
+    if (cury < lasty) {
+        if (y < cury || y >= lasty) {
+            return false;
+        }
+        if (x < leftx) {
+            return true;
+        }
+        test1 = x - curx;
+        test2 = y - cury;
+    } else {
+        if (y < lasty || y >= cury) {
+            return false;
+        }
+        if (x < leftx) {
+            return true;
         }
+        test1 = x - lastx;
+        test2 = y - lasty;
+    }
+
+    return test1 < (test2 / (lasty - cury) * (lastx - curx));
+}
+
+auto RegionSelect::contains(double x, double y) const -> bool {
+    if (boundaryPoints.size() <= 2 || !this->bbox.contains(x, y)) {
+        return false;
+    }
+
+    if (edgeBands.empty()) {
+        buildEdgeBands();
+    }
+
+    const size_t band = std::min(static_cast<size_t>((y - bbox.minY) / bandHeight), edgeBands.size() - 1);
 
-        if (test1 < (test2 / (lasty - cury) * (lastx - curx))) {
+    // Walk the edges of the polygon crossing the band of the point
+    int hits = 0;
+    const size_t edgeCount = boundaryPoints.size();
+    for (size_t i: edgeBands[band]) {
+        if (crossesEdge(x, y, boundaryPoints[i == 0 ? edgeCount - 1 : i - 1], boundaryPoints[i])) {
             hits++;
         }
     }
@@ -88,4 +88,27 @@ public:
     bool contains(double x, double y) const override;
     bool userTapped(double zoom) const override;
     const std::vector<BoundaryPoint>& getBoundary() const override;
+
+private:
+    /**
+     * @return true if the edge from p to q crosses the horizontal ray through (x, y) (even-odd rule)
+     */
+    static bool crossesEdge(double x, double y, const BoundaryPoint& p, const BoundaryPoint& q);
+
+    void buildEdgeBands() const;
+
+private:
+    /**
+     * The bounding box is split into horizontal bands. Each band lists the edges (by the index of their end point)
+     * whose vertical extent overlaps the band, so that a point is only tested against the few edges of its band.
+     * Built by the first call to contains() after the boundary changed.
+     */
+    mutable std::vector<std::vector<size_t>> edgeBands;
+    mutable double bandHeight = 0;
+
+    /**
+     * Bands used per edge of the boundary, and maximal number of bands
+     */
+    static constexpr double BANDS_PER_EDGE = 0.5;
+    static constexpr size_t MAX_BANDS = 4096;
 };
@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <memory>  // for shared_ptr
+#include <string>  // for string
+
 #include <cairo.h>  // for cairo_surface_t, cairo_status_t
 
 #include "XmlNode.h"  // for XmlNode
@@ -25,12 +28,18 @@ public:
 public:
     void setImage(cairo_surface_t* img);
 
+    /**
+     * Write the given PNG data as is, instead of encoding an image surface
+     */
+    void setPngData(std::shared_ptr<const std::string> data);
+
     static cairo_status_t pngWriteFunction(XmlImageNode* image, const unsigned char* data, unsigned int length);
 
     void writeOut(OutputStream* out) override;
 
 private:
     cairo_surface_t* img;
+    std::shared_ptr<const std::string> pngData;
 
     OutputStream* out;
     int pos;
@@ -9,6 +9,7 @@
 #include <regex>        // for regex_search, smatch
 #include <type_traits>  // for remove_reference<>::type
 #include <utility>      // for move
+#include <vector>       // for vector
 
 #include <gio/gio.h>      // for g_file_get_path, g_fil...
 #include <glib-object.h>  // for g_object_unref
@@ -27,13 +28,41 @@
 #include "model/XojPage.h"                     // for XojPage
 #include "util/GzUtil.h"                       // for GzUtil
 #include "util/LoopUtil.h"
+#include "util/PathUtil.h"           // for toGFilename
 #include "util/PlaceholderString.h"  // for PlaceholderString
 #include "util/i18n.h"               // for _F, FC, FS, _
 
 #include "LoadHandlerHelper.h"  // for getAttrib, getAttribDo...
+#include "ZipArchive.h"         // for ZipArchive
 
 using std::string;
 
+namespace {
+/**
+ * Size of the chunks of compressed files fed to the XML parser
+ */
+constexpr size_t PARSER_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * @return A mapping of the file if it is a plain XML file (saved without compression), nullptr otherwise
+ */
+GMappedFile* mapUncompressedFile(fs::path const& filepath) {
+    GMappedFile* file = g_mapped_file_new(Util::toGFilename(filepath).c_str(), false, nullptr);
+    if (!file) {
+        return nullptr;
+    }
+
+    // gzip magic number
+    const gsize length = g_mapped_file_get_length(file);
+    const auto* content = reinterpret_cast<const unsigned char*>(g_mapped_file_get_contents(file));
+    if (length >= 2 && content[0] == 0x1f && content[1] == 0x8b) {
+        g_mapped_file_unref(file);
+        return nullptr;
+    }
+    return file;
+}
+}  // namespace
+
 #define error2(var, ...)                                                                \
     if (var == nullptr) {                                                               \
         var = g_error_new(G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT, __VA_ARGS__); \
@@ -82,10 +111,12 @@ LoadHandler::~LoadHandler() {
 }
 
 void LoadHandler::initAttributes() {
+    this->zipArchive.reset();
     this->zipFp = nullptr;
     this->zipContentFile = nullptr;
     this->gzFp = nullptr;
     this->isGzFile = false;
+    this->mappedContent = nullptr;
     this->error = nullptr;
     this->attributeNames = nullptr;
     this->attributeValues = nullptr;
@@ -124,11 +155,18 @@ auto LoadHandler::openFile(fs::path const& filepath) -> bool {
     this->filepath = filepath;
     int zipError = 0;
     this->zipFp = zip_open(filepath.u8string().c_str(), ZIP_RDONLY, &zipError);
+    if (this->zipFp) {
+        this->zipArchive = std::make_shared<ZipArchive>(this->zipFp);
+    }
 
     // Check if the file is actually an old XOPP-File and open it
     if (!this->zipFp && zipError == ZIP_ER_NOZIP) {
-        this->gzFp = GzUtil::openPath(filepath, "r");
         this->isGzFile = true;
+        // Files saved without compression are parsed directly from a memory mapping
+        this->mappedContent = mapUncompressedFile(filepath);
+        if (!this->mappedContent) {
+            this->gzFp = GzUtil::openPath(filepath, "r");
+        }
     }
 
     if (this->zipFp && !this->isGzFile) {
@@ -183,7 +221,7 @@ auto LoadHandler::openFile(fs::path const& filepath) -> bool {
     }
 
     // Fail if neither utility could open the file
-    if (!this->zipFp && !this->gzFp) {
+    if (!this->zipFp && !this->gzFp && !this->mappedContent) {
         this->lastError = FS(_F("Could not open file: \"{1}\"") % filepath.u8string());
         return false;
     }
@@ -191,14 +229,23 @@ auto LoadHandler::openFile(fs::path const& filepath) -> bool {
 }
 
 auto LoadHandler::closeFile() -> bool {
+    if (this->mappedContent) {
+        g_mapped_file_unref(this->mappedContent);
+        this->mappedContent = nullptr;
+        return true;
+    }
+
     if (this->isGzFile) {
         return static_cast<bool>(gzclose(this->gzFp));
     }
 
     g_assert(this->zipContentFile != nullptr);
     zip_fclose(this->zipContentFile);
-    int zipError = zip_close(this->zipFp);
-    return zipError == 0;
+    this->zipContentFile = nullptr;
+    // The archive itself stays open as long as some attachments were not read yet
+    this->zipFp = nullptr;
+    this->zipArchive.reset();
+    return true;
 }
 
 auto LoadHandler::readContentFile(char* buffer, zip_uint64_t len) -> zip_int64_t {
@@ -231,20 +278,31 @@ auto LoadHandler::parseXml() -> bool {
     GMarkupParseContext* context =
             g_markup_parse_context_new(&parser, static_cast<GMarkupParseFlags>(0), this, nullptr);
 
-    zip_int64_t len = 0;
-    do {
-        char buffer[1024];
-        len = readContentFile(buffer, sizeof(buffer));
-        if (len > 0) {
-            valid = g_markup_parse_context_parse(context, buffer, len, &error);
-        }
-
+    if (this->mappedContent) {
+        // The whole file is parsed in one go, without copying it
+        valid = g_markup_parse_context_parse(context, g_mapped_file_get_contents(this->mappedContent),
+                                             static_cast<gssize>(g_mapped_file_get_length(this->mappedContent)),
+                                             &error);
         if (error) {
             g_warning("LoadHandler::parseXml: %s\n", error->message);
             valid = false;
-            break;
         }
-    } while (len >= 0 && valid && !error);
+    } else {
+        std::vector<char> buffer(PARSER_CHUNK_SIZE);
+        zip_int64_t len = 0;
+        do {
+            len = readContentFile(buffer.data(), buffer.size());
+            if (len > 0) {
+                valid = g_markup_parse_context_parse(context, buffer.data(), len, &error);
+            }
+
+            if (error) {
+                g_warning("LoadHandler::parseXml: %s\n", error->message);
+                valid = false;
+                break;
+            }
+        } while (len >= 0 && valid && !error);
+    }
 
     if (valid) {
         valid = g_markup_parse_context_end_parse(context, &error);
@@ -746,19 +804,19 @@ void LoadHandler::parseAttachment() {
     }
     const char* path = LoadHandlerHelper::getAttrib("path", false, this);
 
-    auto readResult = readZipAttachment(path);
-    if (!readResult) {
+    // The attachment is only read (and decoded) when the element is first drawn or saved
+    if (!this->zipArchive || !this->zipArchive->contains(path)) {
+        error("%s", FC(_F("Could not open attachment: {1}") % path));
         return;
     }
-    std::string& imgData = *readResult;
 
     switch (this->pos) {
         case PARSER_POS_IN_IMAGE: {
-            this->image->setImage(std::move(imgData));
+            this->image->setDataReader(createZipAttachmentReader(path));
             break;
         }
         case PARSER_POS_IN_TEXIMAGE: {
-            this->teximage->loadData(std::move(imgData), nullptr);
+            this->teximage->setDataReader(createZipAttachmentReader(path));
             break;
         }
         default:
@@ -928,7 +986,7 @@ void LoadHandler::parserEndElement(GMarkupParseContext* context, const gchar* el
         handler->pos = PARSER_POS_IN_LAYER;
         handler->text = nullptr;
     } else if (handler->pos == PARSER_POS_IN_IMAGE && strcmp(elementName, "image") == 0) {
-        g_assert(handler->image->getImage() != nullptr && "image can't be rendered");
+        g_assert(handler->image->hasData() && "image has no data");
         handler->pos = PARSER_POS_IN_LAYER;
         handler->image = nullptr;
     } else if (handler->pos == PARSER_POS_IN_TEXIMAGE && strcmp(elementName, "teximage") == 0) {
@@ -1143,45 +1201,23 @@ auto LoadHandler::loadDocument(fs::path const& filepath) -> Document* {
 }
 
 auto LoadHandler::readZipAttachment(fs::path const& filename) -> std::optional<std::string> {
-    zip_stat_t attachmentFileStat;
-    const int statStatus = zip_stat(this->zipFp, filename.u8string().c_str(), 0, &attachmentFileStat);
-    if (statStatus != 0) {
-        error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename.string() %
-                       zip_error_strerror(zip_get_error(this->zipFp))));
-        return {};
-    }
-
-    if (!(attachmentFileStat.valid & ZIP_STAT_SIZE)) {
-        error("%s",
-              FC(_F("Could not open attachment: {1}. Error message: No valid file size provided") % filename.string()));
-        return {};
-    }
-    const zip_uint64_t length = attachmentFileStat.size;
-
-    zip_file_t* attachmentFile = zip_fopen(this->zipFp, filename.u8string().c_str(), 0);
-    if (!attachmentFile) {
-        error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename.string() %
-                       zip_error_strerror(zip_get_error(this->zipFp))));
-        return {};
+    std::string errorMessage;
+    auto data = this->zipArchive->read(filename, errorMessage);
+    if (!data) {
+        error("%s", errorMessage.c_str());
     }
+    return data;
+}
 
-    std::string data(length, 0);
-    zip_uint64_t readBytes = 0;
-    while (readBytes < length) {
-        const zip_int64_t read = zip_fread(attachmentFile, data.data() + readBytes, length - readBytes);
-        if (read == -1) {
-            zip_fclose(attachmentFile);
-            error("%s", FC(_F("Could not open attachment: {1}. Error message: No valid file size provided") %
-                           filename.string()));
-            return {};
+auto LoadHandler::createZipAttachmentReader(fs::path filename) -> LazyData::Reader {
+    return [archive = this->zipArchive, filename = std::move(filename)]() -> std::optional<std::string> {
+        std::string errorMessage;
+        auto data = archive->read(filename, errorMessage);
+        if (!data) {
+            g_warning("%s", errorMessage.c_str());
         }
-
-        readBytes += static_cast<zip_uint64_t>(read);
-    }
-
-    zip_fclose(attachmentFile);
-
-    return {std::move(data)};
+        return data;
+    };
 }
 
 auto LoadHandler::getTempFileForPath(fs::path const& filename) -> fs::path {
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstddef>   // for size_t
+#include <memory>    // for shared_ptr
 #include <optional>  // for optional
 #include <string>    // for string
 #include <vector>    // for vector
@@ -23,6 +24,7 @@
 
 #include "model/Document.h"         // for Document
 #include "model/DocumentHandler.h"  // for DocumentHandler
+#include "model/LazyData.h"         // for LazyData
 #include "model/PageRef.h"          // for PageRef
 #include "util/Color.h"             // for Color
 
@@ -31,6 +33,7 @@
 
 class Image;
 class Layer;
+class ZipArchive;
 class Stroke;
 class TexImage;
 class Text;
@@ -117,6 +120,12 @@ private:
      */
     std::optional<std::string> readZipAttachment(fs::path const& filename);
 
+    /**
+     * Returns a reader of the zip attachment with the given file name, for the elements which read their data when it
+     * is first needed. The archive is kept open until all the readers are gone.
+     */
+    LazyData::Reader createZipAttachmentReader(fs::path filename);
+
     fs::path getTempFileForPath(fs::path const& filename);
 
 private:
@@ -138,11 +147,20 @@ private:
     int fileVersion;
     int minimalFileVersion;
 
+    /**
+     * The archive of zipFp, shared with the readers of the attachments which were not read yet
+     */
+    std::shared_ptr<ZipArchive> zipArchive;
     zip_t* zipFp;
     zip_file_t* zipContentFile;
     gzFile gzFp;
     bool isGzFile = false;
 
+    /**
+     * The content of an uncompressed file, parsed directly from the mapping
+     */
+    GMappedFile* mappedContent = nullptr;
+
     std::vector<double> pressureBuffer;
 
     std::vector<PageRef> pages;
@@ -1,8 +1,10 @@
 #include "SaveHandler.h"
 
-#include <cinttypes>   // for PRIx32, uint32_t
-#include <cstdio>      // for sprintf, size_t
-#include <filesystem>  // for exists
+#include <cinttypes>    // for PRIx32, uint32_t
+#include <cstdio>       // for sprintf, size_t
+#include <filesystem>   // for exists
+#include <string>       // for string
+#include <string_view>  // for string_view
 
 #include <cairo.h>                  // for cairo_surface_t
 #include <gdk-pixbuf/gdk-pixbuf.h>  // for gdk_pixbuf_save
@@ -38,6 +40,13 @@
 
 #include "config.h"  // for FILE_FORMAT_VERSION
 
+namespace {
+auto isPngData(const std::string& data) -> bool {
+    constexpr std::string_view PNG_SIGNATURE = "\x89PNG\r\n\x1a\n";
+    return std::string_view(data).substr(0, PNG_SIGNATURE.size()) == PNG_SIGNATURE;
+}
+}  // namespace
+
 SaveHandler::SaveHandler() {
     this->firstPdfPageVisited = false;
     this->attachBgId = 1;
@@ -188,10 +197,22 @@ void SaveHandler::visitLayer(XmlNode* page, Layer* l) {
             writeTimestamp(t, text);
         } else if (e->getType() == ELEMENT_IMAGE) {
             auto* i = dynamic_cast<Image*>(e);
+            const auto& data = i->getSharedData();
+            if (data->empty()) {
+                // The attachment could not be read
+                g_warning("Skipping an image without data");
+                continue;
+            }
+
             auto* image = new XmlImageNode("image");
             layer->addChild(image);
 
-            image->setImage(i->getImage());
+            if (isPngData(*data)) {
+                // Copy the data as is: untouched attachments need not be decoded and encoded again
+                image->setPngData(data);
+            } else {
+                image->setImage(i->getImage().get());
+            }
 
             image->setAttrib("left", i->getX());
             image->setAttrib("top", i->getY());
@@ -335,8 +356,10 @@ void SaveHandler::writeBackgroundName(XmlNode* background, PageRef p) {
     }
 }
 
+void SaveHandler::setCompressed(bool compressed) { this->compressed = compressed; }
+
 void SaveHandler::saveTo(const fs::path& filepath, ProgressListener* listener) {
-    GzOutputStream out(filepath);
+    GzOutputStream out(filepath, this->compressed);
 
     if (!out.getLastError().empty()) {
         this->errorMessage = out.getLastError();
@@ -37,6 +37,11 @@ public:
 
 public:
     void prepareSave(Document* doc);
+
+    /**
+     * @param compressed If false, saveTo(filepath) writes plain XML instead of gzip-compressed XML
+     */
+    void setCompressed(bool compressed);
     void saveTo(const fs::path& filepath, ProgressListener* listener = nullptr);
     void saveTo(OutputStream* out, const fs::path& filepath, ProgressListener* listener = nullptr);
     std::string getErrorMessage();
@@ -65,5 +70,7 @@ protected:
 
     std::string errorMessage;
 
+    bool compressed = true;
+
     std::vector<BackgroundImage> backgroundImages{};
 };
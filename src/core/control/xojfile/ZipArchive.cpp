@@ -0,0 +1,61 @@
+#include "ZipArchive.h"
+
+#include <utility>  // for move
+
+#include <zipconf.h>  // for zip_int64_t, zip_uint64_t
+
+#include "util/PlaceholderString.h"  // for PlaceholderString
+#include "util/i18n.h"               // for _F, FS
+
+ZipArchive::ZipArchive(zip_t* archive): archive(archive) {}
+
+ZipArchive::~ZipArchive() { zip_discard(this->archive); }
+
+auto ZipArchive::contains(const fs::path& filename) -> bool {
+    std::lock_guard lock(this->mutex);
+    return zip_name_locate(this->archive, filename.u8string().c_str(), 0) >= 0;
+}
+
+auto ZipArchive::read(const fs::path& filename, std::string& errorMessage) -> std::optional<std::string> {
+    std::lock_guard lock(this->mutex);
+
+    zip_stat_t attachmentFileStat;
+    const int statStatus = zip_stat(this->archive, filename.u8string().c_str(), 0, &attachmentFileStat);
+    if (statStatus != 0) {
+        errorMessage = FS(_F("Could not open attachment: {1}. Error message: {2}") % filename.string() %
+                          zip_error_strerror(zip_get_error(this->archive)));
+        return {};
+    }
+
+    if (!(attachmentFileStat.valid & ZIP_STAT_SIZE)) {
+        errorMessage = FS(_F("Could not open attachment: {1}. Error message: No valid file size provided") %
+                          filename.string());
+        return {};
+    }
+    const zip_uint64_t length = attachmentFileStat.size;
+
+    zip_file_t* attachmentFile = zip_fopen(this->archive, filename.u8string().c_str(), 0);
+    if (!attachmentFile) {
+        errorMessage = FS(_F("Could not open attachment: {1}. Error message: {2}") % filename.string() %
+                          zip_error_strerror(zip_get_error(this->archive)));
+        return {};
+    }
+
+    std::string data(length, 0);
+    zip_uint64_t readBytes = 0;
+    while (readBytes < length) {
+        const zip_int64_t read = zip_fread(attachmentFile, data.data() + readBytes, length - readBytes);
+        if (read == -1) {
+            zip_fclose(attachmentFile);
+            errorMessage = FS(_F("Could not open attachment: {1}. Error message: No valid file size provided") %
+                              filename.string());
+            return {};
+        }
+
+        readBytes += static_cast<zip_uint64_t>(read);
+    }
+
+    zip_fclose(attachmentFile);
+
+    return {std::move(data)};
+}
@@ -0,0 +1,54 @@
+/*
+ * Xournal++
+ *
+ * A zip archive whose files are read on demand
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <mutex>     // for mutex
+#include <optional>  // for optional
+#include <string>    // for string
+
+#include <zip.h>  // for zip_t
+
+#include "filesystem.h"  // for path
+
+/**
+ * @brief Keeps a zip archive open, so that its attachments can be read when they are first needed.
+ *
+ * Shared by the LoadHandler and the readers of the elements whose data has not been read yet. The archive is closed
+ * when the last of them is gone. libzip archives are not thread-safe: all reads are serialized.
+ */
+class ZipArchive {
+public:
+    /**
+     * @param archive An archive opened read-only. Takes ownership.
+     */
+    explicit ZipArchive(zip_t* archive);
+    ~ZipArchive();
+
+    ZipArchive(const ZipArchive&) = delete;
+    ZipArchive& operator=(const ZipArchive&) = delete;
+
+    /**
+     * @return true if the archive contains a file with the given name. Does not read the file.
+     */
+    bool contains(const fs::path& filename);
+
+    /**
+     * Reads the file with the given name
+     * @param errorMessage Set to a translated error message if the file could not be read
+     * @return The contents of the file, or nullopt if it could not be read
+     */
+    std::optional<std::string> read(const fs::path& filename, std::string& errorMessage);
+
+private:
+    std::mutex mutex;
+    zip_t* archive;
+};
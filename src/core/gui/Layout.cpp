@@ -1,11 +1,13 @@
 #include "Layout.h"
 
-#include <algorithm>    // for max, lower_bound, transform
+#include <algorithm>    // for max, lower_bound, upper_bound, set_difference, sort
 #include <cmath>        // for abs
-#include <iterator>     // for begin, end, distance
+#include <iterator>     // for begin, end, distance, back_inserter
 #include <numeric>      // for accumulate
 #include <optional>     // for optional
 #include <type_traits>  // for make_signed_t, remove_referen...
+#include <utility>      // for pair, move
+#include <vector>       // for vector
 
 #include <glib-object.h>  // for G_CALLBACK, g_signal_connect
 
@@ -37,6 +39,20 @@ constexpr auto const XOURNAL_ROOM_FOR_SHADOW = 3;
  */
 constexpr auto const XOURNAL_PADDING_BETWEEN = 15;
 
+/**
+ * @param ends The sorted end coordinates of consecutive rows (or columns), the first one starting at 0
+ * @return The range [first, last) of the rows intersecting [start, end]
+ */
+static std::pair<size_t, size_t> intersectingRange(const std::vector<unsigned>& ends, double start, double end) {
+    auto first = std::lower_bound(ends.begin(), ends.end(), start);
+    // The rows up to the first one ending after `end` start before `end`
+    auto last = std::upper_bound(first, ends.end(), end);
+    if (last != ends.end()) {
+        ++last;
+    }
+    return {size_t(std::distance(ends.begin(), first)), size_t(std::distance(ends.begin(), last))};
+}
+
 
 Layout::Layout(XournalView* view, ScrollHandling* scrollHandling): view(view), scrollHandling(scrollHandling) {
     g_signal_connect(scrollHandling->getHorizontal(), "value-changed", G_CALLBACK(horizontalScrollChanged), this);
@@ -89,49 +105,66 @@ void Layout::checkScroll(GtkAdjustment* adjustment, double& lastScroll) {
 void Layout::updateVisibility() {
     Rectangle visRect = getVisibleRect();
 
-    // step through every possible page position and update using p->setIsVisible()
-    // Using initial grid aprox speeds things up by a factor of 5.  See previous git check-in for specifics.
-    int x1 = 0;
-    int y1 = 0;
-
     // Data to select page based on visibility
     std::optional<size_t> mostPageNr;
     double mostPagePercent = 0;
 
-    for (size_t row = 0; row < this->rowYStart.size(); ++row) {
-        auto y2 = as_signed_strict(this->rowYStart[row]);
-        for (size_t col = 0; col < this->colXStart.size(); ++col) {
-            auto x2 = as_signed_strict(this->colXStart[col]);
+    // Binary search of the grid cells intersecting the visible rectangle, as an approximation of page visibility
+    auto const [firstRow, endRow] = intersectingRange(this->rowYStart, visRect.y, visRect.y + visRect.height);
+    auto const [firstCol, endCol] = intersectingRange(this->colXStart, visRect.x, visRect.x + visRect.width);
+
+    std::vector<size_t> nowVisible;
+    for (size_t row = firstRow; row < endRow; ++row) {
+        for (size_t col = firstCol; col < endCol; ++col) {
             auto optionalPage = this->mapper.at({col, row});
-            if (optionalPage)  // a page exists at this grid location
-            {
-                XojPageView* pageView = this->view->viewPages[*optionalPage];
-
-
-                // check if grid location is visible as an aprox for page visiblity:
-                if (!(visRect.x > x2 || visRect.x + visRect.width < x1)  // visrect not outside current row/col
-                    && !(visRect.y > y2 || visRect.y + visRect.height < y1)) {
-                    // now use exact check of page itself:
-                    // visrect not outside current page dimensions:
-                    auto const& pageRect = pageView->getRect();
-                    if (auto intersection = pageRect.intersects(visRect); intersection) {
-                        pageView->setIsVisible(true);
-                        // Set the selected page
-                        double percent = intersection->area() / pageRect.area();
-
-                        if (percent > mostPagePercent) {
-                            mostPageNr = *optionalPage;
-                            mostPagePercent = percent;
-                        }
-                    }
-                } else {
-                    pageView->setIsVisible(false);
+            if (!optionalPage) {
+                continue;
+            }
+            // now use exact check of page itself:
+            XojPageView* pageView = this->view->viewPages[*optionalPage];
+            auto const& pageRect = pageView->getRect();
+            if (auto intersection = pageRect.intersects(visRect); intersection) {
+                pageView->setIsVisible(true);
+                nowVisible.push_back(*optionalPage);
+
+                // Set the selected page
+                double percent = intersection->area() / pageRect.area();
+                if (percent > mostPagePercent) {
+                    mostPageNr = *optionalPage;
+                    mostPagePercent = percent;
                 }
             }
-            x1 = x2;
         }
-        y1 = y2;
-        x1 = 0;
+    }
+    std::sort(nowVisible.begin(), nowVisible.end());
+
+    std::vector<size_t> shown;
+    std::vector<size_t> hidden;
+    if (this->visibilityOutdated) {
+        // The page views were rebuilt or moved: update all of them once
+        size_t const pageCount = this->view->viewPages.size();
+        for (size_t page = 0, i = 0; page < pageCount; ++page) {
+            if (i < nowVisible.size() && nowVisible[i] == page) {
+                ++i;
+            } else {
+                this->view->viewPages[page]->setIsVisible(false);
+            }
+        }
+        shown = nowVisible;
+        this->visibilityOutdated = false;
+    } else {
+        std::set_difference(nowVisible.begin(), nowVisible.end(), this->visiblePages.begin(), this->visiblePages.end(),
+                            std::back_inserter(shown));
+        std::set_difference(this->visiblePages.begin(), this->visiblePages.end(), nowVisible.begin(), nowVisible.end(),
+                            std::back_inserter(hidden));
+        for (size_t page: hidden) {
+            this->view->viewPages[page]->setIsVisible(false);
+        }
+    }
+    this->visiblePages = std::move(nowVisible);
+
+    if (!shown.empty() || !hidden.empty()) {
+        this->view->pagesVisibilityChanged(shown, hidden);
     }
 
     if (mostPageNr) {
@@ -200,6 +233,7 @@ void Layout::recalculate_int() const {
 
 void Layout::recalculate() {
     pc.valid = false;
+    visibilityOutdated = true;
     gtk_widget_queue_resize(view->getWidget());
 }
 
@@ -105,6 +105,9 @@ public:
      * Updates the current XojPageView. The XojPageView is selected based on
      * the percentage of the visible area of the XojPageView relative
      * to its total area.
+     *
+     * Only the rows and columns intersecting the visible area are inspected (binary search), and only the pages whose
+     * visibility changed are notified to the XournalView.
      */
     void updateVisibility();
 
@@ -178,4 +181,15 @@ private:
     mutable PreCalculated pc{};
     mutable std::vector<unsigned> colXStart;
     mutable std::vector<unsigned> rowYStart;
+
+    /**
+     * The indices of the visible pages after the last updateVisibility(), sorted
+     */
+    std::vector<size_t> visiblePages;
+
+    /**
+     * The page views may have changed since the last updateVisibility() (see recalculate()): visiblePages cannot be
+     * trusted, all the pages need to be updated
+     */
+    bool visibilityOutdated = true;
 };
@@ -628,7 +628,8 @@ void MainWindow::updateToolbarMenu() {
 void MainWindow::createToolbar() {
     toolbarSelected(control->getSettings()->getSelectedToolbar());
 
-    if (!this->control->getAudioController()->isPlaying()) {
+    // Do not create the audio controller here: it is only initialized once the window is drawn
+    if (!this->control->hasAudioController() || !this->control->getAudioController()->isPlaying()) {
         this->getToolMenuHandler()->disableAudioPlaybackButtons();
     }
 
@@ -59,6 +59,7 @@
 #include "model/XojPage.h"                          // for XojPage
 #include "pdf/base/XojPdfAction.h"                  // for XojPdfAction
 #include "pdf/base/XojPdfDocument.h"                // for XojPdfDocument
+#include "pdf/base/XojPdfLinkMap.h"                 // for XojPdfLinkMap
 #include "pdf/base/XojPdfPage.h"                    // for XojPdfRectangle
 #include "undo/DeleteUndoAction.h"                  // for DeleteUndoAction
 #include "undo/InsertUndoAction.h"                  // for InsertUndoAction
@@ -127,6 +128,7 @@ void XojPageView::setIsVisible(bool visible) { this->visible = visible; }
 void XojPageView::deleteViewBuffer() {
     std::lock_guard lock(this->drawingMutex);
     this->buffer.reset();
+    this->background.buffer.reset();
 }
 
 auto XojPageView::containsPoint(int x, int y, bool local) const -> bool {
@@ -363,6 +365,14 @@ auto XojPageView::onButtonPressEvent(const PositionInputData& pos) -> bool {
                 }
             }
 
+            if (auto pdfPageNr = this->page->getPdfPageNr(); pdfPageNr != npos) {
+                // The links are looked up on release (see displayLinkPopover()): extract them in the meantime
+                auto pdfPage = xournal->getDocument()->getPdfDocument().getPage(pdfPageNr);
+                if (pdfPage && !pdfPage->getCachedLinkMap()) {
+                    control->getScheduler()->addLinkMap(pdfPage);
+                }
+            }
+
             if (this->page->getPdfPageNr() != npos && !pdfToolbox->hasSelection()) {
                 pdfToolbox->selectionStyle = PdfElemSelection::selectionStyleForToolType(h->getToolType());
                 auto sel = pdfToolbox->newSelection(x, y);
@@ -897,72 +907,69 @@ void XojPageView::drawLoadingPage(cairo_t* cr) {
 
 bool XojPageView::displayLinkPopover(std::shared_ptr<XojPdfPage> page, double pageX, double pageY) {
     // Search for selected link
-    const auto links = page->getLinks();
+    const auto linkMap = page->getLinkMap();
+    const XojPdfPage::Link* link = linkMap->findLink(pageX, pageY);
+    if (!link) {
+        return false;
+    }
 
-    for (auto&& [rect, action]: links) {
-        std::shared_ptr<const LinkDestination> dest = action->getDestination();
+    const auto& [rect, action] = *link;
+    std::shared_ptr<const LinkDestination> dest = action->getDestination();
 
-        if (!(rect.x1 <= pageX && pageX <= rect.x2 && rect.y1 <= pageY && pageY <= rect.y2)) {
-            continue;
-        }
+    GtkWidget* box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+    GtkWidget* popover = makePopover(rect, box);
 
-        GtkWidget* box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
-        GtkWidget* popover = makePopover(rect, box);
+    if (auto uriOpt = dest->getURI()) {
+        const std::string& uri = uriOpt.value();
+        char* uriLabel = g_markup_escape_text(uri.c_str(), -1);
 
-        if (auto uriOpt = dest->getURI()) {
-            const std::string& uri = uriOpt.value();
-            char* uriLabel = g_markup_escape_text(uri.c_str(), -1);
+        auto labelMarkup = serdes_stream<std::stringstream>();
+        labelMarkup << "<a href=" << std::quoted(uri) << ">" << uriLabel << "</a>";
 
-            auto labelMarkup = serdes_stream<std::stringstream>();
-            labelMarkup << "<a href=" << std::quoted(uri) << ">" << uriLabel << "</a>";
+        std::string linkMarkup = labelMarkup.str();
 
-            std::string linkMarkup = labelMarkup.str();
+        g_free(uriLabel);
 
-            g_free(uriLabel);
-
-            GtkWidget* label = gtk_label_new(nullptr);
-            gtk_label_set_markup(GTK_LABEL(label), linkMarkup.c_str());
-            gtk_box_append(GTK_BOX(box), label);
-        } else {
-            size_t pdfPage = dest->getPdfPage();
+        GtkWidget* label = gtk_label_new(nullptr);
+        gtk_label_set_markup(GTK_LABEL(label), linkMarkup.c_str());
+        gtk_box_append(GTK_BOX(box), label);
+    } else {
+        size_t pdfPage = dest->getPdfPage();
 
-            Document* doc = xournal->getControl()->getDocument();
-            doc->lock();
-            const size_t pageId = doc->findPdfPage(pdfPage);
-            doc->unlock();
+        Document* doc = xournal->getControl()->getDocument();
+        doc->lock();
+        const size_t pageId = doc->findPdfPage(pdfPage);
+        doc->unlock();
 
-            GtkWidget* button{};
-            if (pageId != npos) {
-                const auto pageNo = static_cast<int64_t>(pageId + 1);
-                button = gtk_button_new_with_label(FC(_F("Scroll to page {1}") % pageNo));
-            } else {
-                button = gtk_button_new_with_label(FC(_F("Add missing page")));
-            }
-            gtk_box_append(GTK_BOX(box), button);
-
-            g_signal_connect(
-                    button, "clicked",
-                    G_CALLBACK(+[](GtkButton* bt,
-                                   std::tuple<XojPageView*, std::shared_ptr<LinkDestination>, GtkWidget*>* state) {
-                        XojPageView* self;
-                        std::shared_ptr<LinkDestination> dest;
-                        GtkWidget* popover;
-                        std::tie(self, dest, popover) = *state;
-
-                        self->getXournal()->getControl()->getScrollHandler()->scrollToLinkDest(*dest);
-                        gtk_popover_popdown(GTK_POPOVER(popover));
-
-                        delete state;
-                    }),
-                    new std::tuple(std::make_tuple(this, dest, popover)));
+        GtkWidget* button{};
+        if (pageId != npos) {
+            const auto pageNo = static_cast<int64_t>(pageId + 1);
+            button = gtk_button_new_with_label(FC(_F("Scroll to page {1}") % pageNo));
+        } else {
+            button = gtk_button_new_with_label(FC(_F("Add missing page")));
         }
-
-        gtk_widget_show_all(popover);
-        gtk_popover_popup(GTK_POPOVER(popover));
-        return true;
+        gtk_box_append(GTK_BOX(box), button);
+
+        g_signal_connect(
+                button, "clicked",
+                G_CALLBACK(+[](GtkButton* bt,
+                               std::tuple<XojPageView*, std::shared_ptr<LinkDestination>, GtkWidget*>* state) {
+                    XojPageView* self;
+                    std::shared_ptr<LinkDestination> dest;
+                    GtkWidget* popover;
+                    std::tie(self, dest, popover) = *state;
+
+                    self->getXournal()->getControl()->getScrollHandler()->scrollToLinkDest(*dest);
+                    gtk_popover_popdown(GTK_POPOVER(popover));
+
+                    delete state;
+                }),
+                new std::tuple(std::make_tuple(this, dest, popover)));
     }
 
-    return false;
+    gtk_widget_show_all(popover);
+    gtk_popover_popup(GTK_POPOVER(popover));
+    return true;
 }
 
 GtkWidget* XojPageView::makePopover(const XojPdfRectangle& rect, GtkWidget* child) {
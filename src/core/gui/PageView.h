@@ -21,12 +21,13 @@
 #include <gdk/gdk.h>  // for GdkEventKey, GdkRGBA, GdkRectangle
 #include <gtk/gtk.h>  // for GtkWidget
 
-#include "model/PageListener.h"       // for PageListener
-#include "model/PageRef.h"            // for PageRef
-#include "util/Rectangle.h"           // for Rectangle
-#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
-#include "view/Mask.h"                // for Mask
-#include "view/Repaintable.h"         // for Repaintable
+#include "model/PageListener.h"               // for PageListener
+#include "model/PageRef.h"                    // for PageRef
+#include "util/Rectangle.h"                   // for Rectangle
+#include "util/raii/CairoWrappers.h"          // for CairoSurfaceSPtr
+#include "view/Mask.h"                        // for Mask
+#include "view/Repaintable.h"                 // for Repaintable
+#include "view/background/BackgroundCache.h"  // for BackgroundCache
 
 #include "Layout.h"            // for Layout
 #include "LegacyRedrawable.h"  // for LegacyRedrawable
@@ -273,6 +274,11 @@ private:
     xoj::view::Mask buffer;
     std::mutex drawingMutex;
 
+    /**
+     * The rasterized background the buffer was rendered on. Protected by drawingMutex.
+     */
+    xoj::view::BackgroundCache::Entry background;
+
     bool inEraser = false;
 
     /**
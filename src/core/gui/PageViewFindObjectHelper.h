@@ -164,6 +164,7 @@ protected:
             size_t ts = s->getTimestamp();
 
             if (auto fn = s->getAudioFilename(); !fn.empty()) {
+                auto const storedFilename = fn;
                 if (!fn.has_parent_path() || fs::weakly_canonical(fn.parent_path()) == "/") {
                     auto const& path = view->settings->getAudioFolder();
                     // Assume path exists
@@ -171,6 +172,9 @@ protected:
                 }
                 auto* ac = view->getXournal()->getControl()->getAudioController();
                 bool success = ac->startPlayback(fn, (unsigned int)ts);
+                if (success) {
+                    view->getXournal()->startAudioReplay(storedFilename, ts);
+                }
                 playbackStatus = {success, std::move(fn)};
                 return success;
             }
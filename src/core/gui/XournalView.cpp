@@ -1,18 +1,24 @@
 #include "XournalView.h"
 
-#include <algorithm>  // for max, min
+#include <algorithm>  // for max, min, minmax
 #include <cmath>      // for lround
 #include <iterator>   // for begin
-#include <memory>     // for unique_ptr, make_unique
+#include <limits>     // for numeric_limits
+#include <memory>     // for unique_ptr, make_unique, weak_ptr
+#include <mutex>      // for lock_guard
 #include <optional>   // for optional
+#include <utility>    // for exchange, pair
+#include <vector>     // for vector
 
 #include <gdk/gdk.h>         // for GdkEventKey, GDK_SHIF...
 #include <gdk/gdkkeysyms.h>  // for GDK_KEY_Page_Down
 #include <glib-object.h>     // for g_object_ref_sink
 
+#include "control/AudioController.h"             // for AudioController
 #include "control/Control.h"                     // for Control
 #include "control/PdfCache.h"                    // for PdfCache
 #include "control/ScrollHandler.h"               // for ScrollHandler
+#include "control/ToolEnums.h"                   // for TOOL_PLAY_OBJECT
 #include "control/ToolHandler.h"                 // for ToolHandler
 #include "control/jobs/XournalScheduler.h"       // for XournalScheduler
 #include "control/settings/MetadataManager.h"    // for MetadataManager
@@ -29,8 +35,12 @@
 #include "gui/toolbarMenubar/ColorToolItem.h"    // for ColorToolItem
 #include "gui/toolbarMenubar/ToolMenuHandler.h"  // for ToolMenuHandler
 #include "gui/widgets/XournalWidget.h"           // for gtk_xournal_get_layout
+#include "model/AudioElement.h"                  // for AudioElement
+#include "model/AudioIndex.h"                    // for AudioIndex
 #include "model/Document.h"                      // for Document
 #include "model/Element.h"                       // for Element, ELEMENT_STROKE
+#include "model/Image.h"                         // for Image
+#include "model/Layer.h"                         // for Layer
 #include "model/PageRef.h"                       // for PageRef
 #include "model/Stroke.h"                        // for Stroke, StrokeTool::E...
 #include "model/XojPage.h"                       // for XojPage
@@ -38,7 +48,9 @@
 #include "undo/UndoRedoHandler.h"                // for UndoRedoHandler
 #include "util/Point.h"                          // for Point
 #include "util/Rectangle.h"                      // for Rectangle
-#include "util/Util.h"                           // for npos
+#include "util/Util.h"                           // for npos, execInUiThread
+#include "view/ImageCache.h"                     // for ImageCache
+#include "view/background/BackgroundCache.h"     // for BackgroundCache
 
 #include "Layout.h"           // for Layout
 #include "PageView.h"         // for XojPageView
@@ -56,7 +68,9 @@ std::pair<size_t, size_t> XournalView::preloadPageBounds(size_t page, size_t max
 }
 
 XournalView::XournalView(GtkWidget* parent, Control* control, ScrollHandling* scrollHandling):
-        scrollHandling(scrollHandling), control(control) {
+        scrollHandling(scrollHandling),
+        control(control),
+        backgroundCache(std::make_unique<xoj::view::BackgroundCache>()) {
     Document* doc = control->getDocument();
     doc->lock();
     if (doc->getPdfPageCount() != 0) {
@@ -86,10 +100,23 @@ XournalView::XournalView(GtkWidget* parent, Control* control, ScrollHandling* sc
     gtk_widget_grab_focus(this->widget);
 
     this->cleanupTimeout = g_timeout_add_seconds(5, reinterpret_cast<GSourceFunc>(clearMemoryTimer), this);
+
+    std::weak_ptr<XournalView*> weakHandle = this->handle;
+    xoj::view::ImageCache::getInstance().setListener([weakHandle](const std::string* data) {
+        Util::execInUiThread([weakHandle, data]() {
+            if (auto handle = weakHandle.lock()) {
+                (*handle)->onImageDecoded(data);
+            }
+        });
+    });
 }
 
 XournalView::~XournalView() {
     g_source_remove(this->cleanupTimeout);
+    if (this->audioReplayTimeout) {
+        g_source_remove(this->audioReplayTimeout);
+    }
+    xoj::view::ImageCache::getInstance().setListener(nullptr);
 
     for (auto&& page: viewPages) {
         delete page;
@@ -112,6 +139,107 @@ auto XournalView::clearMemoryTimer(XournalView* widget) -> gboolean {
     return true;
 }
 
+void XournalView::startAudioReplay(const fs::path& file, size_t timestamp) {
+    std::optional<xoj::view::AudioReplay> previous;
+    {
+        std::lock_guard lock(this->audioReplayMutex);
+        previous = std::exchange(this->audioReplay, xoj::view::AudioReplay{file, timestamp});
+    }
+
+    constexpr size_t END = std::numeric_limits<size_t>::max();
+    if (previous && previous->file == file) {
+        // Only the elements between both positions change
+        auto [from, to] = std::minmax(previous->timestamp, timestamp);
+        rerenderAudioElements(file, from + 1, to + 1);
+    } else {
+        if (previous) {
+            rerenderAudioElements(previous->file, previous->timestamp + 1, END);
+        }
+        rerenderAudioElements(file, timestamp + 1, END);
+    }
+
+    if (!this->audioReplayTimeout) {
+        this->audioReplayTimeout = g_timeout_add(100, reinterpret_cast<GSourceFunc>(updateAudioReplay), this);
+    }
+}
+
+auto XournalView::getAudioReplay() const -> std::optional<xoj::view::AudioReplay> {
+    std::lock_guard lock(this->audioReplayMutex);
+    return this->audioReplay;
+}
+
+auto XournalView::updateAudioReplay(XournalView* view) -> bool {
+    std::optional<xoj::view::AudioReplay> replay = view->getAudioReplay();
+    if (!replay) {
+        view->audioReplayTimeout = 0;
+        return false;
+    }
+
+    Control* control = view->control;
+    if (control->hasAudioController()) {
+        AudioController* ac = control->getAudioController();
+        // Also while paused: the playback may be seeked
+        if (ac->isPlaying() || ac->hasPlayback()) {
+            view->startAudioReplay(replay->file, ac->getPlaybackPosition());
+            return true;
+        }
+    }
+
+    // The playback is over: show all the elements again
+    {
+        std::lock_guard lock(view->audioReplayMutex);
+        view->audioReplay.reset();
+    }
+    view->rerenderAudioElements(replay->file, replay->timestamp + 1, std::numeric_limits<size_t>::max());
+    view->audioReplayTimeout = 0;
+    return false;
+}
+
+void XournalView::rerenderAudioElements(const fs::path& file, size_t from, size_t to) {
+    // The elements are only faded out with the play tool, see RenderJob::initDocumentView()
+    if (from >= to || this->control->getToolHandler()->getToolType() != TOOL_PLAY_OBJECT) {
+        return;
+    }
+
+    std::vector<std::pair<size_t, Rectangle<double>>> rects;
+    Document* doc = this->control->getDocument();
+    doc->lock();
+    auto [begin, end] = doc->getAudioIndex().findBetween(file, from, to);
+    for (auto it = begin; it != end; ++it) {
+        const AudioElement* e = it->element;
+        rects.emplace_back(it->page,
+                           Rectangle<double>(e->getX(), e->getY(), e->getElementWidth(), e->getElementHeight()));
+    }
+    doc->unlock();
+
+    // Not under the document lock: the render jobs take it
+    for (auto&& [page, rect]: rects) {
+        if (page < this->viewPages.size()) {
+            this->viewPages[page]->rerenderRect(rect.x, rect.y, rect.width, rect.height);
+        }
+    }
+}
+
+void XournalView::onImageDecoded(const std::string* data) {
+    // data is only compared: the image may have been deleted in the meantime
+    for (auto&& view: viewPages) {
+        // Also the pages scrolled out of view: their buffer would keep the placeholder until the next zoom change
+        if (!view->hasBuffer()) {
+            continue;
+        }
+        for (Layer* layer: *view->getPage()->getLayers()) {
+            if (!layer->isVisible()) {
+                continue;
+            }
+            for (Element* e: layer->getElements()) {
+                if (e->getType() == ELEMENT_IMAGE && static_cast<Image*>(e)->getSharedData().get() == data) {
+                    view->rerenderElement(e);
+                }
+            }
+        }
+    }
+}
+
 auto XournalView::cleanupBufferCache() -> void {
     const auto& [pagesLower, pagesUpper] = this->preloadPageBounds(this->currentPage, this->viewPages.size());
     g_assert(pagesLower <= pagesUpper);
@@ -566,6 +694,8 @@ auto XournalView::getTextEditor() const -> TextEditor* {
 
 auto XournalView::getCache() const -> PdfCache* { return this->cache.get(); }
 
+auto XournalView::getBackgroundCache() const -> xoj::view::BackgroundCache* { return this->backgroundCache.get(); }
+
 void XournalView::pageInserted(size_t page) {
     Document* doc = control->getDocument();
     doc->lock();
@@ -673,6 +803,24 @@ void XournalView::repaintSelection(bool evenWithoutSelection) {
     gtk_widget_queue_draw(this->widget);
 }
 
+void XournalView::pagesVisibilityChanged(const std::vector<size_t>& shown, const std::vector<size_t>& hidden) {
+    XournalScheduler* scheduler = control->getScheduler();
+    for (size_t page: hidden) {
+        XojPageView* view = viewPages[page];
+        // A page without buffer is rendered as soon as it is drawn again: no need to render the pages scrolled past
+        if (!view->hasBuffer()) {
+            scheduler->cancelRerenderPage(view);
+        }
+    }
+    for (size_t page: shown) {
+        XojPageView* view = viewPages[page];
+        // Start rendering before the page is drawn for the first time
+        if (!view->hasBuffer()) {
+            view->rerenderPage();
+        }
+    }
+}
+
 void XournalView::layoutPages() {
     Layout* layout = gtk_xournal_get_layout(this->widget);
     layout->recalculate();
@@ -730,6 +878,7 @@ void XournalView::documentChanged(DocumentChangeType type) {
     viewPages.clear();
 
     this->cache.reset();
+    this->backgroundCache->clear();
 
     Document* doc = control->getDocument();
     doc->lock();
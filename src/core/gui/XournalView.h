@@ -12,10 +12,12 @@
 #pragma once
 
 #include <cstddef>  // for size_t
-#include <memory>   // for unique_ptr
-#include <string>   // for string
-#include <utility>  // for pair
-#include <vector>   // for vector
+#include <memory>    // for unique_ptr, shared_ptr, make_shared
+#include <mutex>     // for mutex
+#include <optional>  // for optional
+#include <string>    // for string
+#include <utility>   // for pair
+#include <vector>    // for vector
 
 #include <gdk/gdk.h>  // for GdkEventKey, GdkEventExpose
 #include <glib.h>     // for gboolean
@@ -25,6 +27,9 @@
 #include "model/DocumentChangeType.h"   // for DocumentChangeType
 #include "model/DocumentListener.h"     // for DocumentListener
 #include "util/Util.h"                  // for npos
+#include "view/View.h"                  // for AudioReplay
+
+#include "filesystem.h"  // for path
 
 class Control;
 class XournalppCursor;
@@ -40,6 +45,9 @@ namespace xoj::util {
 template <class T>
 class Rectangle;
 }  // namespace xoj::util
+namespace xoj::view {
+class BackgroundCache;
+}  // namespace xoj::view
 
 class XournalView: public DocumentListener, public ZoomListener {
 public:
@@ -50,6 +58,13 @@ public:
     // Recalculate the layout width and height amd layout the pages with the updated layout size
     void layoutPages();
 
+    /**
+     * Called by the Layout when pages were scrolled into or out of view
+     * @param shown The indices of the pages which became visible
+     * @param hidden The indices of the pages which are not visible anymore
+     */
+    void pagesVisibilityChanged(const std::vector<size_t>& shown, const std::vector<size_t>& hidden);
+
     void scrollTo(size_t pageNo, double y = 0);
 
     // Relative navigation in current layout:
@@ -101,6 +116,7 @@ public:
     int getDpiScaleFactor() const;
     Document* getDocument() const;
     PdfCache* getCache() const;
+    xoj::view::BackgroundCache* getBackgroundCache() const;
     RepaintHandler* getRepaintHandler() const;
     GtkWidget* getWidget() const;
     XournalppCursor* getCursor() const;
@@ -124,6 +140,19 @@ public:
      */
     ScrollHandling* getScrollHandling() const;
 
+    /**
+     * Follow the playback of the audio file: the elements written after the playback position are faded out, and shown
+     * again as the playback reaches them
+     * @param file The audio file, as stored in the elements
+     * @param timestamp The position the playback starts at, in milliseconds
+     */
+    void startAudioReplay(const fs::path& file, size_t timestamp);
+
+    /**
+     * @return The audio replay in progress, if any. Thread safe: used by the render jobs
+     */
+    std::optional<xoj::view::AudioReplay> getAudioReplay() const;
+
 public:
     // ZoomListener interface
     void zoomChanged() override;
@@ -152,8 +181,24 @@ private:
 
     static gboolean clearMemoryTimer(XournalView* widget);
 
+    /**
+     * Rerenders the elements the playback went past since the last call, see startAudioReplay()
+     */
+    static bool updateAudioReplay(XournalView* view);
+
+    /**
+     * Rerenders the elements of the audio file written in [from, to), on the pages visible with the play tool
+     */
+    void rerenderAudioElements(const fs::path& file, size_t from, size_t to);
+
     void cleanupBufferCache();
 
+    /**
+     * Rerenders the images using the given data on the pages with a buffer, once decoded in the background by the
+     * ImageCache
+     */
+    void onImageDecoded(const std::string* data);
+
 private:
     /**
      * Scrollbars
@@ -172,6 +217,11 @@ private:
 
     std::unique_ptr<PdfCache> cache;
 
+    /**
+     * Rasterized page backgrounds, shared between pages with identical rulings
+     */
+    std::unique_ptr<xoj::view::BackgroundCache> backgroundCache;
+
     /**
      * Handler for rerendering pages / repainting pages
      */
@@ -182,10 +232,22 @@ private:
      */
     int cleanupTimeout = -1;
 
+    /**
+     * The audio replay in progress and its timer, see startAudioReplay()
+     */
+    std::optional<xoj::view::AudioReplay> audioReplay;
+    mutable std::mutex audioReplayMutex;
+    guint audioReplayTimeout = 0;
+
     /**
      * Helper class for Touch specific fixes
      */
     HandRecognition* handRecognition = nullptr;
 
+    /**
+     * Only held weakly by the callbacks queued for the UI thread: the view may be deleted before they run
+     */
+    std::shared_ptr<XournalView*> handle = std::make_shared<XournalView*>(this);
+
     friend class Layout;
 };
@@ -72,6 +72,14 @@ SettingsDialog::SettingsDialog(GladeSearchpath* gladeSearchPath, Settings* setti
                      this);
 
 
+    g_signal_connect(get("notebook1"), "switch-page",
+                     G_CALLBACK(+[](GtkNotebook* notebook, GtkWidget* page, guint pageNum, SettingsDialog* self) {
+                         if (gtk_widget_is_ancestor(self->get("cbAudioInputDevice"), page)) {
+                             self->loadAudioDevices();
+                         }
+                     }),
+                     this);
+
     g_signal_connect(get("btTestEnable"), "clicked", G_CALLBACK(+[](GtkButton* bt, SettingsDialog* self) {
                          Util::systemWithMessage(gtk_entry_get_text(GTK_ENTRY(self->get("txtEnableTouchCommand"))));
                      }),
@@ -339,6 +347,42 @@ void SettingsDialog::showStabilizerPreprocessorOptions(StrokeStabilizer::Preproc
     gtk_widget_set_sensitive(get("cbStabilizerEnableFinalizeStroke"), sensitive);
 }
 
+void SettingsDialog::loadAudioDevices() {
+    if (this->audioDevicesLoaded) {
+        return;
+    }
+    this->audioDevicesLoaded = true;
+
+    // Look for the devices plugged in since the last query
+    this->control->getAudioController()->invalidateDevices();
+
+    this->audioInputDevices = this->control->getAudioController()->getInputDevices();
+    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioInputDevice")), "", "System default");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioInputDevice")), 0);
+    for (auto& audioInputDevice: this->audioInputDevices) {
+        gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioInputDevice")), "",
+                                  audioInputDevice.getDeviceName().c_str());
+    }
+    for (size_t i = 0; i < this->audioInputDevices.size(); i++) {
+        if (this->audioInputDevices[i].getSelected()) {
+            gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioInputDevice")), static_cast<gint>(i + 1));
+        }
+    }
+
+    this->audioOutputDevices = this->control->getAudioController()->getOutputDevices();
+    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioOutputDevice")), "", "System default");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioOutputDevice")), 0);
+    for (auto& audioOutputDevice: this->audioOutputDevices) {
+        gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioOutputDevice")), "",
+                                  audioOutputDevice.getDeviceName().c_str());
+    }
+    for (size_t i = 0; i < this->audioOutputDevices.size(); i++) {
+        if (this->audioOutputDevices[i].getSelected()) {
+            gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioOutputDevice")), static_cast<gint>(i + 1));
+        }
+    }
+}
+
 void SettingsDialog::load() {
     loadCheckbox("cbSettingPresureSensitivity", settings->isPressureSensitivity());
     loadCheckbox("cbEnableZoomGestures", settings->isZoomGesturesEnabled());
@@ -347,6 +391,7 @@ void SettingsDialog::load() {
     loadCheckbox("cbAutoloadMostRecent", settings->isAutoloadMostRecent());
     loadCheckbox("cbAutoloadXoj", settings->isAutoloadPdfXoj());
     loadCheckbox("cbAutosave", settings->isAutosaveEnabled());
+    loadCheckbox("cbSaveUncompressed", settings->isSaveUncompressed());
     loadCheckbox("cbAddVerticalSpace", settings->getAddVerticalSpace());
     loadCheckbox("cbAddHorizontalSpace", settings->getAddHorizontalSpace());
     loadCheckbox("cbDrawDirModsEnabled", settings->getDrawDirModsEnabled());
@@ -602,31 +647,7 @@ void SettingsDialog::load() {
     touch.getInt("timeout", timeoutMs);
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(get("spTouchDisableTimeout")), timeoutMs / 1000.0);
 
-    this->audioInputDevices = this->control->getAudioController()->getInputDevices();
-    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioInputDevice")), "", "System default");
-    gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioInputDevice")), 0);
-    for (auto& audioInputDevice: this->audioInputDevices) {
-        gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioInputDevice")), "",
-                                  audioInputDevice.getDeviceName().c_str());
-    }
-    for (size_t i = 0; i < this->audioInputDevices.size(); i++) {
-        if (this->audioInputDevices[i].getSelected()) {
-            gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioInputDevice")), static_cast<gint>(i + 1));
-        }
-    }
-
-    this->audioOutputDevices = this->control->getAudioController()->getOutputDevices();
-    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioOutputDevice")), "", "System default");
-    gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioOutputDevice")), 0);
-    for (auto& audioOutputDevice: this->audioOutputDevices) {
-        gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(get("cbAudioOutputDevice")), "",
-                                  audioOutputDevice.getDeviceName().c_str());
-    }
-    for (size_t i = 0; i < this->audioOutputDevices.size(); i++) {
-        if (this->audioOutputDevices[i].getSelected()) {
-            gtk_combo_box_set_active(GTK_COMBO_BOX(get("cbAudioOutputDevice")), static_cast<gint>(i + 1));
-        }
-    }
+    // The audio devices are only enumerated once the audio tab is shown, see loadAudioDevices()
 
     switch (static_cast<int>(settings->getAudioSampleRate())) {
         case 16000:
@@ -662,6 +683,10 @@ void SettingsDialog::save() {
     settings->setAutoloadMostRecent(getCheckbox("cbAutoloadMostRecent"));
     settings->setAutoloadPdfXoj(getCheckbox("cbAutoloadXoj"));
     settings->setAutosaveEnabled(getCheckbox("cbAutosave"));
+    // The checkbox shows the value of this session, which may come from the command line: only store it if changed
+    if (bool uncompressed = getCheckbox("cbSaveUncompressed"); uncompressed != settings->isSaveUncompressed()) {
+        settings->setSaveUncompressed(uncompressed);
+    }
     settings->setAddVerticalSpace(getCheckbox("cbAddVerticalSpace"));
     settings->setAddHorizontalSpace(getCheckbox("cbAddHorizontalSpace"));
     settings->setDrawDirModsEnabled(getCheckbox("cbDrawDirModsEnabled"));
@@ -69,6 +69,12 @@ private:
     void loadSlider(const char* name, double value);
     double getSlider(const char* name);
 
+    /**
+     * Fill the audio device lists, the first time the audio tab is shown. Probing the devices may take a while, and
+     * brings up PortAudio.
+     */
+    void loadAudioDevices();
+
     void initMouseButtonEvents();
     void initMouseButtonEvents(const char* hbox, int button, bool withDevice = false);
 
@@ -84,6 +90,7 @@ private:
     int dpi = 72;
     std::vector<DeviceInfo> audioInputDevices;
     std::vector<DeviceInfo> audioOutputDevices;
+    bool audioDevicesLoaded = false;
 
     std::unique_ptr<LanguageConfigGui> languageConfig;
     std::vector<std::unique_ptr<ButtonConfigGui>> buttonConfigs;
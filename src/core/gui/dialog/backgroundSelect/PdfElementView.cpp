@@ -7,6 +7,8 @@
 
 #include "gui/dialog/backgroundSelect/BaseElementView.h"  // for BaseElement...
 #include "pdf/base/XojPdfPage.h"                          // for XojPdfPageSPtr
+#include "util/Util.h"                                    // for execInUiThread
+#include "view/ThumbnailCache.h"                          // for ThumbnailCache
 
 #include "PdfPagesDialog.h"  // for PdfPagesDialog
 
@@ -23,9 +25,33 @@ void PdfElementView::setUsed(bool used) { this->used = used; }
 void PdfElementView::setHideUnused() { gtk_widget_set_visible(getWidget(), !isUsed()); }
 
 void PdfElementView::paintContents(cairo_t* cr) {
-    double zoom = PdfPagesDialog::getZoom();
-    cairo_scale(cr, zoom, zoom);
-    page->render(cr);
+    // Rendering the PDF page here would freeze the dialog while scrolling: the thumbnail is rendered in the background
+    const double zoom = PdfPagesDialog::getZoom();
+    XojPdfPage* pdfPage = this->page.get();
+    auto onReady = [handle = std::weak_ptr(this->handle)]() {
+        Util::execInUiThread([handle]() {
+            if (auto view = handle.lock()) {
+                (*view)->repaint();
+            }
+        });
+    };
+    auto thumbnail = xoj::view::ThumbnailCache::getInstance().get(
+            this->page, 0, pdfPage->getWidth(), pdfPage->getHeight(), pdfPage->getWidth() * zoom,
+            [pdfPage](cairo_t* cr) { pdfPage->render(cr); }, false, std::move(onReady));
+
+    if (!thumbnail) {
+        // Placeholder, until the thumbnail is ready
+        cairo_set_source_rgb(cr, 0.9, 0.9, 0.9);
+        cairo_rectangle(cr, 0, 0, getContentWidth(), getContentHeight());
+        cairo_fill(cr);
+        return;
+    }
+
+    const double scale = pdfPage->getWidth() * zoom / cairo_image_surface_get_width(thumbnail.get());
+    cairo_scale(cr, scale, scale);
+    cairo_set_source_surface(cr, thumbnail.get(), 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+    cairo_paint(cr);
 }
 
 auto PdfElementView::getContentWidth() -> int { return page->getWidth() * PdfPagesDialog::getZoom(); }
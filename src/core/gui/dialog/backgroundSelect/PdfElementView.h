@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <memory>  // for shared_ptr
+
 #include <cairo.h>  // for cairo_t
 
 #include "pdf/base/XojPdfPage.h"  // for XojPdfPageSPtr
@@ -48,6 +50,11 @@ public:
 private:
     XojPdfPageSPtr page;
 
+    /**
+     * Weakly referenced by the thumbnail requests, which may complete after this view is deleted
+     */
+    std::shared_ptr<PdfElementView*> handle = std::make_shared<PdfElementView*>(this);
+
     /**
      * This page is already used as background
      */
@@ -1,6 +1,7 @@
 #include "SidebarIndexPage.h"
 
-#include <cstring>  // for strlen
+#include <cstring>   // for strlen
+#include <optional>  // for optional
 
 #include <glib-object.h>  // for g_object_unref
 #include <pango/pango.h>  // for PangoLogAttr
@@ -9,6 +10,7 @@
 #include "control/ScrollHandler.h"                     // for ScrollHandler
 #include "gui/sidebar/previews/base/SidebarToolbar.h"  // for SidebarToolbar
 #include "model/Document.h"                            // for Document
+#include "model/DocumentOutline.h"                     // for DocumentOutline
 #include "model/LinkDestination.h"                     // for XojLinkDest
 #include "util/i18n.h"                                 // for _
 
@@ -54,6 +56,8 @@ SidebarIndexPage::SidebarIndexPage(Control* control, SidebarToolbar* toolbar):
     this->selectHandler = g_signal_connect(treeViewBookmarks, "cursor-changed", G_CALLBACK(treeBookmarkSelected), this);
     g_assert(this->selectHandler != 0);
 
+    g_signal_connect(treeViewBookmarks, "test-expand-row", G_CALLBACK(treeTestExpandRow), this);
+
     gtk_widget_show(this->treeViewBookmarks);
 
     registerListener(control);
@@ -64,6 +68,10 @@ SidebarIndexPage::~SidebarIndexPage() {
         g_source_remove(this->searchTimeout);
         this->searchTimeout = 0;
     }
+    if (this->pageNumbersUpdateId) {
+        g_source_remove(this->pageNumbersUpdateId);
+        this->pageNumbersUpdateId = 0;
+    }
 
     g_object_unref(this->treeViewBookmarks);
     g_object_unref(this->scrollBookmarks);
@@ -105,6 +113,28 @@ auto SidebarIndexPage::treeBookmarkSelected(GtkWidget* treeview, SidebarIndexPag
     return false;
 }
 
+auto SidebarIndexPage::treeTestExpandRow(GtkTreeView* treeview, GtkTreeIter* iter, GtkTreePath* path,
+                                         SidebarIndexPage* sidebar) -> gboolean {
+    Document* doc = sidebar->control->getDocument();
+    doc->lock();
+    doc->expandContentsModel(iter);
+    doc->unlock();
+
+    // Allow the expansion
+    return false;
+}
+
+auto SidebarIndexPage::updatePageNumbers(SidebarIndexPage* sidebar) -> bool {
+    sidebar->pageNumbersUpdateId = 0;
+
+    Document* doc = sidebar->control->getDocument();
+    doc->lock();
+    doc->updateContentsPageNumbers();
+    doc->unlock();
+
+    return false;
+}
+
 auto SidebarIndexPage::searchTimeoutFunc(SidebarIndexPage* sidebar) -> bool {
     sidebar->searchTimeout = 0;
 
@@ -174,111 +204,78 @@ auto SidebarIndexPage::hasData() -> bool { return this->hasContents; }
 
 auto SidebarIndexPage::getWidget() -> GtkWidget* { return this->scrollBookmarks; }
 
-auto SidebarIndexPage::expandOpenLinks(GtkTreeModel* model, GtkTreeIter* parent) -> int {
+void SidebarIndexPage::expandOpenLinks(GtkTreeModel* model, GtkTreeIter* parent) {
     GtkTreeIter iter = {0};
-    XojLinkDest* link = nullptr;
-    if (model == nullptr) {
-        return 0;
-    }
-
-    int count = 0;
-
-    if (gtk_tree_model_iter_children(model, &iter, parent)) {
-        do {
-            gtk_tree_model_get(model, &iter, DOCUMENT_LINKS_COLUMN_LINK, &link, -1);
-
-            if (link->dest->getExpand()) {
-                GtkTreePath* path = gtk_tree_model_get_path(model, &iter);
-                gtk_tree_view_expand_row(GTK_TREE_VIEW(treeViewBookmarks), path, false);
-                gtk_tree_path_free(path);
-            }
-
-            g_object_unref(link);
-
-            count++;
-
-            count += expandOpenLinks(model, &iter);
-        } while (gtk_tree_model_iter_next(model, &iter));
+    if (model == nullptr || !gtk_tree_model_iter_children(model, &iter, parent)) {
+        return;
     }
 
-    return count;
-}
-
-void SidebarIndexPage::selectPageNr(size_t page, size_t pdfPage) { selectPageNr(page, pdfPage, nullptr); }
-
-auto SidebarIndexPage::selectPageNr(size_t page, size_t pdfPage, GtkTreeIter* parent) -> bool {
-    GtkTreeIter iter;
-
-    Document* doc = control->getDocument();
-    doc->lock();
-    GtkTreeModel* model = doc->getContentsModel();
-    if (model == nullptr) {
-        doc->unlock();
-        return false;
-    }
-
-    g_object_ref(model);
-    doc->unlock();
-
-    if (parent == nullptr) {
-
-        // check if there is already the current page selected
-        GtkTreeSelection* selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(treeViewBookmarks));
-
-        if (gtk_tree_selection_get_selected(selection, &model, &iter)) {
-            XojLinkDest* link = nullptr;
-
-            gtk_tree_model_get(model, &iter, DOCUMENT_LINKS_COLUMN_LINK, &link, -1);
-
-            if (link && link->dest) {
-                LinkDestination* dest = link->dest;
-
-                if (dest->getPdfPage() == pdfPage) {
-
-                    g_object_unref(model);
-                    g_object_unref(link);
+    do {
+        XojLinkDest* link = nullptr;
+        gtk_tree_model_get(model, &iter, DOCUMENT_LINKS_COLUMN_LINK, &link, -1);
+        if (link == nullptr) {
+            // Placeholder of a collapsed row
+            continue;
+        }
+        bool expand = link->dest->getExpand();
+        g_object_unref(link);
 
-                    // already a bookmark from this page selected
-                    return true;
-                }
-            }
+        if (expand) {
+            // Fills in the children, see treeTestExpandRow()
+            GtkTreePath* path = gtk_tree_model_get_path(model, &iter);
+            gtk_tree_view_expand_row(GTK_TREE_VIEW(treeViewBookmarks), path, false);
+            gtk_tree_path_free(path);
 
-            g_object_unref(link);
+            expandOpenLinks(model, &iter);
         }
-    }
+    } while (gtk_tree_model_iter_next(model, &iter));
+}
 
-    gboolean valid = gtk_tree_model_iter_children(model, &iter, parent);
+void SidebarIndexPage::selectPageNr(size_t page, size_t pdfPage) {
+    GtkTreeSelection* selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(treeViewBookmarks));
+    GtkTreeModel* model = nullptr;
+    GtkTreeIter iter = {0};
 
-    while (valid) {
+    // check if there is already the current page selected
+    if (gtk_tree_selection_get_selected(selection, &model, &iter)) {
         XojLinkDest* link = nullptr;
-
         gtk_tree_model_get(model, &iter, DOCUMENT_LINKS_COLUMN_LINK, &link, -1);
 
-        if (link->dest->getPdfPage() == pdfPage) {
-            GtkTreeSelection* selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(treeViewBookmarks));
-            gtk_tree_selection_select_iter(selection, &iter);
-
+        bool selected = link && link->dest && link->dest->getPdfPage() == pdfPage;
+        if (link) {
             g_object_unref(link);
-            g_object_unref(model);
-            return true;
         }
-
-
-        g_object_unref(link);
-
-        if (selectPageNr(page, pdfPage, &iter)) {
-            g_object_unref(model);
-            return true;
+        if (selected) {
+            // already a bookmark from this page selected
+            return;
         }
+    }
 
+    // Search the outline rather than the model: the collapsed entries are not in the model
+    Document* doc = control->getDocument();
+    doc->lock();
+    auto outline = doc->getOutline();
+    std::optional<DocumentOutline::Path> path = outline ? outline->findPdfPage(pdfPage) : std::nullopt;
+    bool found = path && doc->getContentsIter(*path, &iter);
+    doc->unlock();
 
-        valid = gtk_tree_model_iter_next(model, &iter);
+    if (found) {
+        gtk_tree_selection_select_iter(selection, &iter);
     }
+}
 
-    g_object_unref(model);
-    return false;
+void SidebarIndexPage::schedulePageNumbersUpdate() {
+    // The page numbers of the entries may have changed. The listeners are notified before a page is deleted, and
+    // several pages may be inserted in a row: update the numbers once, after that.
+    if (this->pageNumbersUpdateId == 0) {
+        this->pageNumbersUpdateId = g_idle_add(reinterpret_cast<GSourceFunc>(updatePageNumbers), this);
+    }
 }
 
+void SidebarIndexPage::pageInserted(size_t page) { schedulePageNumbersUpdate(); }
+
+void SidebarIndexPage::pageDeleted(size_t page) { schedulePageNumbersUpdate(); }
+
 void SidebarIndexPage::documentChanged(DocumentChangeType type) {
     if (type == DOCUMENT_CHANGE_CLEARED) {
         gtk_tree_view_set_model(GTK_TREE_VIEW(this->treeViewBookmarks), nullptr);
@@ -289,15 +286,25 @@ void SidebarIndexPage::documentChanged(DocumentChangeType type) {
         //  Block the cursor-change signal when the document changes, otherwise
         //  there will be a deadlock: both the selectHandler and this code will
         //  lock the document.
+        //  The document is not locked while the tree view is updated: expanding the rows locks it.
         g_signal_handler_block(this->treeViewBookmarks, this->selectHandler);
         doc->lock();
         GtkTreeModel* model = doc->getContentsModel();
-        gtk_tree_view_set_model(GTK_TREE_VIEW(this->treeViewBookmarks), model);
-        int count = expandOpenLinks(model, nullptr);
+        if (model) {
+            g_object_ref(model);
+        }
+        // The pages may have been replaced along with the outline
+        doc->updateContentsPageNumbers();
         doc->unlock();
+
+        gtk_tree_view_set_model(GTK_TREE_VIEW(this->treeViewBookmarks), model);
+        expandOpenLinks(model, nullptr);
         g_signal_handler_unblock(this->treeViewBookmarks, this->selectHandler);
         this->treeBookmarkSelected(this->treeViewBookmarks, this);
 
-        hasContents = (count != 0);
+        hasContents = model != nullptr;
+        if (model) {
+            g_object_unref(model);
+        }
     }
 }
@@ -14,8 +14,8 @@
 #include <cstddef>  // for size_t
 #include <string>   // for string
 
-#include <glib.h>     // for gboolean, gchar, gint
-#include <gtk/gtk.h>  // for GtkWidget, GtkTreeIter
+#include <glib.h>     // for gboolean, gchar, gint, guint
+#include <gtk/gtk.h>  // for GtkWidget, GtkTreeIter, GtkTreeView
 
 #include "gui/IconNameHelper.h"               // for IconNameHelper
 #include "gui/sidebar/AbstractSidebarPage.h"  // for AbstractSidebarPage
@@ -59,14 +59,19 @@ public:
     void selectPageNr(size_t page, size_t pdfPage) override;
 
     /**
-     * Select page in the tree
+     * @overwrite
      */
-    bool selectPageNr(size_t page, size_t pdfPage, GtkTreeIter* parent);
+    void documentChanged(DocumentChangeType type) override;
 
     /**
      * @overwrite
      */
-    void documentChanged(DocumentChangeType type) override;
+    void pageInserted(size_t page) override;
+
+    /**
+     * @overwrite
+     */
+    void pageDeleted(size_t page) override;
 
 private:
     /**
@@ -80,6 +85,17 @@ private:
      */
     static bool treeBookmarkSelected(GtkWidget* treeview, SidebarIndexPage* sidebar);
 
+    /**
+     * A row is about to be expanded: its children are added to the model
+     */
+    static gboolean treeTestExpandRow(GtkTreeView* treeview, GtkTreeIter* iter, GtkTreePath* path,
+                                      SidebarIndexPage* sidebar);
+
+    /**
+     * Resolves the page numbers of the rows again, see schedulePageNumbersUpdate()
+     */
+    static bool updatePageNumbers(SidebarIndexPage* sidebar);
+
     /**
      * The function which is called after a search timeout
      */
@@ -87,9 +103,14 @@ private:
 
 private:
     /**
-     * Expand links
+     * Expand the rows of the open entries
      */
-    int expandOpenLinks(GtkTreeModel* model, GtkTreeIter* parent);
+    void expandOpenLinks(GtkTreeModel* model, GtkTreeIter* parent);
+
+    /**
+     * Update the page numbers of the rows once the pages were inserted or deleted
+     */
+    void schedulePageNumbersUpdate();
 
 private:
     /**
@@ -115,6 +136,11 @@ private:
      */
     int searchTimeout = 0;
 
+    /**
+     * The pending update of the page numbers, see schedulePageNumbersUpdate()
+     */
+    guint pageNumbersUpdateId = 0;
+
     /**
      * If there is something to display in the tree
      */
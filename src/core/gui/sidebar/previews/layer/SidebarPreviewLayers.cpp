@@ -1,6 +1,6 @@
 #include "SidebarPreviewLayers.h"
 
-#include <algorithm>  // for max
+#include <algorithm>  // for max, binary_search
 #include <vector>     // for vector
 
 #include <gtk/gtk.h>  // for gtk...
@@ -99,6 +99,12 @@ void SidebarPreviewLayers::pageChanged(size_t page) {
     for (auto& p: this->previews) { p->repaint(); }
 }
 
+void SidebarPreviewLayers::pagesChanged(const std::vector<size_t>& pages) {
+    if (std::binary_search(pages.begin(), pages.end(), this->lc->getCurrentPageId())) {
+        pageChanged(this->lc->getCurrentPageId());
+    }
+}
+
 void SidebarPreviewLayers::updatePreviews() {
     if (!enabled) {
         return;
@@ -14,6 +14,7 @@
 #include <cstddef>  // for size_t
 #include <memory>   // for shared_ptr
 #include <string>   // for string
+#include <vector>   // for vector
 
 #include "control/layer/LayerCtrlListener.h"               // for LayerCtrlL...
 #include "gui/IconNameHelper.h"                            // for IconNameHe...
@@ -85,6 +86,7 @@ public:
     // DocumentListener interface (only the part which is not handled by SidebarPreviewBase)
     void pageSizeChanged(size_t page) override;
     void pageChanged(size_t page) override;
+    void pagesChanged(const std::vector<size_t>& pages) override;
 
 private:
     /**
@@ -0,0 +1,95 @@
+#include "AudioIndex.h"
+
+#include <algorithm>  // for stable_sort, upper_bound, lower_bound, max
+#include <iterator>   // for prev
+
+#include "model/AudioElement.h"  // for AudioElement
+#include "model/Element.h"       // for Element, ELEMENT_STROKE, ELEMENT_TEXT
+#include "model/Layer.h"         // for Layer
+#include "model/XojPage.h"       // for XojPage
+
+namespace {
+const AudioIndex::Entries NO_ENTRIES;
+
+auto timestampBefore(size_t timestamp, const AudioIndex::Entry& e) -> bool { return timestamp < e.timestamp; }
+auto entryBefore(const AudioIndex::Entry& e, size_t timestamp) -> bool { return e.timestamp < timestamp; }
+}  // namespace
+
+void AudioIndex::update(const std::vector<PageRef>& pages) {
+    bool changed = pages.size() != this->pages.size();
+    this->pages.resize(pages.size());
+
+    for (size_t i = 0; i < pages.size(); i++) {
+        PageEntries& entries = this->pages[i];
+        const uint64_t revision = pages[i]->getRevision();
+        if (entries.page == pages[i].get() && entries.revision == revision) {
+            continue;
+        }
+
+        changed = true;
+        entries.page = pages[i].get();
+        entries.revision = revision;
+        entries.elements.clear();
+        for (const Layer* layer: *pages[i]->getLayers()) {
+            for (const Element* e: layer->getElements()) {
+                if (e->getType() != ELEMENT_STROKE && e->getType() != ELEMENT_TEXT) {
+                    continue;
+                }
+                const auto* audioElement = static_cast<const AudioElement*>(e);
+                if (!audioElement->getAudioFilename().empty()) {
+                    entries.elements.push_back(audioElement);
+                }
+            }
+        }
+    }
+
+    if (!changed) {
+        return;
+    }
+
+    // The page positions may have changed as well: rebuild the entries of all the files
+    this->files.clear();
+    for (size_t i = 0; i < this->pages.size(); i++) {
+        for (const AudioElement* e: this->pages[i].elements) {
+            this->files[e->getAudioFilename()].push_back({e->getTimestamp(), i, e});
+        }
+    }
+    for (auto& [file, entries]: this->files) {
+        // Stable: the elements with the same timestamp stay in document order
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const Entry& a, const Entry& b) { return a.timestamp < b.timestamp; });
+    }
+}
+
+auto AudioIndex::getAudioFiles() const -> std::vector<fs::path> {
+    std::vector<fs::path> audioFiles;
+    audioFiles.reserve(this->files.size());
+    for (const auto& [file, entries]: this->files) {
+        audioFiles.push_back(file);
+    }
+    return audioFiles;
+}
+
+auto AudioIndex::getEntries(const fs::path& audioFile) const -> const Entries& {
+    auto it = this->files.find(audioFile);
+    return it == this->files.end() ? NO_ENTRIES : it->second;
+}
+
+auto AudioIndex::findAt(const fs::path& audioFile, size_t timestamp) const -> const Entry* {
+    const Entries& entries = getEntries(audioFile);
+    auto it = std::upper_bound(entries.begin(), entries.end(), timestamp, timestampBefore);
+    return it == entries.begin() ? nullptr : &*std::prev(it);
+}
+
+auto AudioIndex::findAfter(const fs::path& audioFile, size_t timestamp) const -> const Entry* {
+    const Entries& entries = getEntries(audioFile);
+    auto it = std::upper_bound(entries.begin(), entries.end(), timestamp, timestampBefore);
+    return it == entries.end() ? nullptr : &*it;
+}
+
+auto AudioIndex::findBetween(const fs::path& audioFile, size_t from, size_t to) const -> Range {
+    const Entries& entries = getEntries(audioFile);
+    auto begin = std::lower_bound(entries.begin(), entries.end(), from, entryBefore);
+    auto end = std::lower_bound(begin, entries.end(), std::max(from, to), entryBefore);
+    return {begin, end};
+}
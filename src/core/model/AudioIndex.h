@@ -0,0 +1,83 @@
+/*
+ * Xournal++
+ *
+ * Index of the elements linked to an audio recording
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <map>      // for map
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "PageRef.h"     // for PageRef
+#include "filesystem.h"  // for path
+
+class AudioElement;
+class XojPage;
+
+/**
+ * @brief Maps the audio recordings of a document to the elements written during the recording, ordered by timestamp
+ *
+ * The index is updated by update(): only the pages whose revision changed are scanned again. The entries are only
+ * valid until the document is modified, i.e. as long as the document lock is held.
+ */
+class AudioIndex {
+public:
+    struct Entry {
+        /// The timestamp of the element in the recording, in milliseconds
+        size_t timestamp;
+        /// The position of the element's page in the document
+        size_t page;
+        const AudioElement* element;
+    };
+    using Entries = std::vector<Entry>;
+    using Range = std::pair<Entries::const_iterator, Entries::const_iterator>;
+
+    /**
+     * @brief Bring the index up to date with the pages of the document
+     */
+    void update(const std::vector<PageRef>& pages);
+
+    /**
+     * @return The audio files referenced in the document
+     */
+    std::vector<fs::path> getAudioFiles() const;
+
+    /**
+     * @return The elements of the audio file, sorted by timestamp
+     */
+    const Entries& getEntries(const fs::path& audioFile) const;
+
+    /**
+     * @return The last element written at or before the timestamp, or nullptr
+     */
+    const Entry* findAt(const fs::path& audioFile, size_t timestamp) const;
+
+    /**
+     * @return The first element written after the timestamp, or nullptr
+     */
+    const Entry* findAfter(const fs::path& audioFile, size_t timestamp) const;
+
+    /**
+     * @return The elements written in [from, to)
+     */
+    Range findBetween(const fs::path& audioFile, size_t from, size_t to) const;
+
+private:
+    struct PageEntries {
+        const XojPage* page = nullptr;
+        uint64_t revision = 0;
+        std::vector<const AudioElement*> elements;
+    };
+
+    std::vector<PageEntries> pages;
+    std::map<fs::path, Entries> files;
+};
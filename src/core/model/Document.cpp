@@ -1,22 +1,21 @@
 #include "Document.h"
 
-#include <string>   // for string
-#include <ctime>    // for size_t, localtime, strf...
-#include <utility>  // for move, pair
+#include <string>         // for string, to_string
+#include <ctime>          // for size_t, localtime, strf...
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for move, pair
 
 #include <glib-object.h>  // for g_object_unref, G_TYPE_...
 
-#include "model/DocumentChangeType.h"         // for DOCUMENT_CHANGE_CLEARED
-#include "model/DocumentHandler.h"            // for DocumentHandler
-#include "model/PageRef.h"                    // for PageRef
-#include "model/PageType.h"                   // for PageType
-#include "pdf/base/XojPdfAction.h"            // for XojPdfAction
-#include "pdf/base/XojPdfBookmarkIterator.h"  // for XojPdfBookmarkIterator
-#include "util/PathUtil.h"                    // for clearExtensions
-#include "util/PlaceholderString.h"           // for PlaceholderString
-#include "util/SaveNameUtils.h"               // for parseFilename
-#include "util/Util.h"                        // for npos
-#include "util/i18n.h"                        // for FS, _F
+#include "model/DocumentChangeType.h"  // for DOCUMENT_CHANGE_CLEARED
+#include "model/DocumentHandler.h"     // for DocumentHandler
+#include "model/PageRef.h"             // for PageRef
+#include "model/PageType.h"            // for PageType
+#include "util/PathUtil.h"             // for clearExtensions
+#include "util/PlaceholderString.h"    // for PlaceholderString
+#include "util/SaveNameUtils.h"        // for parseFilename
+#include "util/Util.h"                 // for npos, execInUiThread
+#include "util/i18n.h"                 // for FS, _F
 
 #include "LinkDestination.h"  // for XojLinkDest, DOCUMENT_L...
 #include "XojPage.h"          // for XojPage
@@ -25,6 +24,7 @@
 Document::Document(DocumentHandler* handler): handler(handler) {}
 
 Document::~Document() {
+    this->outlineHandle.reset();
     clearDocument(true);
     freeTreeContentModel();
 }
@@ -99,6 +99,10 @@ void Document::clearDocument(bool destroy) {
 
     this->pages.clear();
     this->pageIndex.reset();
+    this->pagePositions.reset();
+    this->pageSnapshots.clear();
+    stopReadingOutline();
+    this->outline.reset();
     freeTreeContentModel();
 
     this->filepath = fs::path{};
@@ -162,6 +166,53 @@ auto Document::createSaveFilename(DocumentType type, const std::string& defaultS
 }
 
 
+auto Document::getPageSnapshot(const PageRef& page) -> PageRef {
+    uint64_t revision = page->getRevision();
+    auto& [snapshotRevision, weakSnapshot] = this->pageSnapshots[page.get()];
+    PageRef snapshot = weakSnapshot.lock();
+    if (!snapshot || snapshotRevision != revision) {
+        snapshot.reset(page->clone());
+        weakSnapshot = snapshot;
+        snapshotRevision = revision;
+    }
+    return snapshot;
+}
+
+auto Document::createSnapshot() -> std::unique_ptr<Document> {
+    // Nobody listens to the snapshots
+    static DocumentHandler snapshotHandler;
+
+    auto snapshot = std::make_unique<Document>(&snapshotHandler);
+    snapshot->pdfDocument = this->pdfDocument;
+    snapshot->password = this->password;
+    snapshot->createBackupOnSave = this->createBackupOnSave;
+    snapshot->pdfFilepath = this->pdfFilepath;
+    snapshot->filepath = this->filepath;
+    snapshot->attachPdf = this->attachPdf;
+    snapshot->setPreview(this->preview);
+
+    snapshot->pages.reserve(this->pages.size());
+    std::unordered_set<const XojPage*> livePages;
+    for (const PageRef& p: this->pages) {
+        snapshot->pages.emplace_back(getPageSnapshot(p));
+        livePages.insert(p.get());
+    }
+
+    // Forget the copies of deleted pages
+    for (auto it = this->pageSnapshots.begin(); it != this->pageSnapshots.end();) {
+        if (livePages.count(it->first) == 0) {
+            it = this->pageSnapshots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Nobody displays the contents of a snapshot: the outline is enough
+    snapshot->outline = this->outline;
+    snapshot->indexPdfPages();
+    return snapshot;
+}
+
 auto Document::getPreview() const -> cairo_surface_t* { return this->preview; }
 
 void Document::setPreview(cairo_surface_t* preview) {
@@ -199,43 +250,6 @@ auto Document::findPdfPage(size_t pdfPage) -> size_t {
     }
 }
 
-void Document::buildTreeContentsModel(GtkTreeIter* parent, XojPdfBookmarkIterator* iter) {
-    do {
-        GtkTreeIter treeIter = {0};
-
-        XojPdfAction* action = iter->getAction();
-        LinkDestination* dest = new LinkDestination(*action->getDestination());
-        XojLinkDest* link = link_dest_new();
-        link->dest = dest;
-
-        if (action->getTitle().empty()) {
-            g_object_unref(link);
-            delete action;
-            continue;
-        }
-
-        link->dest->setExpand(iter->isOpen());
-
-        gtk_tree_store_append(GTK_TREE_STORE(contentsModel), &treeIter, parent);
-        char* titleMarkup = g_markup_escape_text(action->getTitle().c_str(), -1);
-
-        gtk_tree_store_set(GTK_TREE_STORE(contentsModel), &treeIter, DOCUMENT_LINKS_COLUMN_NAME, titleMarkup,
-                           DOCUMENT_LINKS_COLUMN_LINK, link, DOCUMENT_LINKS_COLUMN_PAGE_NUMBER, "", -1);
-
-        g_free(titleMarkup);
-        g_object_unref(link);
-
-        XojPdfBookmarkIterator* child = iter->getChildIter();
-        if (child) {
-            buildTreeContentsModel(&treeIter, child);
-            delete child;
-        }
-
-        delete action;
-
-    } while (iter->next());
-}
-
 void Document::indexPdfPages() {
     auto index = std::make_unique<PageIndex>();
     for (size_t i = 0; i < this->pages.size(); ++i) {
@@ -251,45 +265,158 @@ void Document::indexPdfPages() {
 void Document::buildContentsModel() {
     freeTreeContentModel();
 
-    XojPdfBookmarkIterator* iter = pdfDocument.getContentsIter();
-    if (iter == nullptr) {
+    if (!this->outline || this->outline->empty()) {
         // No Bookmarks
         return;
     }
 
     this->contentsModel = reinterpret_cast<GtkTreeModel*>(
-            gtk_tree_store_new(4, G_TYPE_STRING, G_TYPE_OBJECT, G_TYPE_BOOLEAN, G_TYPE_STRING));
-    buildTreeContentsModel(nullptr, iter);
-    delete iter;
+            gtk_tree_store_new(5, G_TYPE_STRING, G_TYPE_OBJECT, G_TYPE_BOOLEAN, G_TYPE_POINTER, G_TYPE_STRING));
+    appendContentsEntries(nullptr, this->outline->getEntries());
 }
 
-auto Document::getContentsModel() const -> GtkTreeModel* { return this->contentsModel; }
+void Document::appendContentsEntries(GtkTreeIter* parent, const std::vector<DocumentOutline::Entry>& entries) {
+    auto* store = GTK_TREE_STORE(this->contentsModel);
+    for (const DocumentOutline::Entry& entry: entries) {
+        XojLinkDest* link = link_dest_new();
+        link->dest = new LinkDestination(entry.dest);
+
+        GtkTreeIter treeIter = {0};
+        gtk_tree_store_append(store, &treeIter, parent);
+        char* titleMarkup = g_markup_escape_text(entry.title.c_str(), -1);
+
+        gtk_tree_store_set(store, &treeIter, DOCUMENT_LINKS_COLUMN_NAME, titleMarkup, DOCUMENT_LINKS_COLUMN_LINK, link,
+                           DOCUMENT_LINKS_COLUMN_ENTRY, &entry, -1);
+        setContentsPageNumber(&treeIter, *link->dest);
+
+        g_free(titleMarkup);
+        g_object_unref(link);
+
+        if (!entry.children.empty()) {
+            // Replaced by the children when the row is expanded
+            GtkTreeIter placeholder = {0};
+            gtk_tree_store_append(store, &placeholder, &treeIter);
+        }
+    }
+}
 
-auto Document::fillPageLabels(GtkTreeModel* treeModel, GtkTreePath* path, GtkTreeIter* iter, Document* doc) -> bool {
+void Document::setContentsPageNumber(GtkTreeIter* iter, const LinkDestination& dest) {
+    size_t page = dest.getPdfPage() == npos ? npos : findPdfPage(dest.getPdfPage());
+    std::string label = page == npos ? "" : std::to_string(page + 1);
+    gtk_tree_store_set(GTK_TREE_STORE(this->contentsModel), iter, DOCUMENT_LINKS_COLUMN_PAGE_NUMBER, label.c_str(),
+                       -1);
+}
+
+void Document::updateContentsPageNumbers() {
+    if (this->contentsModel) {
+        gtk_tree_model_foreach(this->contentsModel,
+                               reinterpret_cast<GtkTreeModelForeachFunc>(updateContentsPageNumber), this);
+    }
+}
+
+auto Document::updateContentsPageNumber(GtkTreeModel* treeModel, GtkTreePath* path, GtkTreeIter* iter, Document* doc)
+        -> bool {
     XojLinkDest* link = nullptr;
     gtk_tree_model_get(treeModel, iter, DOCUMENT_LINKS_COLUMN_LINK, &link, -1);
-
     if (link == nullptr) {
+        // Placeholder of a collapsed row
         return false;
     }
 
-    auto page = doc->findPdfPage(link->dest->getPdfPage());
+    doc->setContentsPageNumber(iter, *link->dest);
+    g_object_unref(link);
+    return false;
+}
+
+auto Document::getContentsModel() const -> GtkTreeModel* { return this->contentsModel; }
+
+void Document::expandContentsModel(GtkTreeIter* iter) {
+    if (this->contentsModel == nullptr) {
+        return;
+    }
+
+    gpointer entry = nullptr;
+    gtk_tree_model_get(this->contentsModel, iter, DOCUMENT_LINKS_COLUMN_ENTRY, &entry, -1);
+    GtkTreeIter placeholder = {0};
+    if (entry == nullptr || !gtk_tree_model_iter_children(this->contentsModel, &placeholder, iter)) {
+        return;
+    }
 
-    gchar* pageLabel = nullptr;
-    if (page != npos) {
-        pageLabel = g_strdup_printf("%zu", page + 1);
+    gpointer firstChild = nullptr;
+    gtk_tree_model_get(this->contentsModel, &placeholder, DOCUMENT_LINKS_COLUMN_ENTRY, &firstChild, -1);
+    if (firstChild != nullptr) {
+        // Already expanded
+        return;
     }
-    gtk_tree_store_set(GTK_TREE_STORE(treeModel), iter, DOCUMENT_LINKS_COLUMN_PAGE_NUMBER, pageLabel, -1);
-    g_free(pageLabel);
 
-    g_object_unref(link);
-    return false;
+    // Append the children before removing the placeholder, so that the row never looses its expander
+    appendContentsEntries(iter, static_cast<const DocumentOutline::Entry*>(entry)->children);
+    gtk_tree_store_remove(GTK_TREE_STORE(this->contentsModel), &placeholder);
 }
 
-void Document::updateIndexPageNumbers() {
-    if (this->contentsModel != nullptr) {
-        gtk_tree_model_foreach(this->contentsModel, reinterpret_cast<GtkTreeModelForeachFunc>(fillPageLabels), this);
+auto Document::getContentsIter(const DocumentOutline::Path& path, GtkTreeIter* iter) -> bool {
+    if (this->contentsModel == nullptr || path.empty()) {
+        return false;
+    }
+
+    GtkTreeIter parent = {0};
+    for (size_t i = 0; i < path.size(); i++) {
+        if (i > 0) {
+            expandContentsModel(&parent);
+        }
+        if (!gtk_tree_model_iter_nth_child(this->contentsModel, iter, i > 0 ? &parent : nullptr,
+                                           static_cast<gint>(path[i]))) {
+            return false;
+        }
+        parent = *iter;
     }
+    return true;
+}
+
+auto Document::getOutline() const -> std::shared_ptr<const DocumentOutline> { return this->outline; }
+
+void Document::readOutline() {
+    stopReadingOutline();
+    this->outline.reset();
+    freeTreeContentModel();
+
+    this->outlineReaderCancelled = false;
+    this->outlineReader = std::thread([this, pdf = this->pdfDocument, generation = this->outlineGeneration,
+                                       handle = std::weak_ptr<Document*>(this->outlineHandle)]() {
+        auto outline =
+                std::make_shared<const DocumentOutline>(DocumentOutline::read(pdf, this->outlineReaderCancelled));
+        if (this->outlineReaderCancelled) {
+            return;
+        }
+
+        Util::execInUiThread([handle, generation, outline = std::move(outline)]() {
+            if (auto doc = handle.lock()) {
+                (*doc)->setOutline(generation, outline);
+            }
+        });
+    });
+}
+
+void Document::stopReadingOutline() {
+    this->outlineReaderCancelled = true;
+    if (this->outlineReader.joinable()) {
+        this->outlineReader.join();
+    }
+    this->outlineGeneration++;
+}
+
+void Document::setOutline(uint64_t generation, std::shared_ptr<const DocumentOutline> outline) {
+    lock();
+    if (generation != this->outlineGeneration) {
+        // The document changed while the outline was read
+        unlock();
+        return;
+    }
+    this->outline = std::move(outline);
+    buildContentsModel();
+    unlock();
+
+    this->handler->fireDocumentChanged(DOCUMENT_CHANGE_PDF_BOOKMARKS);
 }
 
 auto Document::readPdf(const fs::path& filename, bool initPages, bool attachToDocument, gpointer data, gsize length)
@@ -325,6 +452,7 @@ auto Document::readPdf(const fs::path& filename, bool initPages, bool attachToDo
 
     if (initPages) {
         this->pages.clear();
+        this->pagePositions.reset();
     }
 
     if (initPages) {
@@ -337,8 +465,7 @@ auto Document::readPdf(const fs::path& filename, bool initPages, bool attachToDo
     }
 
     indexPdfPages();
-    buildContentsModel();
-    updateIndexPageNumbers();
+    readOutline();
 
     unlock();
 
@@ -362,36 +489,53 @@ void Document::deletePage(size_t pNr) {
     auto it = this->pages.begin() + pNr;
     this->pages.erase(it);
 
-    // Reset the page index
+    // Reset the page indexes
     this->pageIndex.reset();
-    updateIndexPageNumbers();
+    this->pagePositions.reset();
 }
 
 void Document::insertPage(const PageRef& p, size_t position) {
     this->pages.insert(this->pages.begin() + position, p);
 
-    // Reset the page index
+    // Reset the page indexes
     this->pageIndex.reset();
-    updateIndexPageNumbers();
+    this->pagePositions.reset();
 }
 
 void Document::addPage(const PageRef& p) {
     this->pages.push_back(p);
+    if (this->pagePositions) {
+        this->pagePositions->emplace(p.get(), this->pages.size() - 1);
+    }
 
     // Reset the page index
     this->pageIndex.reset();
-    updateIndexPageNumbers();
 }
 
 auto Document::indexOf(const PageRef& page) -> size_t {
-    for (size_t i = 0; i < this->pages.size(); i++) {
-        PageRef pg = this->pages[i];
-        if (pg == page) {
-            return i;
-        }
+    if (!this->pagePositions) {
+        indexPagePositions();
+    }
+    auto pos = this->pagePositions->find(page.get());
+    if (pos == this->pagePositions->end()) {
+        return npos;
     }
+    return pos->second;
+}
 
-    return npos;
+auto Document::getAudioIndex() -> const AudioIndex& {
+    this->audioIndex.update(this->pages);
+    return this->audioIndex;
+}
+
+void Document::indexPagePositions() {
+    auto index = std::make_unique<PagePositions>();
+    index->reserve(this->pages.size());
+    for (size_t i = 0; i < this->pages.size(); ++i) {
+        // emplace keeps the first position if a page is there twice
+        index->emplace(this->pages[i].get(), i);
+    }
+    this->pagePositions.swap(index);
 }
 
 auto Document::getPage(size_t page) const -> PageRef {
@@ -420,11 +564,17 @@ auto Document::operator=(const Document& doc) -> Document& {
     this->pdfFilepath = doc.pdfFilepath;
     this->filepath = doc.filepath;
     this->pages = doc.pages;
+    this->pagePositions.reset();
     this->attachPdf = doc.attachPdf;
 
     indexPdfPages();
-    buildContentsModel();
-    updateIndexPageNumbers();
+    if (doc.outline) {
+        this->outline = doc.outline;
+        buildContentsModel();
+    } else if (this->pdfDocument.isLoaded()) {
+        // The outline of doc is still being read
+        readOutline();
+    }
 
     bool lastLock = tryLock();
     unlock();
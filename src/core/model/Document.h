@@ -13,11 +13,15 @@
 
 #pragma once
 
+#include <atomic>         // for atomic
 #include <cstddef>        // for size_t
-#include <memory>         // for unique_ptr
+#include <cstdint>        // for uint64_t
+#include <memory>         // for unique_ptr, shared_ptr, weak_ptr
 #include <mutex>          // for mutex
 #include <string>         // for string
+#include <thread>         // for thread
 #include <unordered_map>  // for unordered_map
+#include <utility>        // for pair
 #include <vector>         // for vector
 
 #include <cairo.h>    // for cairo_surface_t
@@ -27,11 +31,14 @@
 #include "pdf/base/XojPdfDocument.h"  // for XojPdfDocument
 #include "pdf/base/XojPdfPage.h"      // for XojPdfPageSPtr
 
-#include "PageRef.h"     // for PageRef
-#include "filesystem.h"  // for path
+#include "AudioIndex.h"       // for AudioIndex
+#include "DocumentOutline.h"  // for DocumentOutline
+#include "PageRef.h"          // for PageRef
+#include "filesystem.h"       // for path
 
 class DocumentHandler;
-class XojPdfBookmarkIterator;
+class LinkDestination;
+class XojPage;
 
 class Document {
 public:
@@ -62,6 +69,12 @@ public:
 
     size_t indexOf(const PageRef& page);
 
+    /**
+     * @brief The elements linked to audio recordings, by recording and timestamp
+     * The document must be locked. Only the pages modified since the last call are indexed again.
+     */
+    const AudioIndex& getAudioIndex();
+
     /**
      * @return The last error message to show to the user
      */
@@ -79,8 +92,38 @@ public:
 
     fs::path getEvMetadataFilename() const;
 
+    /**
+     * @return The outline of the PDF background, or nullptr while it is read in the background (see readPdf())
+     */
+    std::shared_ptr<const DocumentOutline> getOutline() const;
+
+    /**
+     * @brief The outline as a tree model, for the sidebar
+     *
+     * Only the top level entries and the children of the expanded entries are in the model, the other entries with
+     * children get an empty placeholder child. See expandContentsModel().
+     */
     GtkTreeModel* getContentsModel() const;
 
+    /**
+     * @brief Replace the placeholder of the row by the children of its entry, if not done yet
+     * The document must be locked.
+     */
+    void expandContentsModel(GtkTreeIter* iter);
+
+    /**
+     * @brief Get the row of the outline entry, expanding the model on the way
+     * The document must be locked.
+     * @return false if there is no such row
+     */
+    bool getContentsIter(const DocumentOutline::Path& path, GtkTreeIter* iter);
+
+    /**
+     * @brief Resolve again the page numbers shown in the contents model, once pages were inserted or removed
+     * The document must be locked.
+     */
+    void updateContentsPageNumbers();
+
     void setCreateBackupOnSave(bool backup);
     bool shouldCreateBackupOnSave() const;
 
@@ -95,14 +138,39 @@ public:
     void unlock();
     bool tryLock();
 
+    /**
+     * @brief Create a read-only copy of the document, for jobs which run without holding the document lock
+     * (save, autosave, export...).
+     *
+     * The pages are copied on write: a page which was not modified since it was last copied is shared with the
+     * snapshots still alive. Hence taking a snapshot while another one is in use only costs a copy of the modified
+     * pages.
+     * The document must be locked. The snapshot has no listeners and must not be modified.
+     */
+    std::unique_ptr<Document> createSnapshot();
+
+    /**
+     * @brief Get a read-only copy of the page, shared with the snapshots as long as the page is not modified.
+     * The copy is only kept while someone holds it. The document must be locked.
+     */
+    PageRef getPageSnapshot(const PageRef& page);
+
 private:
     void buildContentsModel();
     void freeTreeContentModel();
     static bool freeTreeContentEntry(GtkTreeModel* treeModel, GtkTreePath* path, GtkTreeIter* iter, Document* doc);
 
-    void buildTreeContentsModel(GtkTreeIter* parent, XojPdfBookmarkIterator* iter);
-    void updateIndexPageNumbers();
-    static bool fillPageLabels(GtkTreeModel* treeModel, GtkTreePath* path, GtkTreeIter* iter, Document* doc);
+    void appendContentsEntries(GtkTreeIter* parent, const std::vector<DocumentOutline::Entry>& entries);
+    void setContentsPageNumber(GtkTreeIter* iter, const LinkDestination& dest);
+    static bool updateContentsPageNumber(GtkTreeModel* treeModel, GtkTreePath* path, GtkTreeIter* iter, Document* doc);
+
+    /**
+     * @brief Read the outline of the PDF background on a worker thread. The outline is set (and the listeners notified)
+     * from the UI thread once it is read.
+     */
+    void readOutline();
+    void stopReadingOutline();
+    void setOutline(uint64_t generation, std::shared_ptr<const DocumentOutline> outline);
 
 private:
     DocumentHandler* handler = nullptr;
@@ -143,10 +211,51 @@ private:
     void indexPdfPages();
 
     /**
-     * The bookmark contents model
+     * Index from page to its position in the document
+     */
+    using PagePositions = std::unordered_map<const XojPage*, size_t>;
+
+    /**
+     * The cached page positions, see indexOf(). Extended by addPage(), reset when pages are inserted or removed.
+     */
+    std::unique_ptr<PagePositions> pagePositions;
+
+    /**
+     * Creates the index of the page positions
+     */
+    void indexPagePositions();
+
+    /**
+     * See getAudioIndex(). Brought up to date on each call.
+     */
+    AudioIndex audioIndex;
+
+    /**
+     * The outline of the PDF background, shared with the snapshots
+     */
+    std::shared_ptr<const DocumentOutline> outline;
+
+    /**
+     * The bookmark contents model, built from the outline
      */
     GtkTreeModel* contentsModel = nullptr;
 
+    /**
+     * Reads the outline, see readOutline()
+     */
+    std::thread outlineReader;
+    std::atomic<bool> outlineReaderCancelled = false;
+
+    /**
+     * Incremented each time the outline reader is stopped: the outlines read before are dropped
+     */
+    uint64_t outlineGeneration = 0;
+
+    /**
+     * Reset on destruction, so that the outline reader does not call back a deleted document
+     */
+    std::shared_ptr<Document*> outlineHandle = std::make_shared<Document*>(this);
+
     /**
      *  create a backup before save
      */
@@ -161,11 +270,17 @@ private:
      * The lock of the document
      */
     std::mutex documentLock;
+
+    /**
+     * The last copy of each page, with the revision of the page it was made from. Only held weakly: the copies are
+     * owned by the snapshots and the jobs using them, the document does not keep a second copy of its pages.
+     */
+    std::unordered_map<const XojPage*, std::pair<uint64_t, std::weak_ptr<XojPage>>> pageSnapshots;
 };
 
 template <class InputIter>
 void Document::addPages(InputIter first, InputIter last) {
     this->pages.insert(this->pages.end(), first, last);
     this->pageIndex.reset();
-    updateIndexPageNumbers();
+    this->pagePositions.reset();
 }
@@ -20,6 +20,13 @@ void DocumentHandler::firePageChanged(size_t page) {
     for (DocumentListener* dl: this->listener) { dl->pageChanged(page); }
 }
 
+void DocumentHandler::firePagesChanged(const std::vector<size_t>& pages) {
+    if (pages.empty()) {
+        return;
+    }
+    for (DocumentListener* dl: this->listener) { dl->pagesChanged(pages); }
+}
+
 void DocumentHandler::firePageInserted(size_t page) {
     for (DocumentListener* dl: this->listener) { dl->pageInserted(page); }
 }
@@ -13,6 +13,7 @@
 
 #include <cstddef>  // for size_t
 #include <list>     // for list
+#include <vector>   // for vector
 
 #include "DocumentChangeType.h"  // for DocumentChangeType
 
@@ -28,6 +29,7 @@ public:
     void fireDocumentChanged(DocumentChangeType type);
     void firePageSizeChanged(size_t page);
     void firePageChanged(size_t page);
+    void firePagesChanged(const std::vector<size_t>& pages);
     void firePageInserted(size_t page);
     void firePageDeleted(size_t page);
     // void firePageLoaded(PageRef page);
@@ -25,6 +25,10 @@ void DocumentListener::pageSizeChanged(size_t page) {}
 
 void DocumentListener::pageChanged(size_t page) {}
 
+void DocumentListener::pagesChanged(const std::vector<size_t>& pages) {
+    for (size_t page: pages) { pageChanged(page); }
+}
+
 void DocumentListener::pageInserted(size_t page) {}
 
 void DocumentListener::pageDeleted(size_t page) {}
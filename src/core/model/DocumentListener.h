@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstddef>  // for size_t
+#include <vector>   // for vector
 
 #include "DocumentChangeType.h"  // for DocumentChangeType
 
@@ -29,6 +30,14 @@ public:
     virtual void documentChanged(DocumentChangeType type);
     virtual void pageSizeChanged(size_t page);
     virtual void pageChanged(size_t page);
+
+    /**
+     * @brief Several pages changed at once
+     * @param pages The indices of the pages, sorted and without duplicates
+     *
+     * Calls pageChanged() for each page by default: listeners with a per notification cost override it.
+     */
+    virtual void pagesChanged(const std::vector<size_t>& pages);
     virtual void pageInserted(size_t page);
     virtual void pageDeleted(size_t page);
     virtual void pageSelected(size_t page);
@@ -0,0 +1,88 @@
+#include "DocumentOutline.h"
+
+#include <memory>   // for unique_ptr
+#include <utility>  // for move
+
+#include "pdf/base/XojPdfAction.h"            // for XojPdfAction
+#include "pdf/base/XojPdfBookmarkIterator.h"  // for XojPdfBookmarkIterator
+#include "pdf/base/XojPdfDocument.h"          // for XojPdfDocument
+
+namespace {
+auto countEntries(const std::vector<DocumentOutline::Entry>& entries) -> size_t {
+    size_t count = entries.size();
+    for (const auto& e: entries) {
+        count += countEntries(e.children);
+    }
+    return count;
+}
+
+auto findEntry(const std::vector<DocumentOutline::Entry>& entries, size_t pdfPage, DocumentOutline::Path& path)
+        -> bool {
+    for (size_t i = 0; i < entries.size(); i++) {
+        path.push_back(i);
+        if (entries[i].dest.getPdfPage() == pdfPage || findEntry(entries[i].children, pdfPage, path)) {
+            return true;
+        }
+        path.pop_back();
+    }
+    return false;
+}
+}  // namespace
+
+DocumentOutline::DocumentOutline(std::vector<Entry> entries):
+        entries(std::move(entries)), count(countEntries(this->entries)) {}
+
+auto DocumentOutline::read(const XojPdfDocument& pdf, const std::atomic<bool>& cancelled) -> DocumentOutline {
+    DocumentOutline outline;
+    std::unique_ptr<XojPdfBookmarkIterator> iter(pdf.getContentsIter());
+    if (iter) {
+        readEntries(iter.get(), outline.entries, outline.count, cancelled);
+    }
+    return outline;
+}
+
+void DocumentOutline::readEntries(XojPdfBookmarkIterator* iter, std::vector<Entry>& entries, size_t& count,
+                                  const std::atomic<bool>& cancelled) {
+    do {
+        if (cancelled) {
+            return;
+        }
+
+        std::unique_ptr<XojPdfAction> action(iter->getAction());
+        std::string title = action->getTitle();
+        if (title.empty()) {
+            continue;
+        }
+
+        Entry& entry = entries.emplace_back(Entry{std::move(title), *action->getDestination(), {}});
+        entry.dest.setExpand(iter->isOpen());
+        count++;
+
+        std::unique_ptr<XojPdfBookmarkIterator> child(iter->getChildIter());
+        if (child) {
+            readEntries(child.get(), entry.children, count, cancelled);
+        }
+    } while (iter->next());
+}
+
+auto DocumentOutline::getEntries() const -> const std::vector<Entry>& { return entries; }
+
+auto DocumentOutline::size() const -> size_t { return count; }
+
+auto DocumentOutline::empty() const -> bool { return entries.empty(); }
+
+auto DocumentOutline::getEntry(const Path& path) const -> const Entry& {
+    const Entry* entry = &entries.at(path.at(0));
+    for (size_t i = 1; i < path.size(); i++) {
+        entry = &entry->children.at(path[i]);
+    }
+    return *entry;
+}
+
+auto DocumentOutline::findPdfPage(size_t pdfPage) const -> std::optional<Path> {
+    Path path;
+    if (findEntry(entries, pdfPage, path)) {
+        return path;
+    }
+    return std::nullopt;
+}
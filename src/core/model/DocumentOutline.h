@@ -0,0 +1,81 @@
+/*
+ * Xournal++
+ *
+ * The outline (table of contents) of the background PDF
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <atomic>    // for atomic
+#include <cstddef>   // for size_t
+#include <optional>  // for optional
+#include <string>    // for string
+#include <vector>    // for vector
+
+#include "LinkDestination.h"  // for LinkDestination
+
+class XojPdfBookmarkIterator;
+class XojPdfDocument;
+
+/**
+ * @brief Plain, immutable copy of the outline of a PDF document
+ *
+ * The outline is read once (see read(), which may run on any thread) and shared between the document, its snapshots and
+ * the views. It does not depend on the pages of the document: page numbers are resolved by the users, when needed.
+ */
+class DocumentOutline {
+public:
+    struct Entry {
+        std::string title;
+        /// The expand flag of the destination tells if the entry is open
+        LinkDestination dest;
+        std::vector<Entry> children;
+    };
+
+    /// The indices of the entries leading to an entry, from the top level down
+    using Path = std::vector<size_t>;
+
+    DocumentOutline() = default;
+    explicit DocumentOutline(std::vector<Entry> entries);
+
+    /**
+     * @brief Read the outline of the PDF document. Entries without title are skipped, with their children.
+     * @param cancelled Checked between the entries: if set, the reading stops and a partial outline is returned
+     */
+    static DocumentOutline read(const XojPdfDocument& pdf, const std::atomic<bool>& cancelled);
+
+    /**
+     * @return The top level entries
+     */
+    const std::vector<Entry>& getEntries() const;
+
+    /**
+     * @return The number of entries, at all levels
+     */
+    size_t size() const;
+
+    bool empty() const;
+
+    /**
+     * @return The entry at the given path
+     */
+    const Entry& getEntry(const Path& path) const;
+
+    /**
+     * @return The path of the first entry, in document order, which links to the PDF page
+     */
+    std::optional<Path> findPdfPage(size_t pdfPage) const;
+
+private:
+    static void readEntries(XojPdfBookmarkIterator* iter, std::vector<Entry>& entries, size_t& count,
+                            const std::atomic<bool>& cancelled);
+
+private:
+    std::vector<Entry> entries;
+    size_t count = 0;
+};
@@ -4,8 +4,8 @@
 #include <array>      // for array
 #include <utility>    // for move, pair
 
-#include <cairo.h>        // for cairo_surface_destroy
-#include <gdk/gdk.h>      // for gdk_cairo_set_sourc...
+#include <cairo.h>        // for cairo_image_surface_get_width
+#include <gdk/gdk.h>      // for gdk_pixbuf_loader_new
 #include <glib-object.h>  // for g_object_unref
 #include <glib.h>         // for g_assert, guchar
 
@@ -13,17 +13,13 @@
 #include "util/Rectangle.h"                       // for Rectangle
 #include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
 #include "util/serializing/ObjectOutputStream.h"  // for ObjectOutputStream
+#include "view/ImageCache.h"                      // for ImageCache
 
 using xoj::util::Rectangle;
 
 Image::Image(): Element(ELEMENT_IMAGE) {}
 
 Image::~Image() {
-    if (this->image) {
-        cairo_surface_destroy(this->image);
-        this->image = nullptr;
-    }
-
     if (this->format) {
         gdk_pixbuf_format_free(this->format);
         this->format = nullptr;
@@ -39,8 +35,11 @@ auto Image::clone() const -> Element* {
     img->width = this->width;
     img->height = this->height;
     img->data = this->data;
+    img->imageSize = this->imageSize;
+    if (this->format) {
+        img->format = gdk_pixbuf_format_copy(this->format);
+    }
 
-    img->image = cairo_surface_reference(this->image);
     img->snappedBounds = this->snappedBounds;
     img->sizeCalculated = this->sizeCalculated;
 
@@ -60,24 +59,35 @@ void Image::setHeight(double height) {
 void Image::setImage(std::string_view data) { setImage(std::string(data)); }
 
 void Image::setImage(std::string&& data) {
-    if (this->image) {
-        cairo_surface_destroy(this->image);
-        this->image = nullptr;
-    }
+    resetData(std::make_shared<const LazyData>(std::move(data)));
+    parseFormat();
+}
+
+void Image::setDataReader(LazyData::Reader reader) {
+    // The format is parsed when it is first needed, to avoid reading the data
+    resetData(std::make_shared<const LazyData>(std::move(reader)));
+}
+
+void Image::resetData(std::shared_ptr<const LazyData> data) {
     this->data = std::move(data);
+    this->imageSize = NOSIZE;
 
     if (this->format) {
         gdk_pixbuf_format_free(this->format);
         this->format = nullptr;
     }
+}
+
+void Image::parseFormat() const {
+    const std::string& bytes = *this->data->get();
 
     // FIXME: awful hack to try to parse the format
     std::array<char*, 4096> buffer{};
     GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
-    size_t remaining = this->data.size();
+    size_t remaining = bytes.size();
     while (remaining > 0) {
         size_t readLen = std::min(remaining, buffer.size());
-        if (!gdk_pixbuf_loader_write(loader, reinterpret_cast<const guchar*>(this->data.c_str()), readLen, nullptr))
+        if (!gdk_pixbuf_loader_write(loader, reinterpret_cast<const guchar*>(bytes.c_str()), readLen, nullptr))
             break;
         remaining -= readLen;
 
@@ -108,11 +118,6 @@ void Image::setImage(GdkPixbuf* img) {
 }
 
 void Image::setImage(cairo_surface_t* image) {
-    if (this->image) {
-        cairo_surface_destroy(this->image);
-        this->image = nullptr;
-    }
-
     struct {
         std::string buffer;
         std::string readbuf;
@@ -125,41 +130,16 @@ void Image::setImage(cairo_surface_t* image) {
     };
     cairo_surface_write_to_png_stream(image, writeFunc, &closure_);
 
-    data = std::move(closure_.buffer);
+    resetData(std::make_shared<const LazyData>(std::move(closure_.buffer)));
 }
 
-auto Image::getImage() const -> cairo_surface_t* {
-    g_assert(data.length() > 0 && "image has no data, cannot render it!");
-    if (this->image == nullptr) {
-        GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
-        gdk_pixbuf_loader_write(loader, reinterpret_cast<const guchar*>(this->data.c_str()), this->data.length(),
-                                nullptr);
-        bool success = gdk_pixbuf_loader_close(loader, nullptr);
-        g_assert(success && "errors in loading image data!");
+auto Image::getImage() const -> xoj::util::CairoSurfaceSPtr {
+    g_assert(hasData() && "image has no data, cannot render it!");
+    auto image = xoj::view::ImageCache::getInstance().getFullResolution(getSharedData());
+    g_assert(image && "errors in loading image data!");
 
-        GdkPixbuf* tmp = gdk_pixbuf_loader_get_pixbuf(loader);
-        g_assert(tmp != nullptr);
-        GdkPixbuf* pixbuf = gdk_pixbuf_apply_embedded_orientation(tmp);
-
-        this->imageSize = {gdk_pixbuf_get_width(pixbuf), gdk_pixbuf_get_height(pixbuf)};
-
-        // TODO: pass in window once this code is refactored into ImageView
-        this->image = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, gdk_pixbuf_get_width(pixbuf),
-                                                 gdk_pixbuf_get_height(pixbuf));
-        g_assert(this->image != nullptr);
-
-        // Paint the pixbuf on to the surface
-        // NOTE: we do this manually instead of using gdk_cairo_surface_create_from_pixbuf
-        // since this does not work in CLI mode.
-        cairo_t* cr = cairo_create(this->image);
-        gdk_cairo_set_source_pixbuf(cr, pixbuf, 0, 0);
-        cairo_paint(cr);
-        cairo_destroy(cr);
-
-        g_object_unref(loader);
-    }
-
-    return this->image;
+    this->imageSize = {cairo_image_surface_get_width(image.get()), cairo_image_surface_get_height(image.get())};
+    return image;
 }
 
 void Image::scale(double x0, double y0, double fx, double fy, double rotation,
@@ -186,7 +166,7 @@ void Image::serialize(ObjectOutputStream& out) const {
     out.writeDouble(this->width);
     out.writeDouble(this->height);
 
-    out.writeImage(this->data);
+    out.writeImage(*this->data->get());
 
     out.endObject();
 }
@@ -199,12 +179,7 @@ void Image::readSerialized(ObjectInputStream& in) {
     this->width = in.readDouble();
     this->height = in.readDouble();
 
-    if (this->image) {
-        cairo_surface_destroy(this->image);
-        this->image = nullptr;
-    }
-
-    this->data = in.readImage();
+    resetData(std::make_shared<const LazyData>(in.readImage()));
 
     in.endObject();
     this->calcSize();
@@ -215,12 +190,21 @@ void Image::calcSize() const {
     this->sizeCalculated = true;
 }
 
-bool Image::hasData() const { return !this->data.empty(); }
+bool Image::hasData() const { return !this->data->empty(); }
+
+const unsigned char* Image::getRawData() const {
+    return reinterpret_cast<const unsigned char*>(this->data->get()->data());
+}
 
-const unsigned char* Image::getRawData() const { return reinterpret_cast<const unsigned char*>(this->data.data()); }
+size_t Image::getRawDataLength() const { return this->data->get()->size(); }
 
-size_t Image::getRawDataLength() const { return this->data.size(); }
+auto Image::getSharedData() const -> const std::shared_ptr<const std::string>& { return this->data->get(); }
 
 std::pair<int, int> Image::getImageSize() const { return this->imageSize; }
 
-GdkPixbufFormat* Image::getImageFormat() const { return this->format; }
+GdkPixbufFormat* Image::getImageFormat() const {
+    if (!this->format && hasData()) {
+        parseFormat();
+    }
+    return this->format;
+}
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstddef>      // for size_t
+#include <memory>       // for shared_ptr
 #include <string>       // for string
 #include <string_view>  // for string_view
 #include <utility>      // for pair, make_pair
@@ -19,7 +20,10 @@
 #include <cairo.h>                  // for cairo_surface_t, cairo_status_t
 #include <gdk-pixbuf/gdk-pixbuf.h>  // for GdkPixbufFormat, GdkPixbuf
 
-#include "Element.h"  // for Element
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+#include "Element.h"   // for Element
+#include "LazyData.h"  // for LazyData
 
 class ObjectInputStream;
 class ObjectOutputStream;
@@ -44,6 +48,10 @@ public:
     /// Set the image data by moving the data.
     void setImage(std::string&& data);
 
+    /// Set a function providing the image data. It is called (possibly from a render thread) when the data is
+    /// first needed, e.g. to read an attachment of the document only when its page is displayed.
+    void setDataReader(LazyData::Reader reader);
+
     /// Set the image data by copying the data from the provided pixbuf.
     ///
     /// \deprecated Pass the raw image data instead.
@@ -51,10 +59,11 @@ public:
     /// FIXME: remove this method. Currently, it is used by Control::clipboardPasteImage.
     [[deprecated]] void setImage(GdkPixbuf* img);
 
-    /// Returns the internal surface that contains the rendered image data.
+    /// Returns a surface that contains the image data at full resolution.
     ///
-    /// Note that the image is rendered lazily by default; call this method to render it.
-    cairo_surface_t* getImage() const;
+    /// The image is decoded lazily and kept in xoj::view::ImageCache; call this method to decode it. Views should
+    /// rather ask the cache for a surface suited to their resolution.
+    xoj::util::CairoSurfaceSPtr getImage() const;
 
     void scale(double x0, double y0, double fx, double fy, double rotation, bool restoreLineWidth) override;
     void rotate(double x0, double y0, double th) override;
@@ -69,6 +78,10 @@ public:
     /// Return the length of the raw data.
     size_t getRawDataLength() const;
 
+    /// Return the raw data, shared by the clones of this image. Also used as key of the decoded image cache.
+    /// Reads the data if it was not read yet.
+    const std::shared_ptr<const std::string>& getSharedData() const;
+
     /// Return the size of the raw image, or (-1, -1) if the image has not been rendered yet.
     std::pair<int, int> getImageSize() const;
 
@@ -86,6 +99,9 @@ private:
 
     static cairo_status_t cairoReadFunction(const Image* image, unsigned char* data, unsigned int length);
 
+    void resetData(std::shared_ptr<const LazyData> data);
+    void parseFormat() const;
+
 private:
     /// Set the image data by rendering the surface to PNG and copying the PNG data.
     ///
@@ -94,12 +110,9 @@ private:
     /// FIXME: remove this when setImage(GdkPixbuf*) is removed.
     [[deprecated]] void setImage(cairo_surface_t* image);
 
-    /// Temporary surface used as a render buffer.
-    mutable cairo_surface_t* image = nullptr;
-
     /// Image format information.
     mutable GdkPixbufFormat* format = nullptr;
     mutable std::pair<int, int> imageSize = {-1, -1};
 
-    std::string data;
+    std::shared_ptr<const LazyData> data = std::make_shared<const LazyData>();
 };
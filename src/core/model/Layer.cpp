@@ -39,6 +39,7 @@ void Layer::addElement(Element* e) {
     }
 
     this->elements.push_back(e);
+    this->revision.bump();
 }
 
 void Layer::insertElement(Element* e, Element::Index pos) {
@@ -68,6 +69,7 @@ void Layer::insertElement(Element* e, Element::Index pos) {
     } else {
         this->elements.insert(this->elements.begin() + pos, e);
     }
+    this->revision.bump();
 }
 
 auto Layer::indexOf(Element* e) const -> Element::Index {
@@ -84,6 +86,7 @@ auto Layer::removeElement(Element* e, bool free) -> Element::Index {
     for (unsigned int i = 0; i < this->elements.size(); i++) {
         if (e == this->elements[i]) {
             this->elements.erase(this->elements.begin() + i);
+            this->revision.bump();
 
             if (free) {
                 delete e;
@@ -97,7 +100,10 @@ auto Layer::removeElement(Element* e, bool free) -> Element::Index {
     return Element::InvalidIndex;
 }
 
-void Layer::clearNoFree() { this->elements.clear(); }
+void Layer::clearNoFree() {
+    this->elements.clear();
+    this->revision.bump();
+}
 
 auto Layer::isAnnotated() const -> bool { return !this->elements.empty(); }
 
@@ -109,7 +115,10 @@ auto Layer::isVisible() const -> bool { return visible; }
 /**
  * @return true if the layer is visible
  */
-void Layer::setVisible(bool visible) { this->visible = visible; }
+void Layer::setVisible(bool visible) {
+    this->visible = visible;
+    this->revision.bump();
+}
 
 auto Layer::getElements() const -> const std::vector<Element*>& { return this->elements; }
 
@@ -117,4 +126,9 @@ auto Layer::hasName() const -> bool { return name.has_value(); }
 
 auto Layer::getName() const -> std::string { return name.value_or(""); }
 
-void Layer::setName(const std::string& newName) { this->name = newName; }
+void Layer::setName(const std::string& newName) {
+    this->name = newName;
+    this->revision.bump();
+}
+
+auto Layer::getRevision() const -> const Revision& { return this->revision; }
@@ -16,7 +16,8 @@
 #include <string>    // for string
 #include <vector>    // for vector
 
-#include "Element.h"  // for Element, Element::Index
+#include "Element.h"   // for Element, Element::Index
+#include "Revision.h"  // for Revision
 
 template <class T>
 using optional = std::optional<T>;
@@ -98,10 +99,17 @@ public:
      */
     void setName(const std::string& newName);
 
+    /**
+     * @return A stamp which changes whenever elements are added or removed, or the layer's properties change
+     */
+    const Revision& getRevision() const;
+
 private:
     std::vector<Element*> elements;
 
     bool visible = true;
 
     optional<std::string> name;
+
+    Revision revision;
 };
@@ -0,0 +1,24 @@
+#include "LazyData.h"
+
+#include <utility>  // for move
+
+LazyData::LazyData(): data(std::make_shared<const std::string>()) {}
+
+LazyData::LazyData(std::string data): data(std::make_shared<const std::string>(std::move(data))) {}
+
+LazyData::LazyData(Reader reader): reader(std::move(reader)) {}
+
+auto LazyData::get() const -> const std::shared_ptr<const std::string>& {
+    std::lock_guard lock(mutex);
+    if (reader) {
+        auto result = reader();
+        data = std::make_shared<const std::string>(result ? std::move(*result) : std::string());
+        reader = nullptr;
+    }
+    return data;
+}
+
+auto LazyData::empty() const -> bool {
+    std::lock_guard lock(mutex);
+    return !reader && data->empty();
+}
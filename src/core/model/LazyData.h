@@ -0,0 +1,55 @@
+/*
+ * Xournal++
+ *
+ * Binary data of an element, read on demand
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <functional>  // for function
+#include <memory>      // for shared_ptr
+#include <mutex>       // for mutex
+#include <optional>    // for optional
+#include <string>      // for string
+
+/**
+ * @brief Binary data (e.g. an encoded image) which may only be read the first time it is needed
+ *
+ * Elements loaded from a zip archive keep a reader of their attachment instead of the data itself, so that opening a
+ * document does not read the attachments of pages which are never displayed. The instances are immutable (apart from
+ * resolving the reader) and shared by an element and its clones. Thread-safe.
+ */
+class LazyData {
+public:
+    /**
+     * @return The data, or nullopt if it could not be read
+     */
+    using Reader = std::function<std::optional<std::string>()>;
+
+    LazyData();
+    explicit LazyData(std::string data);
+    explicit LazyData(Reader reader);
+
+    LazyData(const LazyData&) = delete;
+    LazyData& operator=(const LazyData&) = delete;
+
+    /**
+     * @return The data, read on the first call. Empty if it could not be read.
+     */
+    const std::shared_ptr<const std::string>& get() const;
+
+    /**
+     * @return true if there is no data. Data not read yet is assumed not to be empty.
+     */
+    bool empty() const;
+
+private:
+    mutable std::mutex mutex;
+    mutable Reader reader;
+    mutable std::shared_ptr<const std::string> data;
+};
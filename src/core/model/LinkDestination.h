@@ -94,6 +94,9 @@ enum {
     DOCUMENT_LINKS_COLUMN_NAME,
     DOCUMENT_LINKS_COLUMN_LINK,
     DOCUMENT_LINKS_COLUMN_EXPAND,
+    /// The DocumentOutline::Entry of the row, nullptr for placeholders
+    DOCUMENT_LINKS_COLUMN_ENTRY,
+    /// The label of the document page of the entry, see Document::updateContentsPageNumbers()
     DOCUMENT_LINKS_COLUMN_PAGE_NUMBER
 };
 
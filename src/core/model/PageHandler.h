@@ -16,6 +16,8 @@
 
 #include "util/Range.h"  // for Range
 
+#include "Revision.h"  // for Revision
+
 class Element;
 class PageListener;
 class Range;
@@ -41,6 +43,12 @@ public:
     void fireElementsChanged(const std::vector<Element*>& elements, Range range = Range());
     void firePageChanged();
 
+protected:
+    /**
+     * Changed by every notification, see XojPage::getRevision()
+     */
+    Revision revision;
+
 private:
     void addListener(PageListener* l);
     void removeListener(PageListener* l);
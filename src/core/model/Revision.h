@@ -0,0 +1,46 @@
+/*
+ * Xournal++
+ *
+ * Modification stamp of a part of the document
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <atomic>   // for atomic
+#include <cstdint>  // for uint64_t
+
+/**
+ * @brief A modification stamp
+ *
+ * Every change of a stamp gives a value which was never used before, by any stamp. Hence the maximum of several
+ * stamps changes as soon as one of them changes, and a copied object never has the same stamp as the original.
+ */
+class Revision {
+public:
+    Revision(): value(next()) {}
+    Revision(const Revision&): value(next()) {}
+    Revision& operator=(const Revision&) {
+        bump();
+        return *this;
+    }
+
+    /**
+     * @brief Mark the owner as modified
+     */
+    void bump() { value.store(next(), std::memory_order_relaxed); }
+
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    static uint64_t next() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    std::atomic<uint64_t> value;
+};
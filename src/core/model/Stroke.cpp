@@ -201,6 +201,7 @@ void Stroke::readSerialized(ObjectInputStream& in) {
     int count{};
     in.readData(reinterpret_cast<void**>(&p), &count);
     this->points = std::vector<Point>{p, p + count};
+    this->pointsRevision.bump();
     g_free(p);
     this->lineStyle.readSerialized(in);
 
@@ -246,6 +247,7 @@ auto Stroke::isInSelection(ShapeContainer* container) const -> bool {
 
 void Stroke::addPoint(const Point& p) {
     this->points.emplace_back(p);
+    this->pointsRevision.bump();
     if (!sizeCalculated) {
         return;
     }
@@ -264,11 +266,13 @@ auto Stroke::getPointVector() const -> std::vector<Point> const& { return points
 
 void Stroke::deletePointsFrom(size_t index) {
     points.resize(std::min(index, points.size()));
+    this->pointsRevision.bump();
     this->sizeCalculated = false;
 }
 
 void Stroke::deletePoint(int index) {
     this->points.erase(std::next(begin(this->points), index));
+    this->pointsRevision.bump();
     this->sizeCalculated = false;
 }
 
@@ -291,7 +295,10 @@ Point Stroke::getPoint(PathParameter parameter) const {
 
 auto Stroke::getPoints() const -> const Point* { return this->points.data(); }
 
+auto Stroke::getPointsRevision() const -> const Revision& { return this->pointsRevision; }
+
 void Stroke::setPointVectorInternal(const Range* const snappingBox) {
+    this->pointsRevision.bump();
     if (!snappingBox || this->points.empty() || this->points.front().z != Point::NO_PRESSURE) {
         // We cannot deduce the bounding box from the snapping box if the stroke has pressure values
         this->sizeCalculated = false;
@@ -335,6 +342,7 @@ void Stroke::move(double dx, double dy) {
     Element::x += dx;
     Element::y += dy;
     Element::snappedBounds = Element::snappedBounds.translated(dx, dy);
+    this->pointsRevision.bump();
 }
 
 void Stroke::rotate(double x0, double y0, double th) {
@@ -345,6 +353,7 @@ void Stroke::rotate(double x0, double y0, double th) {
     cairo_matrix_translate(&rotMatrix, -x0, -y0);
 
     for (auto&& p: points) { cairo_matrix_transform_point(&rotMatrix, &p.x, &p.y); }
+    this->pointsRevision.bump();
     this->sizeCalculated = false;
     // Width and Height will likely be changed after this operation
 }
@@ -368,6 +377,7 @@ void Stroke::scale(double x0, double y0, double fx, double fy, double rotation,
     }
     this->width *= fz;
 
+    this->pointsRevision.bump();
     this->sizeCalculated = false;
 }
 
@@ -18,6 +18,7 @@
 #include "AudioElement.h"  // for AudioElement
 #include "LineStyle.h"     // for LineStyle
 #include "Point.h"         // for Point
+#include "Revision.h"      // for Revision
 
 class Element;
 class ObjectInputStream;
@@ -115,6 +116,12 @@ public:
     Point getPoint(PathParameter parameter) const;
     const Point* getPoints() const;
 
+    /**
+     * @brief Changed whenever the position of the points changes (pressure values are not considered)
+     * Used to invalidate the geometry cached by the views.
+     */
+    const Revision& getPointsRevision() const;
+
     /**
      * @brief Replace the stroke's points by the ones in the provided vector (they will be copied).
      * @param other New vector of points for the stroke
@@ -204,6 +211,8 @@ private:
     // The array with the points
     std::vector<Point> points{};
 
+    Revision pointsRevision;
+
     /**
      * Dashed line
      */
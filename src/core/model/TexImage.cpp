@@ -26,6 +26,8 @@ void TexImage::freeImageAndPdf() {
         g_object_unref(this->pdf);
         this->pdf = nullptr;
     }
+
+    this->parsed = false;
 }
 
 auto TexImage::clone() const -> Element* {
@@ -39,14 +41,9 @@ auto TexImage::clone() const -> Element* {
     img->snappedBounds = this->snappedBounds;
     img->sizeCalculated = this->sizeCalculated;
 
-    // Clone has a copy of our PDF.
-    img->pdf = this->pdf;
-    g_object_ref(this->pdf);
-
-    // Load a copy of our data (must be called after
-    // giving the clone a copy of our PDF -- it may change
-    // the PDF we've given it).
-    img->loadData(std::string(this->binaryData), nullptr);
+    // The clone shares our data, but parses its own PDF document (if it is ever drawn): poppler documents must not
+    // be used from several threads at the same time.
+    img->binaryData = this->binaryData;
 
     return img;
 }
@@ -61,48 +58,71 @@ void TexImage::setHeight(double height) {
     this->calcSize();
 }
 
-auto TexImage::cairoReadFunction(TexImage* image, unsigned char* data, unsigned int length) -> cairo_status_t {
-    for (unsigned int i = 0; i < length; i++, image->read++) {
-        if (image->read >= image->binaryData.length()) {
-            return CAIRO_STATUS_READ_ERROR;
-        }
-        data[i] = image->binaryData[image->read];
-    }
-
-    return CAIRO_STATUS_SUCCESS;
-}
-
 /**
  * Gets the binary data, a .PNG image or a .PDF
  */
-auto TexImage::getBinaryData() const -> std::string const& { return this->binaryData; }
+auto TexImage::getBinaryData() const -> std::string const& { return *this->binaryData->get(); }
 
 void TexImage::setText(std::string text) { this->text = std::move(text); }
 
 auto TexImage::getText() const -> std::string { return this->text; }
 
 auto TexImage::loadData(std::string&& bytes, GError** err) -> bool {
+    std::lock_guard lock(this->parseMutex);
+    this->freeImageAndPdf();
+    this->binaryData = std::make_shared<const LazyData>(std::move(bytes));
+    if (!parse(err)) {
+        return false;
+    }
+
+    if (this->pdf && !this->width && !this->height) {
+        PopplerPage* page = poppler_document_get_page(this->pdf, 0);
+        poppler_page_get_size(page, &this->width, &this->height);
+        g_object_unref(page);
+    }
+
+    return true;
+}
+
+void TexImage::setDataReader(LazyData::Reader reader) {
+    std::lock_guard lock(this->parseMutex);
     this->freeImageAndPdf();
-    this->binaryData = bytes;
-    if (this->binaryData.length() < 4) {
+    this->binaryData = std::make_shared<const LazyData>(std::move(reader));
+}
+
+auto TexImage::parse(GError** err) const -> bool {
+    this->parsed = true;
+
+    const std::string& bytes = *this->binaryData->get();
+    if (bytes.length() < 4) {
         return false;
     }
 
-    const std::string type = binaryData.substr(1, 3);
+    const std::string type = bytes.substr(1, 3);
     if (type == "PDF") {
-        // Note: binaryData must not be modified while pdf is live.
-        this->pdf = poppler_document_new_from_data(this->binaryData.data(), this->binaryData.size(), nullptr, err);
+        // Note: the data must not be modified while pdf is live. It is immutable and kept by binaryData.
+        this->pdf = poppler_document_new_from_data(const_cast<char*>(bytes.data()), static_cast<int>(bytes.size()),
+                                                   nullptr, err);
         if (!pdf || poppler_document_get_n_pages(this->pdf) < 1) {
             return false;
         }
-        if (!this->width && !this->height) {
-            PopplerPage* page = poppler_document_get_page(this->pdf, 0);
-            poppler_page_get_size(page, &this->width, &this->height);
-            g_object_unref(page);
-        }
     } else if (type == "PNG") {
-        this->image = cairo_image_surface_create_from_png_stream(
-                reinterpret_cast<cairo_read_func_t>(&cairoReadFunction), this);
+        struct {
+            const std::string* data;
+            std::string::size_type read;
+        } closure_{&bytes, 0};
+        const cairo_read_func_t readFunc = [](void* closurePtr, unsigned char* data,
+                                              unsigned int length) -> cairo_status_t {
+            auto& closure = *reinterpret_cast<decltype(&closure_)>(closurePtr);
+            for (unsigned int i = 0; i < length; i++, closure.read++) {
+                if (closure.read >= closure.data->length()) {
+                    return CAIRO_STATUS_READ_ERROR;
+                }
+                data[i] = static_cast<unsigned char>((*closure.data)[closure.read]);
+            }
+            return CAIRO_STATUS_SUCCESS;
+        };
+        this->image = cairo_image_surface_create_from_png_stream(readFunc, &closure_);
     } else {
         g_warning("Unknown Latex image type: \"%s\"", type.c_str());
     }
@@ -110,9 +130,21 @@ auto TexImage::loadData(std::string&& bytes, GError** err) -> bool {
     return true;
 }
 
-auto TexImage::getImage() const -> cairo_surface_t* { return this->image; }
+auto TexImage::getImage() const -> cairo_surface_t* {
+    std::lock_guard lock(this->parseMutex);
+    if (!this->parsed) {
+        parse();
+    }
+    return this->image;
+}
 
-auto TexImage::getPdf() const -> PopplerDocument* { return this->pdf; }
+auto TexImage::getPdf() const -> PopplerDocument* {
+    std::lock_guard lock(this->parseMutex);
+    if (!this->parsed) {
+        parse();
+    }
+    return this->pdf;
+}
 
 void TexImage::scale(double x0, double y0, double fx, double fy, double rotation,
                      bool) {  // line width scaling option is not used
@@ -138,7 +170,8 @@ void TexImage::serialize(ObjectOutputStream& out) const {
     out.writeDouble(this->height);
     out.writeString(this->text);
 
-    out.writeData(this->binaryData.c_str(), this->binaryData.length(), 1);
+    const std::string& data = *this->binaryData->get();
+    out.writeData(data.c_str(), static_cast<int>(data.length()), 1);
 
     out.endObject();
 }
@@ -11,13 +11,16 @@
 
 #pragma once
 
+#include <memory>  // for shared_ptr
+#include <mutex>   // for mutex
 #include <string>  // for string
 
 #include <cairo.h>    // for cairo_surface_t, cairo_status_t
 #include <glib.h>     // for GError
 #include <poppler.h>  // for PopplerDocument
 
-#include "Element.h"  // for Element
+#include "Element.h"   // for Element
+#include "LazyData.h"  // for LazyData
 
 class ObjectInputStream;
 class ObjectOutputStream;
@@ -43,6 +46,7 @@ public:
 
     /**
      * @return The image, if render source is PNG. Note: this is deprecated.
+     * The binary data is parsed if needed, as for getPdf().
      */
     cairo_surface_t* getImage() const;
 
@@ -67,6 +71,12 @@ public:
      */
     bool loadData(std::string&& bytes, GError** err = nullptr);
 
+    /**
+     * Set a function providing the binary data. The data is read and parsed when the image is first drawn, possibly
+     * from a render thread. The size of the image must be set.
+     */
+    void setDataReader(LazyData::Reader reader);
+
 public:
     // Serialize interface
     void serialize(ObjectOutputStream& out) const override;
@@ -75,7 +85,11 @@ public:
 private:
     void calcSize() const override;
 
-    static cairo_status_t cairoReadFunction(TexImage* image, unsigned char* data, unsigned int length);
+    /**
+     * Parses the binary data into the PDF document or the image, if not done yet
+     * @return false if the data could not be parsed
+     */
+    bool parse(GError** err = nullptr) const;
 
     /**
      * Free image and PDF
@@ -84,24 +98,25 @@ private:
 
 private:
     /**
-     * Tex PDF Document, if rendered as PDF
+     * Protects the lazily parsed pdf and image
      */
-    PopplerDocument* pdf = nullptr;
+    mutable std::mutex parseMutex;
+    mutable bool parsed = false;
 
     /**
-     * Tex image, if rendered as image. Note: this is deprecated and subject to removal in a later version.
+     * Tex PDF Document, if rendered as PDF
      */
-    cairo_surface_t* image = nullptr;
+    mutable PopplerDocument* pdf = nullptr;
 
     /**
-     * PNG Image / PDF Document
+     * Tex image, if rendered as image. Note: this is deprecated and subject to removal in a later version.
      */
-    std::string binaryData;
+    mutable cairo_surface_t* image = nullptr;
 
     /**
-     * Read position for PNG binaryData (deprecated).
+     * PNG Image / PDF Document, shared with the clones
      */
-    std::string::size_type read = 0;
+    std::shared_ptr<const LazyData> binaryData = std::make_shared<const LazyData>();
 
     /**
      * Tex String
@@ -1,6 +1,6 @@
 #include "XojPage.h"
 
-#include <algorithm>  // for find, transform
+#include <algorithm>  // for find, transform, max
 #include <iterator>   // for back_insert_iterator, back_inserter, begin
 #include <utility>    // for move
 
@@ -29,7 +29,9 @@ XojPage::XojPage(XojPage const& page):
         currentLayer(page.currentLayer),
         bgType(page.bgType),
         pdfBackgroundPage(page.pdfBackgroundPage),
-        backgroundColor(page.backgroundColor) {
+        backgroundColor(page.backgroundColor),
+        backgroundVisible(page.backgroundVisible),
+        backgroundName(page.backgroundName) {
     this->layer.reserve(page.layer.size());
     std::transform(begin(page.layer), end(page.layer), std::back_inserter(this->layer),
                    [](auto* layer) { return layer->clone(); });
@@ -37,9 +39,18 @@ XojPage::XojPage(XojPage const& page):
 
 auto XojPage::clone() -> XojPage* { return new XojPage(*this); }
 
+auto XojPage::getRevision() const -> uint64_t {
+    uint64_t rev = this->revision.get();
+    for (const Layer* l: this->layer) {
+        rev = std::max(rev, l->getRevision().get());
+    }
+    return rev;
+}
+
 void XojPage::addLayer(Layer* layer) {
     this->layer.push_back(layer);
     this->currentLayer = npos;
+    this->revision.bump();
 }
 
 void XojPage::insertLayer(Layer* layer, Layer::Index index) {
@@ -50,6 +61,7 @@ void XojPage::insertLayer(Layer* layer, Layer::Index index) {
 
     this->layer.insert(std::next(this->layer.begin(), static_cast<ptrdiff_t>(index)), layer);
     this->currentLayer = index + 1;
+    this->revision.bump();
 }
 
 void XojPage::removeLayer(Layer* l) {
@@ -57,6 +69,7 @@ void XojPage::removeLayer(Layer* l) {
         this->layer.erase(it);
     }
     this->currentLayer = npos;
+    this->revision.bump();
     // ensure at least one valid layer exists
     if (layer.empty()) {
         addLayer(new Layer());
@@ -83,6 +96,7 @@ auto XojPage::getSelectedLayerId() -> Layer::Index {
 void XojPage::setLayerVisible(Layer::Index layerId, bool visible) {
     if (layerId == 0) {
         backgroundVisible = visible;
+        this->revision.bump();
         return;
     }
 
@@ -111,15 +125,20 @@ void XojPage::setBackgroundPdfPageNr(size_t page) {
     this->pdfBackgroundPage = page;
     this->bgType.format = PageTypeFormat::Pdf;
     this->bgType.config = "";
+    this->revision.bump();
 }
 
-void XojPage::setBackgroundColor(Color color) { this->backgroundColor = color; }
+void XojPage::setBackgroundColor(Color color) {
+    this->backgroundColor = color;
+    this->revision.bump();
+}
 
 auto XojPage::getBackgroundColor() const -> Color { return this->backgroundColor; }
 
 void XojPage::setSize(double width, double height) {
     this->width = width;
     this->height = height;
+    this->revision.bump();
 }
 
 auto XojPage::getWidth() const -> double { return this->width; }
@@ -146,13 +165,17 @@ void XojPage::setBackgroundType(const PageType& bgType) {
     if (!bgType.isImagePage()) {
         this->backgroundImage.free();
     }
+    this->revision.bump();
 }
 
 auto XojPage::getBackgroundType() -> PageType { return this->bgType; }
 
 auto XojPage::getBackgroundImage() -> BackgroundImage& { return this->backgroundImage; }
 
-void XojPage::setBackgroundImage(BackgroundImage img) { this->backgroundImage = std::move(img); }
+void XojPage::setBackgroundImage(BackgroundImage img) {
+    this->backgroundImage = std::move(img);
+    this->revision.bump();
+}
 
 auto XojPage::getSelectedLayer() -> Layer* {
     g_assert(!layer.empty());
@@ -169,4 +192,7 @@ auto XojPage::getBackgroundName() const -> std::string { return backgroundName.v
 
 auto XojPage::backgroundHasName() const -> bool { return backgroundName.has_value(); }
 
-void XojPage::setBackgroundName(const std::string& newName) { backgroundName = newName; }
+void XojPage::setBackgroundName(const std::string& newName) {
+    backgroundName = newName;
+    this->revision.bump();
+}
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
 #include <optional>  // for optional
 #include <string>    // for string
 #include <vector>    // for vector
@@ -81,6 +82,12 @@ public:
      */
     XojPage* clone();
 
+    /**
+     * @return A stamp which changes whenever the page or one of its layers is modified.
+     * The document must be locked.
+     */
+    uint64_t getRevision() const;
+
 private:
     /**
      * The Background image if any
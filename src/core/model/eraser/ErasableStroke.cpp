@@ -4,6 +4,7 @@
 #include <cassert>    // for assert
 #include <cstddef>    // for size_t, ptrdiff_t
 #include <iterator>   // for next
+#include <memory>     // for make_unique
 #include <optional>   // for optional
 #include <tuple>      // for forward_as_tuple
 
@@ -122,25 +123,25 @@ void ErasableStroke::erase(const PaddedBox& box, Range& range) {
     }
 
     /**
-     * Determine which (intervals of) segments are still (partially) visible and have their bounding box intersecting
-     * the eraser square
+     * Determine which (intervals of) segments have their bounding box intersecting the padded eraser box, and are
+     * still (partially) visible.
      *
-     * This avoids computing a segment's intersections with the eraser box twice
+     * The segments just before and after such an interval lie outside the padded box: the intersections of the
+     * interval with the box are the same as those of the entire stroke.
      */
     std::vector<Interval<size_t>> indexIntervals;
 
-    for (const SubSection& section: sections) {
-        if (!getSubSectionBoundingBox(section).intersect(Range(box.getInnerRectangle())).empty()) {
-            if (indexIntervals.empty()) {
-                indexIntervals.emplace_back(section.min.index, section.max.index);
-            } else {
-                if (indexIntervals.back().max + 1 >= section.min.index) {
-                    // Merge together two sections if the first ends in the segment in which the second begins
-                    indexIntervals.back().envelop(section.max.index);
-                } else {
-                    indexIntervals.emplace_back(section.min.index, section.max.index);
-                }
-            }
+    auto itSection = sections.cbegin();
+    auto itSectionEnd = sections.cend();
+    for (const auto& i: getSegmentTree().getSegmentsIntersecting(box.getOuterRectangle())) {
+        while (itSection != itSectionEnd && itSection->max.index < i.min) {
+            ++itSection;
+        }
+        if (itSection == itSectionEnd) {
+            break;
+        }
+        if (itSection->min.index <= i.max) {
+            indexIntervals.emplace_back(i);
         }
     }
 
@@ -150,6 +151,12 @@ void ErasableStroke::erase(const PaddedBox& box, Range& range) {
         newErasedSections.appendData(this->stroke.intersectWithPaddedBox(box, i.min, i.max));
     }
 
+    // Only keep what was not erased yet
+    if (!newErasedSections.empty()) {
+        std::lock_guard<std::mutex> lock(sectionsMutex);
+        newErasedSections.intersect(remainingSections.getData());
+    }
+
     changesAtLastIteration = !newErasedSections.empty();
     if (changesAtLastIteration) {
 
@@ -313,44 +320,42 @@ auto ErasableStroke::computeSubSectionBoundingBox(const SubSection& section) con
 }
 
 void ErasableStroke::addOverlapsToRange(const std::vector<SubSection>& subsections, Range& range) {
-
-    // Will contain the intersection trees of the subsections
-    std::vector<OverlapTree> overlapTrees(subsections.size());
     /**
-     * For each given subsection, we compute a binary tree whose leaves correspond to individual segments in the
-     * subsection and contain the thin bounding box of the segments.
+     * The segment tree is a binary tree whose leaves correspond to individual segments of the stroke and contain the
+     * thin bounding box of the segments.
      * The nodes contain the union of the bounding boxes of their children, so that the root itself contains the
-     * bounding box of the subsection.
+     * bounding box of the stroke.
      *
-     * To compute the overlaps between two subsections, we intersect the bounding boxes in their trees, until we reach
-     * intersecting leaves.
+     * To compute the overlaps between two subsections, we intersect the bounding boxes in the tree, restricted to the
+     * segments of each subsection, until we reach intersecting leaves.
      * See ErasableStroke::OverlapTree for the details.
      */
+    const OverlapTree& tree = getSegmentTree();
 
     const double halfWidth = 0.5 * this->stroke.getWidth();
-    size_t i = 0;
-    size_t j = 0;
-    for (auto it1 = subsections.cbegin(), itEnd = subsections.cend(); it1 != itEnd; ++it1, ++i) {
-        j = i + 1;
-        for (auto it2 = std::next(it1); it2 != itEnd; ++it2, ++j) {
+    for (auto it1 = subsections.cbegin(), itEnd = subsections.cend(); it1 != itEnd; ++it1) {
+        for (auto it2 = std::next(it1); it2 != itEnd; ++it2) {
             if (!getSubSectionBoundingBox(*it1).intersect(getSubSectionBoundingBox(*it2)).empty()) {
-                // Compute the intersections trees if they have not yet been computed
-                if (!overlapTrees[i].isPopulated()) {
-                    overlapTrees[i].populate(*it1, this->stroke);
-                }
-                if (!overlapTrees[j].isPopulated()) {
-                    overlapTrees[j].populate(*it2, this->stroke);
-                }
 #ifdef DEBUG_ERASABLE_STROKE_BOXES
-                overlapTrees[i].addOverlapsToRange(overlapTrees[j], halfWidth, range, debugMask.get());
+                tree.addOverlapsToRange(*it1, *it2, halfWidth, range, debugMask.get());
 #else
-                overlapTrees[i].addOverlapsToRange(overlapTrees[j], halfWidth, range);
+                tree.addOverlapsToRange(*it1, *it2, halfWidth, range);
 #endif
             }
         }
     }
 }
 
+auto ErasableStroke::getSegmentTree() -> const OverlapTree& {
+    if (!this->segmentTree) {
+        const size_t n = this->stroke.getPointCount();
+        assert(n >= 2);
+        this->segmentTree = std::make_unique<OverlapTree>();
+        this->segmentTree->populate({{0, 0.0}, {n - 2, 1.0}}, this->stroke);
+    }
+    return *this->segmentTree;
+}
+
 #ifdef DEBUG_ERASABLE_STROKE_BOXES
 void ErasableStroke::paintDebugRect(const Rectangle<double>& rect, char color, cairo_t* cr) {
     if (cr == nullptr) {
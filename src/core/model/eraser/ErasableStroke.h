@@ -149,4 +149,15 @@ public:
      * Binary tree used for searching for overlaps between subsections
      */
     class OverlapTree;
+
+protected:
+    /**
+     * @brief Get the tree of all the segments of the stroke, populating it on first use
+     */
+    const OverlapTree& getSegmentTree();
+
+    /**
+     * @brief Tree of all the segments of the stroke, kept for the whole erasure
+     */
+    std::unique_ptr<OverlapTree> segmentTree;
 };
@@ -17,6 +17,7 @@ void ErasableStroke::OverlapTree::populate(const SubSection& section, const Stro
     Populator populator(this->data, stroke);
     populator.populate(section, this->root);
     populated = true;
+    this->stroke = &stroke;
 }
 
 bool ErasableStroke::OverlapTree::isPopulated() const { return populated; }
@@ -37,6 +38,112 @@ void ErasableStroke::OverlapTree::addOverlapsToRange(const ErasableStroke::Overl
 #endif
 }
 
+#ifdef DEBUG_ERASABLE_STROKE_BOXES
+void ErasableStroke::OverlapTree::addOverlapsToRange(const SubSection& first, const SubSection& second,
+                                                     double halfWidth, Range& range, cairo_t* cr) const {
+    assert(this->isPopulated());
+    this->addOverlapsToRange(this->root, Window(first), this->root, Window(second), halfWidth, range, cr);
+}
+#else
+void ErasableStroke::OverlapTree::addOverlapsToRange(const SubSection& first, const SubSection& second,
+                                                     double halfWidth, Range& range) const {
+    assert(this->isPopulated());
+    this->addOverlapsToRange(this->root, Window(first), this->root, Window(second), halfWidth, range);
+}
+#endif
+
+#ifdef DEBUG_ERASABLE_STROKE_BOXES
+void ErasableStroke::OverlapTree::addOverlapsToRange(const Node& node, const Window& window, const Node& otherNode,
+                                                     const Window& otherWindow, double halfWidth, Range& range,
+                                                     cairo_t* cr) const {
+#else
+void ErasableStroke::OverlapTree::addOverlapsToRange(const Node& node, const Window& window, const Node& otherNode,
+                                                     const Window& otherWindow, double halfWidth, Range& range) const {
+#endif
+    /**
+     * Same descent as in Node::addOverlapsToRange, skipping the nodes outside the windows.
+     * The boxes of the nodes partially outside the windows are too large, but the leaves are cropped to the windows,
+     * so that the result is the same as with trees populated on the subsections themselves.
+     */
+    if (!window.intersects(node) || !otherWindow.intersects(otherNode) || !node.intersects(otherNode, halfWidth)) {
+        return;
+    }
+    if (otherNode.children != nullptr) {
+#ifdef DEBUG_ERASABLE_STROKE_BOXES
+        addOverlapsToRange(node, window, otherNode.children->first, otherWindow, halfWidth, range, cr);
+        addOverlapsToRange(node, window, otherNode.children->second, otherWindow, halfWidth, range, cr);
+#else
+        addOverlapsToRange(node, window, otherNode.children->first, otherWindow, halfWidth, range);
+        addOverlapsToRange(node, window, otherNode.children->second, otherWindow, halfWidth, range);
+#endif
+        return;
+    }
+    if (node.children != nullptr) {
+#ifdef DEBUG_ERASABLE_STROKE_BOXES
+        addOverlapsToRange(node.children->first, window, otherNode, otherWindow, halfWidth, range, cr);
+        addOverlapsToRange(node.children->second, window, otherNode, otherWindow, halfWidth, range, cr);
+#else
+        addOverlapsToRange(node.children->first, window, otherNode, otherWindow, halfWidth, range);
+        addOverlapsToRange(node.children->second, window, otherNode, otherWindow, halfWidth, range);
+#endif
+        return;
+    }
+    // Both nodes are leaves
+#ifdef DEBUG_ERASABLE_STROKE_BOXES
+    cropLeaf(node, window).addOverlapsToRange(cropLeaf(otherNode, otherWindow), halfWidth, range, cr);
+#else
+    cropLeaf(node, window).addOverlapsToRange(cropLeaf(otherNode, otherWindow), halfWidth, range);
+#endif
+}
+
+ErasableStroke::OverlapTree::Window::Window(const SubSection& section):
+        section(section),
+        firstSegment(section.min.index),
+        lastSegment(section.max.t == 0.0 && section.max.index > section.min.index ? section.max.index - 1 :
+                                                                                     section.max.index) {}
+
+bool ErasableStroke::OverlapTree::Window::intersects(const Node& node) const {
+    return node.maxIndex >= firstSegment && node.minIndex <= lastSegment;
+}
+
+auto ErasableStroke::OverlapTree::cropLeaf(const Node& leaf, const Window& window) const -> Node {
+    assert(leaf.children == nullptr && leaf.minIndex == leaf.maxIndex);
+    const size_t index = leaf.minIndex;
+    const auto& pts = this->stroke->getPointVector();
+    const Point p1 = index == window.section.min.index ? this->stroke->getPoint(window.section.min) : pts[index];
+    const Point p2 = index == window.section.max.index ? this->stroke->getPoint(window.section.max) : pts[index + 1];
+    Node cropped;
+    cropped.initializeOnSegment(p1, p2, index);
+    return cropped;
+}
+
+auto ErasableStroke::OverlapTree::getSegmentsIntersecting(const Rectangle<double>& rect) const
+        -> std::vector<Interval<size_t>> {
+    assert(this->isPopulated());
+    std::vector<Interval<size_t>> segments;
+    addSegmentsIntersecting(this->root, rect, segments);
+    return segments;
+}
+
+void ErasableStroke::OverlapTree::addSegmentsIntersecting(const Node& node, const Rectangle<double>& rect,
+                                                          std::vector<Interval<size_t>>& segments) const {
+    if (node.maxX < rect.x || node.minX > rect.x + rect.width || node.maxY < rect.y ||
+        node.minY > rect.y + rect.height) {
+        return;
+    }
+    if (node.children != nullptr) {
+        // First child first, so that the segments are sorted
+        addSegmentsIntersecting(node.children->first, rect, segments);
+        addSegmentsIntersecting(node.children->second, rect, segments);
+        return;
+    }
+    if (!segments.empty() && segments.back().max + 1 == node.minIndex) {
+        segments.back().max = node.minIndex;
+    } else {
+        segments.emplace_back(node.minIndex, node.minIndex);
+    }
+}
+
 void ErasableStroke::OverlapTree::Populator::populate(const SubSection& section, Node& root) {
     assert(section.min.index <= section.max.index && section.max.index < stroke.getPointCount());
 
@@ -47,14 +154,16 @@ void ErasableStroke::OverlapTree::Populator::populate(const SubSection& section,
 
     if (section.min.index == section.max.index) {
         // The section spans on a single segment
-        root.initializeOnSegment(this->stroke.getPoint(section.min), this->stroke.getPoint(section.max));
+        root.initializeOnSegment(this->stroke.getPoint(section.min), this->stroke.getPoint(section.max),
+                                 section.min.index);
         return;
     }
 
     if (section.max.t == 0.0) {
         if (section.min.index + 1 == section.max.index) {
             // The section spans on a single segment
-            root.initializeOnSegment(this->stroke.getPoint(section.min), this->stroke.getPoint(section.max.index));
+            root.initializeOnSegment(this->stroke.getPoint(section.min), this->stroke.getPoint(section.max.index),
+                                     section.min.index);
             return;
         }
         if (section.min.t == 0.0) {
@@ -101,7 +210,7 @@ void ErasableStroke::OverlapTree::Populator::populateNode(Node& node, const Poin
     assert(min <= max && max < pts.size());
     if (min == max) {
         // The node corresponds to a single segment
-        node.initializeOnSegment(firstPoint, pts[min]);
+        node.initializeOnSegment(firstPoint, pts[min], min - 1);
         return;
     }
     /**
@@ -122,7 +231,7 @@ void ErasableStroke::OverlapTree::Populator::populateNode(Node& node, size_t min
     assert(min <= max && max < pts.size());
     if (min == max) {
         // The node corresponds to a single segment
-        node.initializeOnSegment(pts[min], lastPoint);
+        node.initializeOnSegment(pts[min], lastPoint, min);
         return;
     }
     /**
@@ -143,7 +252,7 @@ void ErasableStroke::OverlapTree::Populator::populateNode(Node& node, size_t min
     assert(max > min);
     if (min + 1 == max) {
         // The node corresponds to a single segment
-        node.initializeOnSegment(pts[min], pts[max]);
+        node.initializeOnSegment(pts[min], pts[max], min);
         return;
     }
     /**
@@ -159,9 +268,11 @@ void ErasableStroke::OverlapTree::Populator::populateNode(Node& node, size_t min
     node.computeBoxFromChildren();
 }
 
-void ErasableStroke::OverlapTree::Node::initializeOnSegment(const Point& p1, const Point& p2) {
+void ErasableStroke::OverlapTree::Node::initializeOnSegment(const Point& p1, const Point& p2, size_t index) {
     std::tie(this->minX, this->maxX) = std::minmax(p1.x, p2.x);
     std::tie(this->minY, this->maxY) = std::minmax(p1.y, p2.y);
+    this->minIndex = index;
+    this->maxIndex = index;
 }
 
 void ErasableStroke::OverlapTree::Node::computeBoxFromChildren() {
@@ -170,6 +281,13 @@ void ErasableStroke::OverlapTree::Node::computeBoxFromChildren() {
     maxX = std::max(children->first.maxX, children->second.maxX);
     minY = std::min(children->first.minY, children->second.minY);
     maxY = std::max(children->first.maxY, children->second.maxY);
+    minIndex = children->first.minIndex;
+    maxIndex = children->second.maxIndex;
+}
+
+bool ErasableStroke::OverlapTree::Node::intersects(const Node& other, double halfWidth) const {
+    return this->maxX + halfWidth > other.minX - halfWidth && this->minX - halfWidth < other.maxX + halfWidth &&
+           this->maxY + halfWidth > other.minY - halfWidth && this->minY - halfWidth < other.maxY + halfWidth;
 }
 
 #ifdef DEBUG_ERASABLE_STROKE_BOXES
@@ -178,10 +296,7 @@ void ErasableStroke::OverlapTree::Node::addOverlapsToRange(const Node& other, do
 #else
 void ErasableStroke::OverlapTree::Node::addOverlapsToRange(const Node& other, double halfWidth, Range& range) const {
 #endif
-    bool intersect = this->maxX + halfWidth > other.minX - halfWidth &&
-                     this->minX - halfWidth<other.maxX + halfWidth&& this->maxY + halfWidth> other.minY - halfWidth &&
-                     this->minY - halfWidth < other.maxY + halfWidth;
-    if (!intersect) {
+    if (!this->intersects(other, halfWidth)) {
         return;
     }
     if (other.children != nullptr) {
@@ -17,6 +17,7 @@
 
 #include <cairo.h>  // for cairo_t
 
+#include "util/Interval.h"   // for Interval
 #include "util/Rectangle.h"  // for Rectangle
 
 #include "ErasableStroke.h"  // for ErasableStroke::SubSection, ErasableStroke
@@ -26,6 +27,12 @@ class Point;
 class Range;
 class Stroke;
 
+/**
+ * Bounding volume hierarchy of the segments of a section of a stroke.
+ *
+ * ErasableStroke keeps a tree of the entire stroke for the whole erasure: it finds the segments under the eraser, and
+ * the overlaps between any two subsections, without building a tree for each new subsection.
+ */
 class ErasableStroke::OverlapTree {
 public:
     OverlapTree() = default;
@@ -37,6 +44,13 @@ public:
 
     bool isPopulated() const;
 
+    /**
+     * @brief Get the segments whose (thin) bounding box intersects a rectangle
+     * @param rect The rectangle
+     * @return Intervals [min, max] of indices of segments, sorted and separated by at least one index.
+     */
+    std::vector<Interval<size_t>> getSegmentsIntersecting(const xoj::util::Rectangle<double>& rect) const;
+
 #ifdef DEBUG_ERASABLE_STROKE_BOXES
     /**
      * @brief Add to a vector rectangles which altogether contain every overlap between the subsection corresponding
@@ -47,6 +61,13 @@ public:
      * @param cr A cairo context in which we paint the rectangles, for debug purposes
      */
     void addOverlapsToRange(const OverlapTree& other, double halfWidth, Range& range, cairo_t* cr = nullptr) const;
+
+    /**
+     * @brief Same as above, for the overlaps between two subsections contained in the section of this tree.
+     * @param cr A cairo context in which we paint the rectangles, for debug purposes
+     */
+    void addOverlapsToRange(const SubSection& first, const SubSection& second, double halfWidth, Range& range,
+                            cairo_t* cr = nullptr) const;
 #else
     /**
      * @brief Add to a vector rectangles which altogether contain every overlap between the subsection corresponding
@@ -56,6 +77,11 @@ public:
      * @param overlapBoxes the Rectangle vector to which we push
      */
     void addOverlapsToRange(const OverlapTree& other, double halfWidth, Range& range) const;
+
+    /**
+     * @brief Same as above, for the overlaps between two subsections contained in the section of this tree.
+     */
+    void addOverlapsToRange(const SubSection& first, const SubSection& second, double halfWidth, Range& range) const;
 #endif
 
 private:
@@ -95,6 +121,12 @@ private:
         double minY;
         double maxY;
 
+        /**
+         * Indices of the first and last segments of the stroke in the node
+         */
+        size_t minIndex;
+        size_t maxIndex;
+
         /**
          * Descendants, corresponding to the two halves of the subsection represented by the node
          */
@@ -104,14 +136,20 @@ private:
          * @brief Initialize the bounding box (minX, maxX, minY, maxY) when the node corresponds to a single segment
          * @param p1 The first endpoint of the segment
          * @param p2 The second endpoint of the segment
+         * @param index The index of the segment in the stroke
          */
-        void initializeOnSegment(const Point& p1, const Point& p2);
+        void initializeOnSegment(const Point& p1, const Point& p2, size_t index);
 
         /**
          * @brief Compute the node's bounding box by taking the union of the children's boxes
          */
         void computeBoxFromChildren();
 
+        /**
+         * @brief Test if the boxes of two nodes intersect, once padded with halfWidth
+         */
+        bool intersects(const Node& other, double halfWidth) const;
+
         /**
          * @brief Get a rectangle from the box (minX, maxX, minY, maxY), with an additional padding
          * @param padding Padding added to the box (typically, half the stroke's width)
@@ -119,10 +157,44 @@ private:
         xoj::util::Rectangle<double> toRectangle(double padding) const;
     };
 
+    /**
+     * @brief A subsection restricting a search in the tree, with the indices of its first and last segments
+     */
+    struct Window {
+        Window(const SubSection& section);
+
+        const SubSection& section;
+        size_t firstSegment;
+        size_t lastSegment;
+
+        bool intersects(const Node& node) const;
+    };
+
+    /**
+     * @brief Get a leaf, cropped to the part of its segment contained in the window
+     */
+    Node cropLeaf(const Node& leaf, const Window& window) const;
+
+#ifdef DEBUG_ERASABLE_STROKE_BOXES
+    void addOverlapsToRange(const Node& node, const Window& window, const Node& otherNode, const Window& otherWindow,
+                            double halfWidth, Range& range, cairo_t* cr) const;
+#else
+    void addOverlapsToRange(const Node& node, const Window& window, const Node& otherNode, const Window& otherWindow,
+                            double halfWidth, Range& range) const;
+#endif
+
+    void addSegmentsIntersecting(const Node& node, const xoj::util::Rectangle<double>& rect,
+                                 std::vector<Interval<size_t>>& segments) const;
+
     Node root;
     std::vector<std::pair<Node, Node>> data;
     bool populated = false;
 
+    /**
+     * The stroke the tree was populated from
+     */
+    const Stroke* stroke = nullptr;
+
     class Populator {
     public:
         Populator(std::vector<std::pair<Node, Node>>& data, const Stroke& stroke): data(data), stroke(stroke) {}
@@ -1,28 +1,28 @@
 #include "XojCairoPdfExport.h"
 
 #include <algorithm>  // for copy, min
+#include <atomic>     // for atomic
 #include <map>        // for map
-#include <memory>     // for __shared_ptr_access
+#include <memory>     // for __shared_ptr_access, make_shared
 #include <sstream>    // for ostringstream, operator<<
-#include <stack>      // for stack
-#include <utility>    // for pair, make_pair
 #include <vector>     // for vector
 
-#include <cairo-pdf.h>    // for cairo_pdf_surface_set_met...
-#include <glib-object.h>  // for g_object_unref
-
-#include "control/jobs/ProgressListener.h"  // for ProgressListener
-#include "model/Document.h"                 // for Document
-#include "model/Layer.h"                    // for Layer
-#include "model/LinkDestination.h"          // for LinkDestination, XojLinkDest
-#include "model/PageRef.h"                  // for PageRef
-#include "model/PageType.h"                 // for PageType
-#include "model/XojPage.h"                  // for XojPage
-#include "pdf/base/XojPdfPage.h"            // for XojPdfPageSPtr, XojPdfPage
-#include "util/Util.h"                      // for npos
-#include "util/i18n.h"                      // for _
-#include "util/serdesstream.h"              // for serdes_stream
-#include "view/DocumentView.h"              // for DocumentView
+#include <cairo-pdf.h>  // for cairo_pdf_surface_set_met...
+
+#include "control/jobs/ProgressListener.h"   // for ProgressListener
+#include "model/Document.h"                  // for Document
+#include "model/Layer.h"                     // for Layer
+#include "model/LinkDestination.h"           // for LinkDestination
+#include "model/PageRef.h"                   // for PageRef
+#include "model/PageType.h"                  // for PageType
+#include "model/XojPage.h"                   // for XojPage
+#include "pdf/base/XojPdfPage.h"             // for XojPdfPageSPtr, XojPdfPage
+#include "util/Util.h"                       // for npos
+#include "util/i18n.h"                       // for _
+#include "util/serdesstream.h"               // for serdes_stream
+#include "view/DocumentView.h"               // for DocumentView
+#include "view/View.h"                       // for COMPACT_PATHS
+#include "view/background/BackgroundView.h"  // for BackgroundFlags, HIDE_PDF_BACKGROUND
 
 #include "config.h"      // for PROJECT_STRING
 #include "filesystem.h"  // for path
@@ -50,59 +50,40 @@ auto XojCairoPdfExport::startPdf(const fs::path& file) -> bool {
 #if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 16, 0)
     cairo_pdf_surface_set_metadata(surface, CAIRO_PDF_METADATA_TITLE, doc->getFilepath().filename().u8string().c_str());
     cairo_pdf_surface_set_metadata(surface, CAIRO_PDF_METADATA_CREATOR, PROJECT_STRING);
-    GtkTreeModel* tocModel = doc->getContentsModel();
-    this->populatePdfOutline(tocModel);
+    auto outline = doc->getOutline();
+    if (!outline) {
+        // Still being read in the background by the document
+        std::atomic<bool> cancelled = false;
+        outline = std::make_shared<const DocumentOutline>(DocumentOutline::read(doc->getPdfDocument(), cancelled));
+    }
+    this->populatePdfOutline(outline->getEntries(), CAIRO_PDF_OUTLINE_ROOT);
 #endif
 
     return cairo_surface_status(this->surface) == CAIRO_STATUS_SUCCESS;
 }
 
 #if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 16, 0)
-void XojCairoPdfExport::populatePdfOutline(GtkTreeModel* tocModel) {
-    if (tocModel == nullptr)
-        return;
-
-    int idCounter = CAIRO_PDF_OUTLINE_ROOT;
-    std::stack<std::pair<GtkTreeIter, int>> nodeStack;
-
-    GtkTreeIter firstIter = {0};
-    if (!gtk_tree_model_get_iter_first(tocModel, &firstIter)) {
-        // Outline is empty, so do nothing.
-        return;
-    }
-
-    nodeStack.push(std::make_pair(firstIter, idCounter));
-    while (!nodeStack.empty()) {
-        auto [iter, parentId] = nodeStack.top();
-        nodeStack.pop();
-        const int currentId = ++idCounter;
-        XojLinkDest* link = nullptr;
-
-        gtk_tree_model_get(tocModel, &iter, DOCUMENT_LINKS_COLUMN_LINK, &link, -1);
-        auto dest = link->dest;
-        auto pdfBgPage = dest->getPdfPage();  // Link destination in original background PDF
+void XojCairoPdfExport::populatePdfOutline(const std::vector<DocumentOutline::Entry>& entries, int parentId) {
+    for (const DocumentOutline::Entry& entry: entries) {
+        const LinkDestination& dest = entry.dest;
+        auto pdfBgPage = dest.getPdfPage();  // Link destination in original background PDF
         auto pageDest = pdfBgPage == npos ? npos : doc->findPdfPage(pdfBgPage);  // Destination in document
+
+        int id = parentId;
         if (pageDest != npos) {
             auto linkAttrBuf = serdes_stream<std::ostringstream>();
             linkAttrBuf << "page=" << pageDest + 1;
-            if (dest->shouldChangeLeft() && dest->shouldChangeTop()) {
-                linkAttrBuf << " pos=[" << dest->getLeft() << " " << dest->getTop() << "]";
+            if (dest.shouldChangeLeft() && dest.shouldChangeTop()) {
+                linkAttrBuf << " pos=[" << dest.getLeft() << " " << dest.getTop() << "]";
             }
             const auto linkAttr = linkAttrBuf.str();
-            auto outlineFlags = dest->getExpand() ? CAIRO_PDF_OUTLINE_FLAG_OPEN : 0;
-            cairo_pdf_surface_add_outline(this->surface, parentId, link->dest->getName().data(), linkAttr.data(),
-                                          static_cast<cairo_pdf_outline_flags_t>(outlineFlags));
-        }
-        g_object_unref(link);
-
-        GtkTreeIter childIter;
-        if (gtk_tree_model_iter_children(tocModel, &childIter, &iter)) {
-            nodeStack.push(std::make_pair(childIter, currentId));
+            auto outlineFlags = dest.getExpand() ? CAIRO_PDF_OUTLINE_FLAG_OPEN : 0;
+            id = cairo_pdf_surface_add_outline(this->surface, parentId, dest.getName().data(), linkAttr.data(),
+                                               static_cast<cairo_pdf_outline_flags_t>(outlineFlags));
         }
 
-        if (gtk_tree_model_iter_next(tocModel, &iter)) {
-            nodeStack.push(std::make_pair(iter, parentId));
-        }
+        // The children of a missing page are attached to its parent
+        populatePdfOutline(entry.children, id);
     }
 }
 #endif
@@ -120,6 +101,8 @@ void XojCairoPdfExport::exportPage(size_t page) {
     cairo_pdf_surface_set_size(this->surface, p->getWidth(), p->getHeight());
 
     DocumentView view;
+    // One filled outline per pressure stroke, and one path per run of identical plain strokes
+    view.setPathCompaction(xoj::view::COMPACT_PATHS);
 
     cairo_save(this->cr);
 
@@ -131,13 +114,17 @@ void XojCairoPdfExport::exportPage(size_t page) {
         popplerPage->renderForPrinting(cr);
     }
 
+    // Identical backgrounds are written once to the PDF, and referenced by the pages
+    xoj::view::BackgroundFlags bgFlags;
+    bgFlags.showPDF = xoj::view::HIDE_PDF_BACKGROUND;  // already rendered by poppler
+    bgFlags.showImage = (xoj::view::ImageBackgroundTreatment)(exportBackground != EXPORT_BACKGROUND_NONE);
+    bgFlags.showRuling = (xoj::view::RulingBackgroundTreatment)(exportBackground > EXPORT_BACKGROUND_UNRULED);
+    this->backgrounds.draw(p, this->cr, bgFlags);
+
     if (layerRange) {
-        view.drawLayersOfPage(*layerRange, p, this->cr, true /* dont render eraseable */,
-                              true /* don't rerender the pdf background */, exportBackground == EXPORT_BACKGROUND_NONE,
-                              exportBackground <= EXPORT_BACKGROUND_UNRULED);
+        view.drawLayerRangeOfPage(*layerRange, p, this->cr, true /* dont render eraseable */);
     } else {
-        view.drawPage(p, this->cr, true /* dont render eraseable */, true /* don't rerender the pdf background */,
-                      exportBackground == EXPORT_BACKGROUND_NONE, exportBackground <= EXPORT_BACKGROUND_UNRULED);
+        view.drawPageLayers(p, this->cr, true /* dont render eraseable */);
     }
 
     // next page
@@ -13,12 +13,14 @@
 
 #include <cstddef>  // for size_t
 #include <string>   // for string
+#include <vector>   // for vector
 
-#include <cairo.h>    // for CAIRO_VERSION, CAIRO_VERSION...
-#include <gtk/gtk.h>  // for GtkTreeModel
+#include <cairo.h>  // for CAIRO_VERSION, CAIRO_VERSION...
 
-#include "control/jobs/BaseExportJob.h"  // for ExportBackgroundType, EXPORT...
-#include "util/ElementRange.h"           // for PageRangeVector
+#include "control/jobs/BaseExportJob.h"          // for ExportBackgroundType, EXPORT...
+#include "model/DocumentOutline.h"               // for DocumentOutline
+#include "util/ElementRange.h"                   // for PageRangeVector
+#include "view/background/BackgroundRecorder.h"  // for BackgroundRecorder
 
 #include "XojPdfExport.h"  // for XojPdfExport
 #include "filesystem.h"    // for path
@@ -50,9 +52,10 @@ private:
      *
      * This requires features available only in cairo 1.16 or newer.
      *
-     * @param tocModel The Document's content model. Does nothing if set to null.
+     * @param entries The entries of the Document's outline
+     * @param parentId The outline item to add the entries to
      */
-    void populatePdfOutline(GtkTreeModel* tocModel);
+    void populatePdfOutline(const std::vector<DocumentOutline::Entry>& entries, int parentId);
 #endif
     void endPdf();
     void exportPage(size_t page);
@@ -76,6 +79,11 @@ private:
 
     ExportBackgroundType exportBackground = EXPORT_BACKGROUND_ALL;
 
+    /**
+     * The backgrounds written to the PDF
+     */
+    xoj::view::BackgroundRecorder backgrounds;
+
     std::string lastError;
 
     std::unique_ptr<LayerRangeVector> layerRange;
@@ -0,0 +1,61 @@
+#include "XojPdfLinkMap.h"
+
+#include <algorithm>  // for lower_bound, upper_bound, sort, unique, min, max
+#include <utility>    // for move
+
+namespace {
+auto contains(const XojPdfRectangle& r, double x, double y) -> bool {
+    return r.x1 <= x && x <= r.x2 && r.y1 <= y && y <= r.y2;
+}
+}  // namespace
+
+XojPdfLinkMap::XojPdfLinkMap(std::vector<XojPdfPage::Link> pageLinks): links(std::move(pageLinks)) {
+    if (links.empty()) {
+        return;
+    }
+
+    for (auto& link: links) {
+        XojPdfRectangle& r = link.bounds;
+        r = XojPdfRectangle(std::min(r.x1, r.x2), std::min(r.y1, r.y2), std::max(r.x1, r.x2), std::max(r.y1, r.y2));
+        bandEdges.push_back(r.y1);
+        bandEdges.push_back(r.y2);
+    }
+    std::sort(bandEdges.begin(), bandEdges.end());
+    bandEdges.erase(std::unique(bandEdges.begin(), bandEdges.end()), bandEdges.end());
+
+    // A single (empty) band if all the links are flat, at the same height
+    bands.resize(std::max<size_t>(bandEdges.size() - 1, 1));
+    for (size_t n = 0; n < links.size(); n++) {
+        const XojPdfRectangle& r = links[n].bounds;
+        // The bands crossed by the link, and the band starting at its bottom edge (where the points of the edge are)
+        const auto first = static_cast<size_t>(std::lower_bound(bandEdges.begin(), bandEdges.end(), r.y1) -
+                                               bandEdges.begin());
+        const auto last = std::min(static_cast<size_t>(std::lower_bound(bandEdges.begin(), bandEdges.end(), r.y2) -
+                                                       bandEdges.begin()),
+                                   bands.size() - 1);
+        for (size_t i = first; i <= last; i++) {
+            bands[i].push_back(n);
+        }
+    }
+}
+
+auto XojPdfLinkMap::findLink(double x, double y) const -> const XojPdfPage::Link* {
+    if (links.empty() || y < bandEdges.front() || y > bandEdges.back()) {
+        return nullptr;
+    }
+
+    auto band = static_cast<size_t>(std::upper_bound(bandEdges.begin(), bandEdges.end(), y) - bandEdges.begin());
+    band = std::min(band > 0 ? band - 1 : 0, bands.size() - 1);
+    for (size_t n: bands[band]) {
+        if (contains(links[n].bounds, x, y)) {
+            return &links[n];
+        }
+    }
+    return nullptr;
+}
+
+auto XojPdfLinkMap::getLinks() const -> const std::vector<XojPdfPage::Link>& { return links; }
+
+auto XojPdfLinkMap::size() const -> size_t { return links.size(); }
+
+auto XojPdfLinkMap::empty() const -> bool { return links.empty(); }
@@ -0,0 +1,51 @@
+/*
+ * Xournal++
+ *
+ * The links of a PDF page, indexed for hit testing
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+#include "XojPdfPage.h"  // for XojPdfPage::Link
+
+/**
+ * @brief The links of a PDF page, extracted once (see XojPdfPage::getLinkMap())
+ *
+ * The page is cut into horizontal bands at the top and bottom edges of the links, each band knowing the links
+ * crossing it: a lookup is a binary search for the band, followed by a scan of its few links.
+ *
+ * The coordinates are in PDF points, with the origin at the top left corner of the page.
+ */
+class XojPdfLinkMap {
+public:
+    XojPdfLinkMap() = default;
+    explicit XojPdfLinkMap(std::vector<XojPdfPage::Link> links);
+
+public:
+    /**
+     * @return The link whose area contains the point (borders included), or nullptr. If several links contain it, the
+     * first one of the page.
+     */
+    const XojPdfPage::Link* findLink(double x, double y) const;
+
+    const std::vector<XojPdfPage::Link>& getLinks() const;
+    size_t size() const;
+    bool empty() const;
+
+private:
+    std::vector<XojPdfPage::Link> links;
+
+    /// The sorted top and bottom edges of the links. Band i goes from bandEdges[i] to bandEdges[i + 1].
+    std::vector<double> bandEdges;
+
+    /// For each band, the indices of the links crossing (or touching) it, in page order
+    std::vector<std::vector<size_t>> bands;
+};
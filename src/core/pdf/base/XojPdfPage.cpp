@@ -1,3 +1,50 @@
 #include "XojPdfPage.h"
 
+#include <memory>   // for make_shared
+#include <utility>  // for move
+
+#include "XojPdfLinkMap.h"     // for XojPdfLinkMap
+#include "XojPdfTextLayout.h"  // for XojPdfTextLayout
+
 XojPdfRectangle::XojPdfRectangle(double x1, double y1, double x2, double y2): x1(x1), y1(y1), x2(x2), y2(y2) {}
+
+XojPdfPage::XojPdfPage(XojPdfPageCacheSPtr cache): cache(std::move(cache)) {}
+
+auto XojPdfPage::selectText(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) -> std::string {
+    return getTextLayout()->selectText(rect, style);
+}
+
+auto XojPdfPage::selectTextRegion(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style)
+        -> xoj::util::CairoRegionSPtr {
+    return getTextLayout()->selectTextRegion(rect, style);
+}
+
+auto XojPdfPage::selectTextLines(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) -> TextSelection {
+    return getTextLayout()->selectTextLines(rect, style);
+}
+
+auto XojPdfPage::getTextLayout() -> std::shared_ptr<const XojPdfTextLayout> {
+    std::lock_guard<std::mutex> lock(this->cache->textLayoutMutex);
+    if (!this->cache->textLayout) {
+        this->cache->textLayout = std::make_shared<const XojPdfTextLayout>(readTextLayout());
+    }
+    return this->cache->textLayout;
+}
+
+auto XojPdfPage::getCachedTextLayout() -> std::shared_ptr<const XojPdfTextLayout> {
+    std::unique_lock<std::mutex> lock(this->cache->textLayoutMutex, std::try_to_lock);
+    return lock.owns_lock() ? this->cache->textLayout : nullptr;
+}
+
+auto XojPdfPage::getLinkMap() -> std::shared_ptr<const XojPdfLinkMap> {
+    std::lock_guard<std::mutex> lock(this->cache->linkMapMutex);
+    if (!this->cache->linkMap) {
+        this->cache->linkMap = std::make_shared<const XojPdfLinkMap>(getLinks());
+    }
+    return this->cache->linkMap;
+}
+
+auto XojPdfPage::getCachedLinkMap() -> std::shared_ptr<const XojPdfLinkMap> {
+    std::unique_lock<std::mutex> lock(this->cache->linkMapMutex, std::try_to_lock);
+    return lock.owns_lock() ? this->cache->linkMap : nullptr;
+}
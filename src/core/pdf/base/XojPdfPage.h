@@ -13,6 +13,7 @@
 
 #include <cinttypes>  // for uint8_t
 #include <memory>     // for shared_ptr
+#include <mutex>      // for mutex
 #include <string>     // for string
 #include <vector>     // for vector
 
@@ -23,6 +24,8 @@
 #include "XojPdfAction.h"
 
 class XojPdfLink;
+class XojPdfLinkMap;
+class XojPdfTextLayout;
 
 /// Determines how text is selected on a user action.
 enum class XojPdfPageSelectionStyle : uint8_t {
@@ -48,6 +51,22 @@ public:
     double y2 = -1;
 };
 
+/**
+ * @brief The data extracted from a PDF page
+ *
+ * It is kept by the document, by page number: the XojPdfPage objects are created on each XojPdfDocument::getPage()
+ * call, and the data must outlive them.
+ */
+struct XojPdfPageCache {
+    std::mutex textLayoutMutex;
+    std::shared_ptr<const XojPdfTextLayout> textLayout;
+
+    std::mutex linkMapMutex;
+    std::shared_ptr<const XojPdfLinkMap> linkMap;
+};
+
+using XojPdfPageCacheSPtr = std::shared_ptr<XojPdfPageCache>;
+
 class XojPdfPage {
 public:
     struct TextSelection {
@@ -81,30 +100,69 @@ public:
     /// @param rect start and end points
     /// @param style The text selection style
     /// @return The selected text.
-    virtual std::string selectText(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) = 0;
+    std::string selectText(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style);
 
     /// Retrieve the cairo_region_t that encompasses the text that would be
     /// selected in the given rectangle with the given text selection style.
     /// @param rect start and end points
     /// @param style The text selection style
     /// @return A region that contains the text that would be selected.
-    virtual cairo_region_t* selectTextRegion(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) = 0;
+    xoj::util::CairoRegionSPtr selectTextRegion(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style);
 
     /// Retrieve the set of rectangles that represent each line of text selected
     /// in the given rectangle with the given text selection style.
     /// @param rect start and end points
     /// @param style The text selection style
     /// @return The rectangles that cover the text that would be selected.
-    virtual TextSelection selectTextLines(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) = 0;
+    TextSelection selectTextLines(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style);
+
+    /**
+     * @brief The text layout of the page, used by the text selection methods above.
+     * It is extracted on the first call, which may happen in a worker thread, and then cached by the document (see
+     * XojPdfPageCache). Blocks while another thread extracts it.
+     */
+    std::shared_ptr<const XojPdfTextLayout> getTextLayout();
+
+    /**
+     * @return The text layout of the page if it was already extracted, nullptr otherwise. Does not block.
+     */
+    std::shared_ptr<const XojPdfTextLayout> getCachedTextLayout();
 
     /**
-     * @return A list of Links in the current page.
+     * @return A list of Links in the current page. Extracted from the PDF on each call: see getLinkMap().
      */
     virtual auto getLinks() -> std::vector<Link> = 0;
 
+    /**
+     * @brief The links of the page, indexed for hit testing.
+     * Extracted on the first call, which may happen in a worker thread, and then cached by the document (see
+     * XojPdfPageCache). Blocks while another thread extracts them.
+     */
+    std::shared_ptr<const XojPdfLinkMap> getLinkMap();
+
+    /**
+     * @return The links of the page if they were already extracted, nullptr otherwise. Does not block.
+     */
+    std::shared_ptr<const XojPdfLinkMap> getCachedLinkMap();
+
     virtual int getPageId() const = 0;
 
+protected:
+    /**
+     * @param cache The data of the page, shared by all the XojPdfPage objects of this page
+     */
+    explicit XojPdfPage(XojPdfPageCacheSPtr cache);
+    /// The copy shares the cache
+    XojPdfPage(const XojPdfPage& other) = default;
+    XojPdfPage& operator=(const XojPdfPage& other) = default;
+
+    /**
+     * @brief Extract the characters of the page and their bounding boxes, in reading order
+     */
+    virtual XojPdfTextLayout readTextLayout() const = 0;
+
 private:
+    XojPdfPageCacheSPtr cache;
 };
 
 typedef std::shared_ptr<XojPdfPage> XojPdfPageSPtr;
@@ -0,0 +1,195 @@
+#include "XojPdfTextLayout.h"
+
+#include <algorithm>  // for min, max
+#include <cctype>     // for isspace
+#include <cmath>      // for floor, ceil
+#include <limits>     // for numeric_limits
+#include <sstream>    // for ostringstream
+#include <utility>    // for move
+
+#include <cairo.h>  // for cairo_region_create, cairo_region_union_rectangle
+
+namespace {
+/**
+ * @return The rectangle with x1 <= x2 and y1 <= y2. Selection rectangles are given by their start and end points.
+ */
+auto properRect(const XojPdfRectangle& r) -> XojPdfRectangle {
+    return {std::min(r.x1, r.x2), std::min(r.y1, r.y2), std::max(r.x1, r.x2), std::max(r.y1, r.y2)};
+}
+
+auto unite(const XojPdfRectangle& a, const XojPdfRectangle& b) -> XojPdfRectangle {
+    return {std::min(a.x1, b.x1), std::min(a.y1, b.y1), std::max(a.x2, b.x2), std::max(a.y2, b.y2)};
+}
+
+auto intersects(const XojPdfRectangle& a, const XojPdfRectangle& b) -> bool {
+    return std::min(a.x2, b.x2) > std::max(a.x1, b.x1) && std::min(a.y2, b.y2) > std::max(a.y1, b.y1);
+}
+
+/**
+ * @return The distance from the point to the rectangle (0 inside)
+ */
+auto distance(const XojPdfRectangle& r, double x, double y) -> double {
+    const double dx = std::max({r.x1 - x, 0.0, x - r.x2});
+    const double dy = std::max({r.y1 - y, 0.0, y - r.y2});
+    return std::hypot(dx, dy);
+}
+}  // namespace
+
+XojPdfTextLayout::XojPdfTextLayout(std::vector<Glyph> chars) {
+    this->glyphs.reserve(chars.size());
+    size_t begin = 0;
+    auto endLine = [&]() {
+        if (begin < this->glyphs.size()) {
+            Line line{begin, this->glyphs.size(), this->glyphs[begin].box};
+            for (size_t i = begin; i < line.end; i++) {
+                line.box = unite(line.box, this->glyphs[i].box);
+            }
+            this->lines.push_back(line);
+        }
+        begin = this->glyphs.size();
+    };
+
+    for (Glyph& g: chars) {
+        if (g.text == "\n") {
+            endLine();
+        } else {
+            g.box = properRect(g.box);
+            this->glyphs.push_back(std::move(g));
+        }
+    }
+    endLine();
+}
+
+auto XojPdfTextLayout::getGlyphs() const -> const std::vector<Glyph>& { return glyphs; }
+
+auto XojPdfTextLayout::getLineCount() const -> size_t { return lines.size(); }
+
+auto XojPdfTextLayout::empty() const -> bool { return glyphs.empty(); }
+
+auto XojPdfTextLayout::positionAt(double x, double y) const -> Position {
+    size_t nearest = 0;
+    double nearestDistance = std::numeric_limits<double>::max();
+    for (size_t l = 0; l < lines.size(); l++) {
+        const double d = distance(lines[l].box, x, y);
+        if (d < nearestDistance) {
+            nearest = l;
+            nearestDistance = d;
+            if (d == 0) {
+                break;
+            }
+        }
+    }
+
+    const Line& line = lines[nearest];
+    size_t glyph = line.begin;
+    while (glyph < line.end && (glyphs[glyph].box.x1 + glyphs[glyph].box.x2) / 2 < x) {
+        glyph++;
+    }
+    return {nearest, glyph};
+}
+
+auto XojPdfTextLayout::isWordSeparator(size_t glyph) const -> bool {
+    const std::string& text = glyphs[glyph].text;
+    return text.size() == 1 && std::isspace(static_cast<unsigned char>(text[0]));
+}
+
+auto XojPdfTextLayout::selectSpans(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const
+        -> std::vector<Span> {
+    std::vector<Span> spans;
+    if (lines.empty()) {
+        return spans;
+    }
+
+    if (style == XojPdfPageSelectionStyle::Area) {
+        // The runs of glyphs intersecting the area
+        const XojPdfRectangle area = properRect(rect);
+        for (size_t l = 0; l < lines.size(); l++) {
+            const Line& line = lines[l];
+            if (!intersects(line.box, area)) {
+                continue;
+            }
+            for (size_t i = line.begin; i < line.end; i++) {
+                if (!intersects(glyphs[i].box, area)) {
+                    continue;
+                }
+                if (!spans.empty() && spans.back().line == l && spans.back().end == i) {
+                    spans.back().end++;
+                } else {
+                    spans.push_back({l, i, i + 1});
+                }
+            }
+        }
+        return spans;
+    }
+
+    // All the text between the start and end positions, in reading order
+    Position start = std::min(positionAt(rect.x1, rect.y1), positionAt(rect.x2, rect.y2));
+    Position end = std::max(positionAt(rect.x1, rect.y1), positionAt(rect.x2, rect.y2));
+
+    if (style == XojPdfPageSelectionStyle::Word) {
+        const Line& first = lines[start.first];
+        while (start.second > first.begin && !isWordSeparator(start.second - 1)) {
+            start.second--;
+        }
+        const Line& last = lines[end.first];
+        while (end.second < last.end && !isWordSeparator(end.second)) {
+            end.second++;
+        }
+    } else if (style == XojPdfPageSelectionStyle::Line) {
+        start.second = lines[start.first].begin;
+        end.second = lines[end.first].end;
+    }
+
+    for (size_t l = start.first; l <= end.first; l++) {
+        const size_t begin = l == start.first ? start.second : lines[l].begin;
+        const size_t stop = l == end.first ? end.second : lines[l].end;
+        if (begin < stop) {
+            spans.push_back({l, begin, stop});
+        }
+    }
+    return spans;
+}
+
+auto XojPdfTextLayout::getBox(const Span& span) const -> XojPdfRectangle {
+    XojPdfRectangle box = glyphs[span.begin].box;
+    for (size_t i = span.begin + 1; i < span.end; i++) {
+        box = unite(box, glyphs[i].box);
+    }
+    return box;
+}
+
+auto XojPdfTextLayout::selectText(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const -> std::string {
+    std::ostringstream ss;
+    const std::vector<Span> spans = selectSpans(rect, style);
+    for (size_t s = 0; s < spans.size(); s++) {
+        if (s > 0 && spans[s].line != spans[s - 1].line) {
+            ss << '\n';
+        }
+        for (size_t i = spans[s].begin; i < spans[s].end; i++) {
+            ss << glyphs[i].text;
+        }
+    }
+    return ss.str();
+}
+
+auto XojPdfTextLayout::selectTextRegion(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const
+        -> xoj::util::CairoRegionSPtr {
+    return selectTextLines(rect, style).region;
+}
+
+auto XojPdfTextLayout::selectTextLines(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const
+        -> XojPdfPage::TextSelection {
+    XojPdfPage::TextSelection selection{xoj::util::CairoRegionSPtr(cairo_region_create(), xoj::util::adopt), {}};
+    for (const Span& span: selectSpans(rect, style)) {
+        const XojPdfRectangle box = getBox(span);
+        selection.rects.push_back(box);
+
+        cairo_rectangle_int_t crect;
+        crect.x = static_cast<int>(std::floor(box.x1));
+        crect.y = static_cast<int>(std::floor(box.y1));
+        crect.width = static_cast<int>(std::ceil(box.x2)) - crect.x;
+        crect.height = static_cast<int>(std::ceil(box.y2)) - crect.y;
+        cairo_region_union_rectangle(selection.region.get(), &crect);
+    }
+    return selection;
+}
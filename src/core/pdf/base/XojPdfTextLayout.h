@@ -0,0 +1,101 @@
+/*
+ * Xournal++
+ *
+ * Text layout of a PDF page, for text selections
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <string>   // for string
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "util/raii/CairoWrappers.h"  // for CairoRegionSPtr
+
+#include "XojPdfPage.h"  // for XojPdfRectangle, XojPdfPageSelectionStyle, XojPdfPage::TextSelection
+
+/**
+ * @brief The characters of a PDF page with their bounding boxes, grouped in lines and words
+ *
+ * The layout is extracted once per page (see XojPdfPage::getTextLayout()). The text selections are then computed from
+ * it, without querying the PDF backend again on every pointer motion.
+ *
+ * The coordinates are in PDF points, with the origin at the top left corner of the page.
+ */
+class XojPdfTextLayout {
+public:
+    struct Glyph {
+        XojPdfRectangle box;
+        /// The UTF-8 encoded character
+        std::string text;
+    };
+
+    XojPdfTextLayout() = default;
+
+    /**
+     * @param glyphs The characters of the page, in reading order. The line breaks ("\n") end the lines, they are not
+     *               kept as glyphs.
+     */
+    explicit XojPdfTextLayout(std::vector<Glyph> glyphs);
+
+public:
+    const std::vector<Glyph>& getGlyphs() const;
+    size_t getLineCount() const;
+    bool empty() const;
+
+    /// See XojPdfPage::selectText()
+    std::string selectText(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const;
+
+    /// See XojPdfPage::selectTextRegion()
+    xoj::util::CairoRegionSPtr selectTextRegion(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const;
+
+    /// See XojPdfPage::selectTextLines()
+    XojPdfPage::TextSelection selectTextLines(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const;
+
+private:
+    struct Line {
+        /// The glyphs [begin, end) of the line
+        size_t begin;
+        size_t end;
+        XojPdfRectangle box;
+    };
+
+    /**
+     * @brief Selected glyphs [begin, end) of a line
+     */
+    struct Span {
+        size_t line;
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * A position between two glyphs: {line index, index of the glyph after the position}
+     */
+    using Position = std::pair<size_t, size_t>;
+
+    /**
+     * @return The position closest to the point: on the nearest line, before the first glyph whose center is right of
+     * the point.
+     */
+    Position positionAt(double x, double y) const;
+
+    bool isWordSeparator(size_t glyph) const;
+
+    /**
+     * @return The selected glyphs, line by line, in reading order
+     */
+    std::vector<Span> selectSpans(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) const;
+
+    XojPdfRectangle getBox(const Span& span) const;
+
+private:
+    std::vector<Glyph> glyphs;
+    std::vector<Line> lines;
+};
@@ -1,6 +1,7 @@
 #include "PopplerGlibDocument.h"
 
 #include <memory>    // for make_shared
+#include <mutex>     // for lock_guard
 #include <optional>  // for optional
 
 #include <poppler-document.h>  // for poppler_document_get_n_...
@@ -17,7 +18,8 @@ using std::string;
 
 PopplerGlibDocument::PopplerGlibDocument() = default;
 
-PopplerGlibDocument::PopplerGlibDocument(const PopplerGlibDocument& doc): document(doc.document) {
+PopplerGlibDocument::PopplerGlibDocument(const PopplerGlibDocument& doc):
+        document(doc.document), pageCaches(doc.pageCaches) {
     if (document) {
         g_object_ref(document);
     }
@@ -31,14 +33,17 @@ PopplerGlibDocument::~PopplerGlibDocument() {
 }
 
 void PopplerGlibDocument::assign(XojPdfDocumentInterface* doc) {
+    auto* other = dynamic_cast<PopplerGlibDocument*>(doc);
+
     if (document) {
         g_object_unref(document);
     }
 
-    document = (dynamic_cast<PopplerGlibDocument*>(doc))->document;
+    document = other->document;
     if (document) {
         g_object_ref(document);
     }
+    pageCaches = other->pageCaches;
 }
 
 auto PopplerGlibDocument::equals(XojPdfDocumentInterface* doc) const -> bool {
@@ -67,6 +72,7 @@ auto PopplerGlibDocument::load(fs::path const& file, string password, GError** e
         g_object_unref(document);
         document = nullptr;
     }
+    this->pageCaches = std::make_shared<PageCaches>();
 
     this->document = poppler_document_new_from_file(uri->c_str(), password.c_str(), error);
     return this->document != nullptr;
@@ -76,6 +82,7 @@ auto PopplerGlibDocument::load(gpointer data, gsize length, string password, GEr
     if (document) {
         g_object_unref(document);
     }
+    this->pageCaches = std::make_shared<PageCaches>();
 
     this->document =
             poppler_document_new_from_data(static_cast<char*>(data), static_cast<int>(length), password.c_str(), error);
@@ -90,12 +97,28 @@ auto PopplerGlibDocument::getPage(size_t page) const -> XojPdfPageSPtr {
     }
 
     PopplerPage* pg = poppler_document_get_page(document, int(page));
-    XojPdfPageSPtr pageptr = std::make_shared<PopplerGlibPage>(pg, document);
+    XojPdfPageSPtr pageptr = std::make_shared<PopplerGlibPage>(pg, document, getPageCache(page));
     g_object_unref(pg);
 
     return pageptr;
 }
 
+auto PopplerGlibDocument::getPageCache(size_t page) const -> XojPdfPageCacheSPtr {
+    std::lock_guard<std::mutex> lock(this->pageCaches->mutex);
+    auto& caches = this->pageCaches->pages;
+    if (caches.empty()) {
+        caches.resize(size_t(poppler_document_get_n_pages(document)));
+    }
+    if (page >= caches.size()) {
+        // Invalid page: nothing to share
+        return std::make_shared<XojPdfPageCache>();
+    }
+    if (!caches[page]) {
+        caches[page] = std::make_shared<XojPdfPageCache>();
+    }
+    return caches[page];
+}
+
 auto PopplerGlibDocument::getPageCount() const -> size_t {
     if (document == nullptr) {
         return 0;
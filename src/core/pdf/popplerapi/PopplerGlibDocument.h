@@ -12,7 +12,10 @@
 #pragma once
 
 #include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr, make_shared
+#include <mutex>    // for mutex
 #include <string>   // for string
+#include <vector>   // for vector
 
 #include <glib.h>     // for GError, gpointer, gsize
 #include <poppler.h>  // for PopplerDocument
@@ -44,6 +47,24 @@ public:
     size_t getPageCount() const override;
     XojPdfBookmarkIterator* getContentsIter() const override;
 
+private:
+    /**
+     * @return The cached data of the page, created on first use
+     */
+    XojPdfPageCacheSPtr getPageCache(size_t page) const;
+
 private:
     PopplerDocument* document = nullptr;
+
+    struct PageCaches {
+        std::mutex mutex;
+        /// By page number, empty until a page is requested
+        std::vector<XojPdfPageCacheSPtr> pages;
+    };
+
+    /**
+     * The data extracted from the pages, see XojPdfPageCache. Shared with the copies of this document (they share the
+     * PopplerDocument), replaced when another PDF is loaded.
+     */
+    std::shared_ptr<PageCaches> pageCaches = std::make_shared<PageCaches>();
 };
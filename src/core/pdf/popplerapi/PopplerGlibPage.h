@@ -17,12 +17,13 @@
 #include <cairo.h>    // for cairo_t, cairo_region_t
 #include <poppler.h>  // for PopplerPage
 
-#include "pdf/base/XojPdfPage.h"  // for XojPdfRectangle (ptr only), XojPdfP...
+#include "pdf/base/XojPdfPage.h"        // for XojPdfRectangle (ptr only), XojPdfP...
+#include "pdf/base/XojPdfTextLayout.h"  // for XojPdfTextLayout
 
 
 class PopplerGlibPage: public XojPdfPage {
 public:
-    PopplerGlibPage(PopplerPage* page, PopplerDocument* doc);
+    PopplerGlibPage(PopplerPage* page, PopplerDocument* doc, XojPdfPageCacheSPtr cache);
     PopplerGlibPage(const PopplerGlibPage& other);
     virtual ~PopplerGlibPage();
     PopplerGlibPage& operator=(const PopplerGlibPage& other);
@@ -36,16 +37,13 @@ public:
 
     std::vector<XojPdfRectangle> findText(const std::string& text) override;
 
-    std::string selectText(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) override;
-
-    cairo_region_t* selectTextRegion(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) override;
-
-    TextSelection selectTextLines(const XojPdfRectangle& rect, XojPdfPageSelectionStyle style) override;
-
     auto getLinks() -> std::vector<Link> override;
 
     int getPageId() const override;
 
+protected:
+    XojPdfTextLayout readTextLayout() const override;
+
 private:
     PopplerPage* page;
     PopplerDocument* document;
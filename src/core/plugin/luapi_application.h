@@ -10,10 +10,13 @@
  */
 #pragma once
 
+#include <algorithm>  // for minmax_element
 #include <climits>
 #include <cstring>
 #include <limits>  // for numeric_limits
 #include <map>
+#include <new>     // for operator new
+#include <vector>  // for vector
 
 #include <gtk/gtk.h>
 #include <stdint.h>
@@ -42,6 +45,7 @@
 #include "model/XojPage.h"
 #include "plugin/Plugin.h"
 #include "undo/InsertUndoAction.h"
+#include "undo/PointsUndoAction.h"
 #include "util/StringUtils.h"
 #include "util/XojMsgBox.h"
 #include "util/i18n.h"  // for _
@@ -512,6 +516,402 @@ static void addStrokeHelper(lua_State* L, Stroke* stroke) {
     return;
 }
 
+/**
+ * Points of a stroke, stored as contiguous arrays of coordinates.
+ *
+ * It is exposed to Lua as a userdata (see pushPointBuffer), so that plugins can process many points without creating
+ * a Lua table per stroke and coordinate. The bulk transforms run in C++.
+ */
+struct LuaPointBuffer {
+    static constexpr const char* METATABLE = "Xournalpp.PointBuffer";
+
+    std::vector<double> x;
+    std::vector<double> y;
+
+    /**
+     * Empty if the points have no pressure, same length as x and y otherwise
+     */
+    std::vector<double> pressure;
+
+    size_t size() const { return x.size(); }
+    bool hasPressure() const { return !pressure.empty(); }
+
+    void assign(const std::vector<Point>& points, bool withPressure) {
+        x.resize(points.size());
+        y.resize(points.size());
+        pressure.resize(withPressure ? points.size() : 0);
+        for (size_t i = 0; i < points.size(); i++) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+        }
+        for (size_t i = 0; i < pressure.size(); i++) { pressure[i] = points[i].z; }
+    }
+
+    std::vector<Point> toPoints() const {
+        std::vector<Point> points;
+        points.reserve(size());
+        for (size_t i = 0; i < size(); i++) {
+            points.emplace_back(x[i], y[i], hasPressure() ? pressure[i] : Point::NO_PRESSURE);
+        }
+        return points;
+    }
+};
+
+static int pointBufferIndex(lua_State* L);
+static int pointBufferNewIndex(lua_State* L);
+static int pointBufferLen(lua_State* L);
+static int pointBufferGc(lua_State* L);
+static int pointBufferGet(lua_State* L);
+static int pointBufferSet(lua_State* L);
+static int pointBufferAppend(lua_State* L);
+static int pointBufferHasPressure(lua_State* L);
+static int pointBufferTranslate(lua_State* L);
+static int pointBufferScale(lua_State* L);
+static int pointBufferTransform(lua_State* L);
+static int pointBufferScalePressure(lua_State* L);
+static int pointBufferBounds(lua_State* L);
+static int pointBufferClone(lua_State* L);
+static int pointBufferToTables(lua_State* L);
+
+/**
+ * Metamethods and methods of the point buffers. The methods are looked up by __index.
+ */
+static const luaL_Reg pointBufferMeta[] = {{"__index", pointBufferIndex},
+                                           {"__newindex", pointBufferNewIndex},
+                                           {"__len", pointBufferLen},
+                                           {"__gc", pointBufferGc},
+                                           {"get", pointBufferGet},
+                                           {"set", pointBufferSet},
+                                           {"append", pointBufferAppend},
+                                           {"hasPressure", pointBufferHasPressure},
+                                           {"translate", pointBufferTranslate},
+                                           {"scale", pointBufferScale},
+                                           {"transform", pointBufferTransform},
+                                           {"scalePressure", pointBufferScalePressure},
+                                           {"bounds", pointBufferBounds},
+                                           {"clone", pointBufferClone},
+                                           {"toTables", pointBufferToTables},
+                                           {nullptr, nullptr}};
+
+/**
+ * Push a new, empty point buffer onto the stack
+ */
+static LuaPointBuffer* pushPointBuffer(lua_State* L) {
+    void* mem = lua_newuserdata(L, sizeof(LuaPointBuffer));
+    auto* buffer = new (mem) LuaPointBuffer();
+    if (luaL_newmetatable(L, LuaPointBuffer::METATABLE)) {
+        luaL_setfuncs(L, pointBufferMeta, 0);
+    }
+    lua_setmetatable(L, -2);
+    return buffer;
+}
+
+static LuaPointBuffer* checkPointBuffer(lua_State* L, int arg) {
+    return static_cast<LuaPointBuffer*>(luaL_checkudata(L, arg, LuaPointBuffer::METATABLE));
+}
+
+/**
+ * @return The 0-based index of the point whose 1-based Lua index is at position arg of the stack
+ */
+static size_t checkPointIndex(lua_State* L, const LuaPointBuffer* buffer, int arg) {
+    lua_Integer i = luaL_checkinteger(L, arg);
+    luaL_argcheck(L, i >= 1 && static_cast<size_t>(i) <= buffer->size(), arg, "point index out of range");
+    return static_cast<size_t>(i - 1);
+}
+
+/**
+ * Read the array of numbers at position idx of the stack
+ */
+static void readNumberArray(lua_State* L, int idx, std::vector<double>& out) {
+    auto n = lua_rawlen(L, idx);
+    out.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        lua_rawgeti(L, idx, static_cast<lua_Integer>(i + 1));
+        out[i] = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+    }
+}
+
+/**
+ * Push a Lua array with the given numbers onto the stack
+ */
+static void pushNumberArray(lua_State* L, const std::vector<double>& values) {
+    lua_createtable(L, static_cast<int>(values.size()), 0);
+    for (size_t i = 0; i < values.size(); i++) {
+        lua_pushnumber(L, values[i]);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+}
+
+/**
+ * buffer[i] returns the point i as a table {x = ..., y = ..., pressure = ...}. Use buffer:get(i) in loops, it does
+ * not create a table. Any other key is looked up in the methods.
+ */
+static int pointBufferIndex(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    if (lua_type(L, 2) == LUA_TNUMBER) {
+        size_t i = checkPointIndex(L, buffer, 2);
+        lua_createtable(L, 0, 3);
+        lua_pushnumber(L, buffer->x[i]);
+        lua_setfield(L, -2, "x");
+        lua_pushnumber(L, buffer->y[i]);
+        lua_setfield(L, -2, "y");
+        if (buffer->hasPressure()) {
+            lua_pushnumber(L, buffer->pressure[i]);
+            lua_setfield(L, -2, "pressure");
+        }
+        return 1;
+    }
+    luaL_getmetatable(L, LuaPointBuffer::METATABLE);
+    lua_pushvalue(L, 2);
+    lua_rawget(L, -2);
+    return 1;
+}
+
+/**
+ * buffer[i] = {x = ..., y = ..., pressure = ...} replaces the point i. Missing fields keep their value.
+ */
+static int pointBufferNewIndex(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    size_t i = checkPointIndex(L, buffer, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+    lua_getfield(L, 3, "x");
+    buffer->x[i] = luaL_optnumber(L, -1, buffer->x[i]);
+    lua_getfield(L, 3, "y");
+    buffer->y[i] = luaL_optnumber(L, -1, buffer->y[i]);
+    if (buffer->hasPressure()) {
+        lua_getfield(L, 3, "pressure");
+        buffer->pressure[i] = luaL_optnumber(L, -1, buffer->pressure[i]);
+    }
+    return 0;
+}
+
+static int pointBufferLen(lua_State* L) {
+    lua_pushinteger(L, static_cast<lua_Integer>(checkPointBuffer(L, 1)->size()));
+    return 1;
+}
+
+static int pointBufferGc(lua_State* L) {
+    checkPointBuffer(L, 1)->~LuaPointBuffer();
+    return 0;
+}
+
+/**
+ * local x, y, pressure = buffer:get(i)
+ * pressure is nil if the buffer has no pressure
+ */
+static int pointBufferGet(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    size_t i = checkPointIndex(L, buffer, 2);
+    lua_pushnumber(L, buffer->x[i]);
+    lua_pushnumber(L, buffer->y[i]);
+    if (buffer->hasPressure()) {
+        lua_pushnumber(L, buffer->pressure[i]);
+    } else {
+        lua_pushnil(L);
+    }
+    return 3;
+}
+
+/**
+ * buffer:set(i, x, y[, pressure])
+ */
+static int pointBufferSet(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    size_t i = checkPointIndex(L, buffer, 2);
+    buffer->x[i] = luaL_checknumber(L, 3);
+    buffer->y[i] = luaL_checknumber(L, 4);
+    if (buffer->hasPressure()) {
+        buffer->pressure[i] = luaL_optnumber(L, 5, buffer->pressure[i]);
+    } else {
+        luaL_argcheck(L, lua_isnoneornil(L, 5), 5, "the point buffer has no pressure");
+    }
+    return 0;
+}
+
+/**
+ * buffer:append(x, y[, pressure])
+ * The first point decides whether the buffer has pressure values.
+ */
+static int pointBufferAppend(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    double x = luaL_checknumber(L, 2);
+    double y = luaL_checknumber(L, 3);
+    bool withPressure = !lua_isnoneornil(L, 4);
+    if (buffer->size() > 0 && withPressure != buffer->hasPressure()) {
+        return luaL_error(L, "All the points of a buffer must have a pressure value, or none of them");
+    }
+    buffer->x.push_back(x);
+    buffer->y.push_back(y);
+    if (withPressure) {
+        buffer->pressure.push_back(luaL_checknumber(L, 4));
+    }
+    return 0;
+}
+
+static int pointBufferHasPressure(lua_State* L) {
+    lua_pushboolean(L, checkPointBuffer(L, 1)->hasPressure());
+    return 1;
+}
+
+/**
+ * buffer:translate(dx, dy)
+ */
+static int pointBufferTranslate(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    double dx = luaL_checknumber(L, 2);
+    double dy = luaL_checknumber(L, 3);
+    for (double& x: buffer->x) { x += dx; }
+    for (double& y: buffer->y) { y += dy; }
+    lua_settop(L, 1);
+    return 1;
+}
+
+/**
+ * buffer:scale(sx, sy[, originX, originY])
+ * Scales the points with respect to the origin point, (0, 0) by default
+ */
+static int pointBufferScale(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    double sx = luaL_checknumber(L, 2);
+    double sy = luaL_checknumber(L, 3);
+    double ox = luaL_optnumber(L, 4, 0.0);
+    double oy = luaL_optnumber(L, 5, 0.0);
+    for (double& x: buffer->x) { x = ox + sx * (x - ox); }
+    for (double& y: buffer->y) { y = oy + sy * (y - oy); }
+    lua_settop(L, 1);
+    return 1;
+}
+
+/**
+ * buffer:transform(a, b, c, d, e, f)
+ * Applies the affine transformation x' = a * x + b * y + e, y' = c * x + d * y + f
+ */
+static int pointBufferTransform(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    double a = luaL_checknumber(L, 2);
+    double b = luaL_checknumber(L, 3);
+    double c = luaL_checknumber(L, 4);
+    double d = luaL_checknumber(L, 5);
+    double e = luaL_checknumber(L, 6);
+    double f = luaL_checknumber(L, 7);
+    for (size_t i = 0; i < buffer->size(); i++) {
+        double x = buffer->x[i];
+        double y = buffer->y[i];
+        buffer->x[i] = a * x + b * y + e;
+        buffer->y[i] = c * x + d * y + f;
+    }
+    lua_settop(L, 1);
+    return 1;
+}
+
+/**
+ * buffer:scalePressure(factor)
+ * Does nothing if the buffer has no pressure
+ */
+static int pointBufferScalePressure(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    double factor = luaL_checknumber(L, 2);
+    for (double& p: buffer->pressure) { p *= factor; }
+    lua_settop(L, 1);
+    return 1;
+}
+
+/**
+ * local minX, minY, maxX, maxY = buffer:bounds()
+ * Returns nil if the buffer is empty
+ */
+static int pointBufferBounds(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    if (buffer->size() == 0) {
+        lua_pushnil(L);
+        return 1;
+    }
+    auto [minX, maxX] = std::minmax_element(buffer->x.begin(), buffer->x.end());
+    auto [minY, maxY] = std::minmax_element(buffer->y.begin(), buffer->y.end());
+    lua_pushnumber(L, *minX);
+    lua_pushnumber(L, *minY);
+    lua_pushnumber(L, *maxX);
+    lua_pushnumber(L, *maxY);
+    return 4;
+}
+
+static int pointBufferClone(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    *pushPointBuffer(L) = *buffer;
+    return 1;
+}
+
+/**
+ * local x, y, pressure = buffer:toTables()
+ * Copies the coordinates into Lua arrays. pressure is nil if the buffer has no pressure.
+ */
+static int pointBufferToTables(lua_State* L) {
+    auto* buffer = checkPointBuffer(L, 1);
+    pushNumberArray(L, buffer->x);
+    pushNumberArray(L, buffer->y);
+    if (buffer->hasPressure()) {
+        pushNumberArray(L, buffer->pressure);
+    } else {
+        lua_pushnil(L);
+    }
+    return 3;
+}
+
+/**
+ * Creates a point buffer: a userdata holding the points of a stroke as contiguous arrays of numbers.
+ * Point buffers are much faster than tables of coordinates when handling many points: they are used by
+ * app.getStrokes(type, "buffers"), app.addStrokes and app.setStrokePoints.
+ *
+ * Optional arguments: x, y (tables of equal length), pressure (table of the same length)
+ *
+ * Example:
+ *   local points = app.newPointBuffer({110.0, 120.0, 130.0}, {200.0, 205.0, 210.0})
+ *   points:append(140.0, 215.0)
+ *   print(#points)                      -- 4
+ *   local x, y, pressure = points:get(2) -- 120.0, 205.0, nil
+ *   points:set(2, 121.0, 206.0)
+ *   print(points[2].x)                   -- 121.0 (creates a table, prefer get in loops)
+ *
+ * Bulk operations (they return the buffer, so that they can be chained):
+ *   points:translate(dx, dy)
+ *   points:scale(sx, sy[, originX, originY])
+ *   points:transform(a, b, c, d, e, f) -- x' = a * x + b * y + e, y' = c * x + d * y + f
+ *   points:scalePressure(factor)
+ *
+ * Other methods:
+ *   points:hasPressure()
+ *   points:bounds()   -- minX, minY, maxX, maxY
+ *   points:clone()
+ *   points:toTables() -- x, y, pressure tables
+ */
+static int applib_newPointBuffer(lua_State* L) {
+    if (lua_isnoneornil(L, 1)) {
+        pushPointBuffer(L);
+        return 1;
+    }
+    luaL_checktype(L, 1, LUA_TTABLE);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    bool withPressure = !lua_isnoneornil(L, 3);
+    if (withPressure) {
+        luaL_checktype(L, 3, LUA_TTABLE);
+    }
+    if (lua_rawlen(L, 1) != lua_rawlen(L, 2)) {
+        return luaL_error(L, "X and Y vectors are not equal length!");
+    }
+    if (withPressure && lua_rawlen(L, 3) != lua_rawlen(L, 1)) {
+        return luaL_error(L, "Pressure vector is not equal length!");
+    }
+
+    auto* buffer = pushPointBuffer(L);
+    readNumberArray(L, 1, buffer->x);
+    readNumberArray(L, 2, buffer->y);
+    if (withPressure) {
+        readNumberArray(L, 3, buffer->pressure);
+    }
+    return 1;
+}
+
 /**
  * Given a table containing a series of splines, draws a batch of strokes on the canvas.
  * Expects a table of tables containing eight coordinate pairs, along with attributes of the stroke.
@@ -660,6 +1060,9 @@ static int applib_addSplines(lua_State* L) {
  * The function checks for consistency among table lengths, and throws an
  * error if there is a discrepancy
  *
+ * The points of a stroke may also be given as a point buffer, in the "points" field. This is much faster for long
+ * strokes. Strokes with less than two points are discarded.
+ *
  * Example:
  *
  * app.addStrokes({
@@ -695,6 +1098,10 @@ static int applib_addSplines(lua_State* L) {
  *             ["fill"] = 0,
  *             ["lineStyle"] = "dashdot",
  *         },
+ *         {   -- Instead of the tables, the points can be given as a point buffer (see app.newPointBuffer)
+ *             ["points"] = app.newPointBuffer({27.0, 28.0, 30.0, ...}, {100.0, 102.3, 102.5, ...}),
+ *             ["tool"] = "pen",
+ *         },
  *     },
  *     ["allowUndoRedoAction"] = "grouped", -- Each batch of strokes can be grouped into one undo/redo action (or
  * "individual" or "none")
@@ -715,83 +1122,56 @@ static int applib_addStrokes(lua_State* L) {
         return luaL_error(L, "Missing stroke table!");
     size_t numStrokes = lua_rawlen(L, -1);
     for (size_t a = 1; a <= numStrokes; a++) {
-        std::vector<double> xStream;
-        std::vector<double> yStream;
-        std::vector<double> pressureStream;
-        Stroke* stroke = new Stroke();
-
-        // Fetch table of X values from the Lua stack
-        lua_pushnumber(L, a);
-        lua_gettable(L, -2);
+        lua_rawgeti(L, -1, static_cast<lua_Integer>(a));
+
+        // Either a point buffer, or tables of X, Y and pressure values
+        std::vector<Point> points;
+        lua_getfield(L, -1, "points");
+        if (!lua_isnil(L, -1)) {
+            auto* buffer = static_cast<LuaPointBuffer*>(luaL_testudata(L, -1, LuaPointBuffer::METATABLE));
+            if (!buffer)
+                return luaL_error(L, "The points of a stroke must be a point buffer!");
+            points = buffer->toPoints();
+        } else {
+            LuaPointBuffer buffer;
+            lua_getfield(L, -2, "x");
+            if (!lua_istable(L, -1))
+                return luaL_error(L, "Missing X-Coordinate table!");
+            readNumberArray(L, lua_gettop(L), buffer.x);
+            lua_pop(L, 1);
 
-        lua_getfield(L, -1, "x");
-        if (!lua_istable(L, -1))
-            return luaL_error(L, "Missing X-Coordinate table!");
-        size_t xPoints = lua_rawlen(L, -1);
-        for (size_t b = 1; b <= xPoints; b++) {
-            lua_pushnumber(L, b);
-            lua_gettable(L, -2);
-            double value = lua_tonumber(L, -1);
-            xStream.push_back(value);
+            lua_getfield(L, -2, "y");
+            if (!lua_istable(L, -1))
+                return luaL_error(L, "Missing Y-Coordinate table!");
+            readNumberArray(L, lua_gettop(L), buffer.y);
             lua_pop(L, 1);
-        }
-        lua_pop(L, 1);
 
-        // Fetch table of Y values form the Lua stack
-        lua_getfield(L, -1, "y");
-        if (!lua_istable(L, -1))
-            return luaL_error(L, "Missing Y-Coordinate table!");
-        size_t yPoints = lua_rawlen(L, -1);
-        for (size_t b = 1; b <= yPoints; b++) {
-            lua_pushnumber(L, b);
-            lua_gettable(L, -2);
-            double value = lua_tonumber(L, -1);
-            yStream.push_back(value);
+            lua_getfield(L, -2, "pressure");
+            if (lua_istable(L, -1)) {
+                readNumberArray(L, lua_gettop(L), buffer.pressure);
+            }
             lua_pop(L, 1);
-        }
-        lua_pop(L, 1);
 
-        // Fetch table of pressure values from the Lua stack
-        lua_getfield(L, -1, "pressure");
-        if (lua_istable(L, -1)) {
-            size_t pressurePoints = lua_rawlen(L, -1);
-            for (size_t b = 1; b <= pressurePoints; b++) {
-                lua_pushnumber(L, b);
-                lua_gettable(L, -2);
-                double value = lua_tonumber(L, -1);
-                pressureStream.push_back(value);
-                lua_pop(L, 1);
+            // Make sure all vectors are the same length.
+            if (buffer.x.size() != buffer.y.size()) {
+                return luaL_error(L, "X and Y vectors are not equal length!");
             }
+            if (buffer.hasPressure() && buffer.pressure.size() != buffer.size())
+                return luaL_error(L, "Pressure vector is not equal length!");
+            points = buffer.toPoints();
         }
-
         lua_pop(L, 1);
 
-        // Handle those points
-        // Make sure all vectors are the same length.
-        if (xStream.size() != yStream.size()) {
-            return luaL_error(L, "X and Y vectors are not equal length!");
-        }
-        if (xStream.size() != pressureStream.size() && pressureStream.size() > 0)
-            return luaL_error(L, "Pressure vector is not equal length!");
-
         // Check and make sure there's enough points (need at least 2)
-        if (xStream.size() < 2) {
-            g_warning("Stroke shorter than two points. Discarding. (Has %ld/2)", xStream.size());
-            return 1;
-        }
-        // Add points to the stroke. Include pressure, if it exists.
-        if (pressureStream.size() > 0) {
-            for (long unsigned int i = 0; i < xStream.size(); i++) {
-                Point myPoint = Point(xStream.at(i), yStream.at(i), pressureStream.at(i));
-                stroke->addPoint(myPoint);
-            }
-        } else {
-            for (long unsigned int i = 0; i < xStream.size(); i++) {
-                Point myPoint = Point(xStream.at(i), yStream.at(i), Point::NO_PRESSURE);
-                stroke->addPoint(myPoint);
-            }
+        if (points.size() < 2) {
+            g_warning("Stroke shorter than two points. Discarding. (Has %zu/2)", points.size());
+            lua_pop(L, 1);
+            continue;
         }
 
+        Stroke* stroke = new Stroke();
+        stroke->setPointVector(std::move(points));
+
         // Finish building the Stroke and apply it to the layer.
         addStrokeHelper(L, stroke);
         strokes.push_back(stroke);
@@ -822,11 +1202,85 @@ static int applib_addStrokes(lua_State* L) {
     return 0;
 }
 
+/**
+ * Get the elements of the selected layer ("Layer") or of the selection ("selection")
+ */
+static std::vector<Element*> getElementsHelper(lua_State* L, Control* control, const std::string& type) {
+    if (type == "Layer") {
+        auto sel = control->getWindow()->getXournal()->getSelection();
+        if (sel) {
+            control->clearSelection();  // otherwise strokes in the selection won't be recognized
+        }
+        return control->getCurrentPage()->getSelectedLayer()->getElements();
+    } else if (type == "selection") {
+        auto sel = control->getWindow()->getXournal()->getSelection();
+        if (sel) {
+            return sel->getElements();
+        } else {
+            luaL_error(L, "There is no selection! ");
+        }
+    } else {
+        luaL_error(L, "Unknown argument: %s", type.c_str());
+    }
+    return {};
+}
+
+/**
+ * Push a table describing the stroke onto the stack, with its points either as a point buffer or as tables
+ */
+static void pushStrokeHelper(lua_State* L, Stroke* s, bool asBuffer) {
+    lua_newtable(L);  // create stroke table
+
+    if (asBuffer) {
+        pushPointBuffer(L)->assign(s->getPointVector(), s->hasPressure());
+        lua_setfield(L, -2, "points");  // add point buffer to stroke
+    } else {
+        LuaPointBuffer buffer;
+        buffer.assign(s->getPointVector(), s->hasPressure());
+        pushNumberArray(L, buffer.x);
+        lua_setfield(L, -2, "x");  // add x-coordinates to stroke
+        pushNumberArray(L, buffer.y);
+        lua_setfield(L, -2, "y");  // add y-coordinates to stroke
+        if (buffer.hasPressure()) {
+            pushNumberArray(L, buffer.pressure);
+            lua_setfield(L, -2, "pressure");  // add pressures to stroke
+        }
+    }
+
+    StrokeTool tool = s->getToolType();
+    if (tool == StrokeTool::PEN) {
+        lua_pushstring(L, "pen");
+    } else if (tool == StrokeTool::ERASER) {
+        lua_pushstring(L, "eraser");
+    } else if (tool == StrokeTool::HIGHLIGHTER) {
+        lua_pushstring(L, "highlighter");
+    } else {
+        luaL_error(L, "Unknown StrokeTool::Value.");
+    }
+    lua_setfield(L, -2, "tool");  // add tool to stroke
+
+    lua_pushnumber(L, s->getWidth());
+    lua_setfield(L, -2, "width");  // add width to stroke
+
+    lua_pushinteger(L, int(uint32_t(s->getColor())));
+    lua_setfield(L, -2, "color");  // add color to stroke
+
+    lua_pushinteger(L, s->getFill());
+    lua_setfield(L, -2, "fill");  // add fill to stroke
+
+    lua_pushstring(L, StrokeStyle::formatStyle(s->getLineStyle()).c_str());
+    lua_setfield(L, -2, "lineStyle");  // add linestyle to stroke
+}
+
 /**
  * Puts a Lua Table of the Strokes (from the selection tool / selected layer) onto the stack.
  * Is inverse to app.addStrokes
  *
- * Required argument: type ("selection" or "layer")
+ * Required argument: type ("selection" or "Layer")
+ * Optional argument: format ("tables" or "buffers"), "tables" by default
+ *
+ * With the format "buffers", the points of each stroke are returned as a point buffer (see app.newPointBuffer) in the
+ * "points" field, instead of the tables "x", "y" and "pressure". This is much faster for long strokes.
  *
  * Example: local strokes = app.getStrokes("selection")
  *
@@ -863,96 +1317,116 @@ static int applib_addStrokes(lua_State* L) {
  *             ["lineStyle"] = "plain",
  *         },
  * }
+ *
+ * Example: local strokes = app.getStrokes("Layer", "buffers")
+ *
+ * possible return value:
+ * {
+ *         {
+ *             ["points"]    = <point buffer>,
+ *             ["tool"]      = "pen",
+ *             ["width"]     = 0.85,
+ *             ["color"]     = 16744448,
+ *             ["fill"]      = -1,
+ *             ["lineStyle"] = "plain",
+ *         },
+ * }
  */
 static int applib_getStrokes(lua_State* L) {
     Plugin* plugin = Plugin::getPluginFromLua(L);
     std::string type = luaL_checkstring(L, 1);
-    std::vector<Element*> elements = {};
+    std::string format = luaL_optstring(L, 2, "tables");
     Control* control = plugin->getControl();
 
-    if (type == "Layer") {
-        auto sel = control->getWindow()->getXournal()->getSelection();
-        if (sel) {
-            control->clearSelection();  // otherwise strokes in the selection won't be recognized
-        }
-        elements = control->getCurrentPage()->getSelectedLayer()->getElements();
-    } else if (type == "selection") {
-        auto sel = control->getWindow()->getXournal()->getSelection();
-        if (sel) {
-            elements = sel->getElements();
-        } else {
-            return luaL_error(L, "There is no selection! ");
-        }
-    } else {
-        return luaL_error(L, "Unknown argument: %s", type.c_str());
+    if (format != "tables" && format != "buffers") {
+        return luaL_error(L, "Unknown format: %s", format.c_str());
     }
 
+    std::vector<Element*> elements = getElementsHelper(L, control, type);
+
     lua_newtable(L);  // create table of the elements
-    int currStrokeNo = 0;
-    int currPointNo = 0;
+    lua_Integer currStrokeNo = 0;
 
     for (Element* e: elements) {
         if (e->getType() == ELEMENT_STROKE) {
-            auto* s = static_cast<Stroke*>(e);
-            lua_pushnumber(L, ++currStrokeNo);  // index for later (settable)
-            lua_newtable(L);                    // create stroke table
-
-            lua_newtable(L);  // create table of x-coordinates
-            for (auto p: s->getPointVector()) {
-                lua_pushnumber(L, ++currPointNo);
-                lua_pushnumber(L, p.x);
-                lua_settable(L, -3);  // pops key and value from stack
-            }
-            lua_setfield(L, -2, "x");  // add x-coordinates to stroke
-            currPointNo = 0;
-
-            lua_newtable(L);  // create table for y-coordinates
-            for (auto p: s->getPointVector()) {
-                lua_pushnumber(L, ++currPointNo);
-                lua_pushnumber(L, p.y);
-                lua_settable(L, -3);
-            }
-            lua_setfield(L, -2, "y");  // add y-coordinates to stroke
-            currPointNo = 0;
-
-            if (s->hasPressure()) {
-                lua_newtable(L);  // create table for pressures
-                for (auto p: s->getPointVector()) {
-                    lua_pushnumber(L, ++currPointNo);
-                    lua_pushnumber(L, p.z);
-                    lua_settable(L, -3);
-                }
-                lua_setfield(L, -2, "pressure");  // add pressures to stroke
-                currPointNo = 0;
-            }
+            pushStrokeHelper(L, static_cast<Stroke*>(e), format == "buffers");
+            lua_rawseti(L, -2, ++currStrokeNo);  // add stroke to elements
+        }
+    }
+    return 1;
+}
 
-            StrokeTool tool = s->getToolType();
-            if (tool == StrokeTool::PEN) {
-                lua_pushstring(L, "pen");
-            } else if (tool == StrokeTool::ERASER) {
-                lua_pushstring(L, "eraser");
-            } else if (tool == StrokeTool::HIGHLIGHTER) {
-                lua_pushstring(L, "highlighter");
-            } else {
-                return luaL_error(L, "Unknown StrokeTool::Value.");
-            }
-            lua_setfield(L, -2, "tool");  // add tool to stroke
+/**
+ * Replaces the points of the strokes of the selected layer, with a single undo/redo action.
+ * The strokes keep their other properties and their position in the layer.
+ *
+ * Required argument: a table whose i-th entry gives the new points of the i-th stroke returned by
+ * app.getStrokes("Layer"). An entry is either a point buffer, or a stroke table with a point buffer in its "points"
+ * field (as returned by app.getStrokes("Layer", "buffers")). Strokes without an entry are left unchanged.
+ *
+ * Example:
+ *   local strokes = app.getStrokes("Layer", "buffers")
+ *   for _, stroke in ipairs(strokes) do
+ *     stroke.points:translate(10, 0):scalePressure(0.5)
+ *   end
+ *   app.setStrokePoints(strokes)
+ *
+ * Returns the number of modified strokes
+ */
+static int applib_setStrokePoints(lua_State* L) {
+    Plugin* plugin = Plugin::getPluginFromLua(L);
+    Control* control = plugin->getControl();
+
+    // Discard any extra arguments passed in
+    lua_settop(L, 1);
+    luaL_checktype(L, 1, LUA_TTABLE);
 
-            lua_pushnumber(L, s->getWidth());
-            lua_setfield(L, -2, "width");  // add width to stroke
+    PageRef page = control->getCurrentPage();
+    if (!page) {
+        return luaL_error(L, "There is no current page.");
+    }
+    std::vector<Element*> elements = getElementsHelper(L, control, "Layer");
 
-            lua_pushinteger(L, int(uint32_t(s->getColor())));
-            lua_setfield(L, -2, "color");  // add color to stroke
+    auto undoAction = std::make_unique<PointsUndoAction>(page);
+    lua_Integer n = 0;
+    lua_Integer modified = 0;
+    for (Element* e: elements) {
+        if (e->getType() != ELEMENT_STROKE) {
+            continue;
+        }
+        lua_rawgeti(L, 1, ++n);
+        if (lua_istable(L, -1)) {
+            lua_getfield(L, -1, "points");
+            lua_remove(L, -2);
+        }
+        if (lua_isnil(L, -1)) {
+            lua_pop(L, 1);
+            continue;
+        }
+        auto* buffer = static_cast<LuaPointBuffer*>(luaL_testudata(L, -1, LuaPointBuffer::METATABLE));
+        if (!buffer) {
+            return luaL_error(L, "Entry %d is neither a point buffer nor a stroke with a point buffer!", int(n));
+        }
+        if (buffer->size() < 2) {
+            return luaL_error(L, "Entry %d has less than two points!", int(n));
+        }
 
-            lua_pushinteger(L, s->getFill());
-            lua_setfield(L, -2, "fill");  // add fill to stroke
+        undoAction->addStroke(static_cast<Stroke*>(e), buffer->toPoints());
+        lua_pop(L, 1);
+        modified++;
+    }
 
-            lua_pushstring(L, StrokeStyle::formatStyle(s->getLineStyle()).c_str());
-            lua_setfield(L, -2, "lineStyle");  // add linestyle to stroke
+    if (lua_rawlen(L, 1) > static_cast<size_t>(n)) {
+        return luaL_error(L, "There are more entries than strokes on the layer!");
+    }
 
-            lua_settable(L, -3);  // add stroke to elements
-        }
+    // All the entries are valid: swap the new points in
+    if (modified > 0) {
+        undoAction->redo(control);
+        control->getUndoRedoHandler()->addUndoAction(std::move(undoAction));
     }
+
+    lua_pushinteger(L, modified);
     return 1;
 }
 
@@ -2013,6 +2487,8 @@ static const luaL_Reg applib[] = {{"msgbox", applib_msgbox},
                                   {"getFilePath", applib_getFilePath},
                                   {"refreshPage", applib_refreshPage},
                                   {"getStrokes", applib_getStrokes},
+                                  {"setStrokePoints", applib_setStrokePoints},
+                                  {"newPointBuffer", applib_newPointBuffer},
                                   {"openFile", applib_openFile},
                                   // Placeholder
                                   //	{"MSG_BT_OK", nullptr},
@@ -0,0 +1,55 @@
+#include "PointsUndoAction.h"
+
+#include <utility>  // for move, swap
+
+#include "model/Stroke.h"     // for Stroke
+#include "model/XojPage.h"    // for XojPage
+#include "undo/UndoAction.h"  // for UndoAction
+#include "util/Range.h"       // for Range
+#include "util/i18n.h"        // for _
+
+class Control;
+
+PointsUndoAction::PointsUndoAction(const PageRef& page): UndoAction("PointsUndoAction") { this->page = page; }
+
+PointsUndoAction::~PointsUndoAction() = default;
+
+void PointsUndoAction::addStroke(Stroke* s, std::vector<Point> points) {
+    this->data.push_back({s, std::move(points)});
+}
+
+void PointsUndoAction::swapPoints() {
+    if (this->data.empty()) {
+        return;
+    }
+
+    Stroke* first = this->data.front().s;
+    Range range(first->getX(), first->getY());
+
+    for (Entry& e: this->data) {
+        // The stroke may grow or shrink: repaint both the old and the new extent
+        range.addPoint(e.s->getX(), e.s->getY());
+        range.addPoint(e.s->getX() + e.s->getElementWidth(), e.s->getY() + e.s->getElementHeight());
+
+        std::vector<Point> current = e.s->getPointVector();
+        e.s->setPointVector(std::move(e.points));
+        e.points = std::move(current);
+
+        range.addPoint(e.s->getX(), e.s->getY());
+        range.addPoint(e.s->getX() + e.s->getElementWidth(), e.s->getY() + e.s->getElementHeight());
+    }
+
+    this->page->fireRangeChanged(range);
+}
+
+auto PointsUndoAction::undo(Control* control) -> bool {
+    swapPoints();
+    return true;
+}
+
+auto PointsUndoAction::redo(Control* control) -> bool {
+    swapPoints();
+    return true;
+}
+
+auto PointsUndoAction::getText() -> std::string { return _("Change stroke points"); }
@@ -0,0 +1,59 @@
+/*
+ * Xournal++
+ *
+ * Undo action for changes of the points of strokes
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "model/PageRef.h"  // for PageRef
+#include "model/Point.h"    // for Point
+
+#include "UndoAction.h"  // for UndoAction
+
+class Stroke;
+class Control;
+
+/**
+ * @brief Replaces the points of several strokes at once
+ *
+ * The strokes stay on their layer: only their point vectors are swapped on undo/redo. The new points are added
+ * first, then redo() applies them all at once.
+ */
+class PointsUndoAction: public UndoAction {
+public:
+    explicit PointsUndoAction(const PageRef& page);
+    ~PointsUndoAction() override;
+
+public:
+    bool undo(Control* control) override;
+    bool redo(Control* control) override;
+    std::string getText() override;
+
+    /**
+     * @brief Add new points for s, applied by the next call to redo()
+     */
+    void addStroke(Stroke* s, std::vector<Point> points);
+
+private:
+    /**
+     * Exchange the current points of every stroke with the stored ones
+     */
+    void swapPoints();
+
+private:
+    struct Entry {
+        Stroke* s;
+        std::vector<Point> points;
+    };
+
+    std::vector<Entry> data;
+};
@@ -1,10 +1,12 @@
 #include "DocumentView.h"
 
-#include <memory>  // for __shared_ptr_access, uni...
-#include <vector>  // for vector
+#include <memory>   // for __shared_ptr_access, uni...
+#include <utility>  // for move
+#include <vector>   // for vector
 
 #include <glib.h>  // for g_message
 
+#include "model/Element.h"                   // for Element, ELEMENT_TEXIMAGE
 #include "model/Layer.h"                     // for Layer
 #include "model/XojPage.h"                   // for XojPage
 #include "view/DebugShowRepaintBounds.h"     // for IF_DEBUG_REPAINT
@@ -18,8 +20,33 @@
  */
 void DocumentView::setMarkAudioStroke(bool markAudioStroke) { this->markAudioStroke = markAudioStroke; }
 
+void DocumentView::setAudioReplay(std::optional<xoj::view::AudioReplay> audioReplay) {
+    this->audioReplay = std::move(audioReplay);
+}
+
+void DocumentView::setImageLoading(xoj::view::ImageLoading imageLoading) { this->imageLoading = imageLoading; }
+
+void DocumentView::setPathCompaction(xoj::view::PathCompaction compactPaths) { this->compactPaths = compactPaths; }
+
 void DocumentView::setPdfCache(PdfCache* cache) { pdfCache = cache; }
 
+auto DocumentView::prepareConcurrentDrawing(const PageRef& page) -> bool {
+    for (Layer* layer: *page->getLayers()) {
+        if (!layer->isVisible()) {
+            continue;
+        }
+        for (Element* e: layer->getElements()) {
+            if (e->getType() == ELEMENT_TEXIMAGE) {
+                return false;
+            }
+            // Computes the bounding box (used by LayerView to skip elements outside the clip)
+            // Images need no preparation: they are decoded by the thread-safe ImageCache
+            e->boundingRect();
+        }
+    }
+    return true;
+}
+
 /**
  * Drawing first step
  * @param page The page to draw
@@ -84,16 +111,28 @@ void DocumentView::drawPage(PageRef page, cairo_t* cr, bool dontRenderEditingStr
         drawBackground(bgFlags);
     }
 
+    drawVisibleLayers();
+
+    finializeDrawing();
+}
+
+void DocumentView::drawPageLayers(PageRef page, cairo_t* cr, bool dontRenderEditingStroke) {
+    initDrawing(page, cr, dontRenderEditingStroke);
+    drawVisibleLayers();
+    finializeDrawing();
+}
+
+void DocumentView::drawVisibleLayers() {
     xoj::view::Context context{cr, (xoj::view::NonAudioTreatment)this->markAudioStroke,
-                               (xoj::view::EditionTreatment) !this->dontRenderEditingStroke, xoj::view::NORMAL_COLOR};
+                               (xoj::view::EditionTreatment) !this->dontRenderEditingStroke, xoj::view::NORMAL_COLOR,
+                               this->imageLoading, this->compactPaths};
+    context.audioReplay = this->audioReplay;
     for (Layer* layer: *page->getLayers()) {
         if (layer->isVisible()) {
             xoj::view::LayerView layerView(layer);
             layerView.draw(context);
         }
     }
-
-    finializeDrawing();
 }
 
 
@@ -110,6 +149,19 @@ void DocumentView::drawLayersOfPage(const LayerRangeVector& layerRange, PageRef
         drawBackground(bgFlags);
     }
 
+    drawLayerRange(layerRange);
+
+    finializeDrawing();
+}
+
+void DocumentView::drawLayerRangeOfPage(const LayerRangeVector& layerRange, PageRef page, cairo_t* cr,
+                                        bool dontRenderEditingStroke) {
+    initDrawing(page, cr, dontRenderEditingStroke);
+    drawLayerRange(layerRange);
+    finializeDrawing();
+}
+
+void DocumentView::drawLayerRange(const LayerRangeVector& layerRange) {
     size_t layerCount = page->getLayerCount();
     std::vector<bool> visible(layerCount, false);
 
@@ -124,7 +176,9 @@ void DocumentView::drawLayersOfPage(const LayerRangeVector& layerRange, PageRef
     }
 
     xoj::view::Context context{cr, (xoj::view::NonAudioTreatment)this->markAudioStroke,
-                               (xoj::view::EditionTreatment) !this->dontRenderEditingStroke, xoj::view::NORMAL_COLOR};
+                               (xoj::view::EditionTreatment) !this->dontRenderEditingStroke, xoj::view::NORMAL_COLOR,
+                               this->imageLoading, this->compactPaths};
+    context.audioReplay = this->audioReplay;
     auto visibilityIt = visible.begin();
     for (Layer* l: *page->getLayers()) {
         if (!*(visibilityIt++)) {
@@ -133,6 +187,4 @@ void DocumentView::drawLayersOfPage(const LayerRangeVector& layerRange, PageRef
         xoj::view::LayerView layerView(l);
         layerView.draw(context);
     }
-
-    finializeDrawing();
 }
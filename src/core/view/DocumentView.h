@@ -11,10 +11,13 @@
 
 #pragma once
 
+#include <optional>  // for optional
+
 #include <cairo.h>  // for cairo_t
 
 #include "model/PageRef.h"  // for PageRef
 #include "util/ElementRange.h"
+#include "view/View.h"  // for ImageLoading
 
 class PdfCache;
 
@@ -40,6 +43,14 @@ public:
     void drawPage(PageRef page, cairo_t* cr, bool dontRenderEditingStroke, bool hidePdfBackground = false,
                   bool hideImageBackground = false, bool hideRulingBackground = false);
 
+    /**
+     * Draws the visible layers of the page, without the background (e.g. on top of a cached background)
+     * @param page The page to draw
+     * @param cr Draw to this context
+     * @param dontRenderEditingStroke false to draw currently drawing stroke
+     */
+    void drawPageLayers(PageRef page, cairo_t* cr, bool dontRenderEditingStroke);
+
     /**
      * Only draws the prescribed layers of the given page, regardless of the layer's current visibility.
      * @param layerRange Range of layers to draw
@@ -54,11 +65,47 @@ public:
                           bool hidePdfBackground = false, bool hideImageBackground = false,
                           bool hideRulingBackground = false);
 
+    /**
+     * Only draws the prescribed layers of the given page, without the background (e.g. on top of a shared background)
+     * @param layerRange Range of layers to draw
+     * @param page The page to draw
+     * @param cr Draw to this context
+     * @param dontRenderEditingStroke false to draw currently drawing stroke
+     */
+    void drawLayerRangeOfPage(const LayerRangeVector& layerRange, PageRef page, cairo_t* cr,
+                              bool dontRenderEditingStroke);
+
     /**
      * Mark stroke with Audio
      */
     void setMarkAudioStroke(bool markAudioStroke);
 
+    /**
+     * While marking the strokes with audio, also fade out the strokes of the replayed recording which come after the
+     * playback position
+     */
+    void setAudioReplay(std::optional<xoj::view::AudioReplay> audioReplay);
+
+    /**
+     * Draw images which are not decoded yet as placeholders, and decode them in the background (see ImageCache).
+     * Only for on-screen rendering: the page must be rendered again once the images are ready.
+     */
+    void setImageLoading(xoj::view::ImageLoading imageLoading);
+
+    /**
+     * Draw each stroke with pressure as a single filled outline, and consecutive strokes of the same style as a single
+     * path. For vector outputs (PDF export), where every cairo_stroke() becomes a path object in the file.
+     */
+    void setPathCompaction(xoj::view::PathCompaction compactPaths);
+
+    /**
+     * Evaluates the lazily computed data of the page's elements (bounding boxes), so that several
+     * parts of the page can then be drawn from different threads at the same time.
+     * The document must be locked during the call and until all the threads are done drawing.
+     * @return false if the page contains elements which cannot be drawn concurrently (TeX images, rendered by poppler)
+     */
+    static bool prepareConcurrentDrawing(const PageRef& page);
+
     // API for special drawing, usually you won't call this methods
 public:
     void setPdfCache(PdfCache* cache);
@@ -86,11 +133,25 @@ public:
      */
     void finializeDrawing();
 
+private:
+    /**
+     * Draws all the visible layers
+     */
+    void drawVisibleLayers();
+
+    /**
+     * Draws the layers in the range, regardless of their visibility
+     */
+    void drawLayerRange(const LayerRangeVector& layerRange);
+
 private:
     cairo_t* cr = nullptr;
     PageRef page = nullptr;
     PdfCache* pdfCache = nullptr;
     bool dontRenderEditingStroke = false;
     bool markAudioStroke = false;
+    std::optional<xoj::view::AudioReplay> audioReplay;
+    xoj::view::ImageLoading imageLoading = xoj::view::WAIT_FOR_IMAGES;
+    xoj::view::PathCompaction compactPaths = xoj::view::NO_PATH_COMPACTION;
 
 };
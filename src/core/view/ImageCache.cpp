@@ -0,0 +1,277 @@
+#include "ImageCache.h"
+
+#include <algorithm>  // for max, clamp
+#include <iterator>   // for next
+#include <utility>    // for move
+
+#include <cairo.h>                  // for cairo_image_surface_create, cairo_paint
+#include <gdk-pixbuf/gdk-pixbuf.h>  // for gdk_pixbuf_loader_new, GdkPixbuf
+#include <gdk/gdk.h>                // for gdk_cairo_set_source_pixbuf
+#include <glib-object.h>            // for g_object_unref
+#include <glib.h>                   // for g_warning, guchar
+
+using namespace xoj::view;
+using xoj::util::CairoSurfaceSPtr;
+
+namespace {
+/**
+ * The pyramid stops once both dimensions are at most this size (in pixels)
+ */
+constexpr int MIN_LEVEL_SIZE = 64;
+
+auto surfaceBytes(cairo_surface_t* surface) -> size_t {
+    return static_cast<size_t>(cairo_image_surface_get_stride(surface)) *
+           static_cast<size_t>(cairo_image_surface_get_height(surface));
+}
+}  // namespace
+
+auto ImageCache::getInstance() -> ImageCache& {
+    static ImageCache instance;
+    return instance;
+}
+
+ImageCache::~ImageCache() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    queueNotEmpty.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+void ImageCache::setListener(Listener listener) {
+    std::lock_guard lock(listenerMutex);
+    this->listener = std::move(listener);
+}
+
+auto ImageCache::getFullResolution(const Data& data) -> CairoSurfaceSPtr {
+    std::unique_lock lock(mutex);
+    Entry& entry = getEntry(data);
+    touch(entry);
+    if (!entry.failed && (entry.levels.empty() || !entry.levels[0])) {
+        decode(entry, lock);
+    }
+    return entry.levels.empty() ? CairoSurfaceSPtr() : entry.levels[0];
+}
+
+auto ImageCache::getSurface(const Data& data, double pixelWidth, bool wait) -> CairoSurfaceSPtr {
+    std::unique_lock lock(mutex);
+    Entry& entry = getEntry(data);
+    touch(entry);
+    if (entry.failed) {
+        return {};
+    }
+
+    if (!entry.levels.empty()) {
+        size_t level = levelForWidth(entry, pixelWidth);
+        if (entry.levels[level]) {
+            return entry.levels[level];
+        }
+        // Only the evicted full resolution is large enough
+        if (!wait) {
+            decodeInBackground(data);
+            return entry.levels[1];
+        }
+    } else if (!wait) {
+        decodeInBackground(data);
+        return {};
+    }
+
+    decode(entry, lock);
+    if (entry.levels.empty()) {
+        return {};
+    }
+    return entry.levels[levelForWidth(entry, pixelWidth)];
+}
+
+auto ImageCache::getEntry(const Data& data) -> Entry& {
+    auto [it, inserted] = entries.try_emplace(data.get());
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.data = data;
+        lru.push_front(data.get());
+        entry.lruPosition = lru.begin();
+    }
+    return entry;
+}
+
+auto ImageCache::levelForWidth(const Entry& entry, double pixelWidth) -> size_t {
+    size_t level = 0;
+    while (level + 1 < entry.levels.size() &&
+           cairo_image_surface_get_width(entry.levels[level + 1].get()) >= pixelWidth) {
+        level++;
+    }
+    return level;
+}
+
+void ImageCache::decode(Entry& entry, std::unique_lock<std::mutex>& lock) {
+    if (entry.decoding) {
+        decodingDone.wait(lock, [&entry]() { return !entry.decoding; });
+        return;
+    }
+
+    entry.decoding = true;
+    Data data = entry.data;
+    lock.unlock();
+    auto levels = createPyramid(*data);
+    lock.lock();
+    entry.decoding = false;
+    store(entry, std::move(levels));
+    decodingDone.notify_all();
+}
+
+auto ImageCache::createPyramid(const std::string& data) -> std::vector<CairoSurfaceSPtr> {
+    std::vector<CairoSurfaceSPtr> levels;
+
+    GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
+    bool success =
+            gdk_pixbuf_loader_write(loader, reinterpret_cast<const guchar*>(data.data()), data.length(), nullptr);
+    success = gdk_pixbuf_loader_close(loader, nullptr) && success;
+    GdkPixbuf* tmp = success ? gdk_pixbuf_loader_get_pixbuf(loader) : nullptr;
+    if (tmp == nullptr) {
+        g_warning("Could not decode image data");
+        g_object_unref(loader);
+        return levels;
+    }
+    GdkPixbuf* pixbuf = gdk_pixbuf_apply_embedded_orientation(tmp);
+
+    int width = gdk_pixbuf_get_width(pixbuf);
+    int height = gdk_pixbuf_get_height(pixbuf);
+    CairoSurfaceSPtr full(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height), xoj::util::adopt);
+    {
+        // Paint the pixbuf on to the surface
+        // NOTE: we do this manually instead of using gdk_cairo_surface_create_from_pixbuf
+        // since this does not work in CLI mode.
+        xoj::util::CairoSPtr cr(cairo_create(full.get()), xoj::util::adopt);
+        gdk_cairo_set_source_pixbuf(cr.get(), pixbuf, 0, 0);
+        cairo_paint(cr.get());
+    }
+    g_object_unref(pixbuf);
+    g_object_unref(loader);
+    levels.emplace_back(std::move(full));
+
+    while (std::max(width, height) > MIN_LEVEL_SIZE) {
+        cairo_surface_t* previous = levels.back().get();
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        CairoSurfaceSPtr level(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height), xoj::util::adopt);
+        xoj::util::CairoSPtr cr(cairo_create(level.get()), xoj::util::adopt);
+        cairo_scale(cr.get(), static_cast<double>(width) / cairo_image_surface_get_width(previous),
+                    static_cast<double>(height) / cairo_image_surface_get_height(previous));
+        cairo_set_source_surface(cr.get(), previous, 0, 0);
+        cairo_pattern_set_filter(cairo_get_source(cr.get()), CAIRO_FILTER_GOOD);
+        cairo_paint(cr.get());
+        levels.emplace_back(std::move(level));
+    }
+    return levels;
+}
+
+void ImageCache::store(Entry& entry, std::vector<CairoSurfaceSPtr> levels) {
+    if (levels.empty()) {
+        entry.failed = true;
+        return;
+    }
+
+    totalBytes -= entry.bytes;
+    entry.bytes = 0;
+    for (auto& level: levels) {
+        entry.bytes += surfaceBytes(level.get());
+    }
+    totalBytes += entry.bytes;
+    entry.levels = std::move(levels);
+
+    touch(entry);
+    evict();
+}
+
+void ImageCache::touch(Entry& entry) { lru.splice(lru.begin(), lru, entry.lruPosition); }
+
+void ImageCache::evict() {
+    // Forget the images no element refers to anymore
+    for (auto it = lru.begin(); it != lru.end();) {
+        auto entryIt = entries.find(*it);
+        const Entry& entry = entryIt->second;
+        if (entry.data.use_count() == 1 && !entry.decoding) {
+            totalBytes -= entry.bytes;
+            entries.erase(entryIt);
+            it = lru.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // The most recently used image is never evicted: it is the one which is being drawn
+    auto evictFromLeastRecent = [this](auto&& evictOne) {
+        for (auto it = lru.rbegin(); totalBytes > MAX_BYTES && std::next(it) != lru.rend(); ++it) {
+            evictOne(entries.at(*it));
+        }
+    };
+
+    // First drop the full resolutions, the smaller levels are enough to draw zoomed out pages
+    evictFromLeastRecent([this](Entry& entry) {
+        if (entry.levels.size() > 1 && entry.levels[0]) {
+            size_t bytes = surfaceBytes(entry.levels[0].get());
+            entry.levels[0].reset();
+            entry.bytes -= bytes;
+            totalBytes -= bytes;
+        }
+    });
+
+    // Then drop entire images
+    evictFromLeastRecent([this](Entry& entry) {
+        entry.levels.clear();
+        totalBytes -= entry.bytes;
+        entry.bytes = 0;
+    });
+}
+
+void ImageCache::decodeInBackground(const Data& data) {
+    Entry& entry = getEntry(data);
+    if (entry.decoding) {
+        // Already queued, or being decoded
+        return;
+    }
+    entry.decoding = true;
+    queue.push_back(data);
+
+    if (workers.empty()) {
+        unsigned int count = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+        for (unsigned int n = 0; n < count; n++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+    queueNotEmpty.notify_one();
+}
+
+void ImageCache::workerLoop() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        queueNotEmpty.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (stopping) {
+            return;
+        }
+        Data data = std::move(queue.front());
+        queue.pop_front();
+
+        lock.unlock();
+        auto levels = createPyramid(*data);
+        lock.lock();
+
+        // The entry cannot have been removed: the queue kept a reference to its data
+        Entry& entry = getEntry(data);
+        entry.decoding = false;
+        store(entry, std::move(levels));
+        decodingDone.notify_all();
+
+        lock.unlock();
+        {
+            std::lock_guard listenerLock(listenerMutex);
+            if (listener) {
+                listener(data.get());
+            }
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Xournal++
+ *
+ * Cache of decoded images
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <list>                // for list
+#include <memory>              // for shared_ptr
+#include <mutex>               // for mutex
+#include <string>              // for string
+#include <thread>              // for thread
+#include <unordered_map>       // for unordered_map
+#include <vector>              // for vector
+
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+namespace xoj::view {
+
+/**
+ * @brief Decoded Image elements, shared by all the images with the same (encoded) data.
+ *
+ * An image is decoded into a pyramid of surfaces: the full resolution, then halved resolutions down to a thumbnail.
+ * Views pick the smallest level which is at least as large as the image on their target, so that zoomed out pages
+ * do not sample huge surfaces.
+ *
+ * Decoding can happen on background workers: the listener is then notified once the image is ready.
+ *
+ * The decoded surfaces are bounded by MAX_BYTES: the least recently used images lose their full resolution level
+ * first, then all their levels. The encoded data is kept by the Image elements, so evicted levels are decoded again
+ * when needed.
+ */
+class ImageCache {
+public:
+    using Data = std::shared_ptr<const std::string>;
+
+    /**
+     * @brief Called (on a worker thread) when an image decoded in the background is ready
+     */
+    using Listener = std::function<void(const std::string* data)>;
+
+    static constexpr size_t MAX_BYTES = 256 * 1024 * 1024;
+
+    static ImageCache& getInstance();
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    /**
+     * @brief Get the image at full resolution, decoding it in the calling thread if necessary
+     * @return The surface, or nullptr if the data could not be decoded
+     */
+    xoj::util::CairoSurfaceSPtr getFullResolution(const Data& data);
+
+    /**
+     * @brief Get a surface suited for drawing the image with the given width
+     *
+     * @param data The encoded image
+     * @param pixelWidth The width of the image on the target, in device pixels
+     * @param wait If false and the required level is not decoded yet, the image is decoded in the background: a
+     *             coarser level is returned if there is one, nullptr otherwise, and the listener is notified when the
+     *             image is ready. If true, the image is decoded in the calling thread.
+     */
+    xoj::util::CairoSurfaceSPtr getSurface(const Data& data, double pixelWidth, bool wait);
+
+    /**
+     * @brief Set the function called when an image decoded in the background is ready (nullptr to remove it)
+     */
+    void setListener(Listener listener);
+
+private:
+    ImageCache() = default;
+    ~ImageCache();
+
+    struct Entry {
+        Data data;
+
+        /**
+         * levels[0] is the full resolution, each next level has half the size of the previous one.
+         * Empty if the image was never decoded. levels[0] may be nullptr if it was evicted.
+         */
+        std::vector<xoj::util::CairoSurfaceSPtr> levels;
+
+        size_t bytes = 0;
+        bool decoding = false;
+
+        /**
+         * The data could not be decoded: do not try again
+         */
+        bool failed = false;
+
+        std::list<const std::string*>::iterator lruPosition;
+    };
+
+    Entry& getEntry(const Data& data);
+
+    /**
+     * @return The index of the smallest level at least pixelWidth wide
+     */
+    static size_t levelForWidth(const Entry& entry, double pixelWidth);
+
+    /**
+     * @brief Decode the entry's image in the calling thread, or wait until the decoding by another thread is done
+     * The lock is released while decoding.
+     */
+    void decode(Entry& entry, std::unique_lock<std::mutex>& lock);
+
+    static std::vector<xoj::util::CairoSurfaceSPtr> createPyramid(const std::string& data);
+
+    void store(Entry& entry, std::vector<xoj::util::CairoSurfaceSPtr> levels);
+    void touch(Entry& entry);
+    void evict();
+
+    void decodeInBackground(const Data& data);
+    void workerLoop();
+
+private:
+    std::mutex mutex;
+    std::condition_variable decodingDone;
+
+    std::unordered_map<const std::string*, Entry> entries;
+
+    /**
+     * The decoded images, most recently used first
+     */
+    std::list<const std::string*> lru;
+    size_t totalBytes = 0;
+
+    std::deque<Data> queue;
+    std::condition_variable queueNotEmpty;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    std::mutex listenerMutex;
+    Listener listener;
+};
+};  // namespace xoj::view
@@ -1,12 +1,33 @@
 #include "ImageView.h"
 
+#include <cmath>   // for hypot
+#include <limits>  // for numeric_limits
+
 #include <cairo.h>  // for cairo_image_surface_get_height, cairo_image...
 
-#include "model/Image.h"  // for Image
-#include "view/View.h"    // for Context, OPACITY_NO_AUDIO, view
+#include "model/Image.h"              // for Image
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+#include "view/ImageCache.h"          // for ImageCache
+#include "view/View.h"                // for Context, OPACITY_NO_AUDIO, view
 
 using namespace xoj::view;
 
+namespace {
+/**
+ * @return The width of the image on the target of cr, in device pixels
+ */
+double getPixelWidth(cairo_t* cr, double width) {
+    if (cairo_surface_get_type(cairo_get_target(cr)) != CAIRO_SURFACE_TYPE_IMAGE) {
+        // Vector targets (PDF or SVG export, printing...) get the full resolution
+        return std::numeric_limits<double>::infinity();
+    }
+    double dx = width;
+    double dy = 0;
+    cairo_user_to_device_distance(cr, &dx, &dy);  // Includes the target's device scale
+    return std::hypot(dx, dy);
+}
+}  // namespace
+
 ImageView::ImageView(const Image* image): image(image) {}
 
 ImageView::~ImageView() = default;
@@ -16,9 +37,20 @@ void ImageView::draw(const Context& ctx) const {
 
     cairo_save(cr);
 
-    cairo_surface_t* img = image->getImage();
-    int width = cairo_image_surface_get_width(img);
-    int height = cairo_image_surface_get_height(img);
+    xoj::util::CairoSurfaceSPtr img = ImageCache::getInstance().getSurface(
+            image->getSharedData(), getPixelWidth(cr, image->getElementWidth()), ctx.waitForImages);
+
+    if (!img) {
+        // The image is being decoded in the background: the page is rendered again once it is ready
+        cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.2);
+        cairo_rectangle(cr, image->getX(), image->getY(), image->getElementWidth(), image->getElementHeight());
+        cairo_fill(cr);
+        cairo_restore(cr);
+        return;
+    }
+
+    int width = cairo_image_surface_get_width(img.get());
+    int height = cairo_image_surface_get_height(img.get());
 
     cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
 
@@ -27,7 +59,7 @@ void ImageView::draw(const Context& ctx) const {
 
     cairo_scale(cr, xFactor, yFactor);
 
-    cairo_set_source_surface(cr, img, image->getX() / xFactor, image->getY() / yFactor);
+    cairo_set_source_surface(cr, img.get(), image->getX() / xFactor, image->getY() / yFactor);
     // make images translucent when highlighting elements with audio, as they can not have audio
     if (ctx.fadeOutNonAudio) {
         cairo_paint_with_alpha(cr, OPACITY_NO_AUDIO);
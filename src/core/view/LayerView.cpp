@@ -6,10 +6,12 @@
 #include <cairo.h>  // for cairo_clip_extents, cairo_rectangle
 #include <glib.h>   // for g_message
 
-#include "model/Element.h"  // for Element
+#include "model/Element.h"  // for Element, ELEMENT_STROKE
 #include "model/Layer.h"    // for Layer
+#include "model/Stroke.h"   // for Stroke
 
 #include "DebugShowRepaintBounds.h"  // for IF_DEBUG_REPAINT
+#include "StrokeView.h"              // for StrokeView
 #include "View.h"                    // for Context, ElementView
 
 using namespace xoj::view;
@@ -28,6 +30,18 @@ void LayerView::draw(const Context& ctx) const {
     double maxY;
     cairo_clip_extents(ctx.cr, &minX, &minY, &maxX, &maxY);
 
+    /*
+     * With ctx.compactPaths, consecutive plain strokes of the same style are drawn together, as a single path. Any
+     * other element ends the run, so that the painting order is preserved.
+     */
+    std::vector<const Stroke*> strokeRun;
+    auto drawStrokeRun = [&strokeRun, &ctx]() {
+        if (!strokeRun.empty()) {
+            StrokeView::drawMerged(ctx, strokeRun);
+            strokeRun.clear();
+        }
+    };
+
     for (auto& e: layer->getElements()) {
 
         IF_DEBUG_REPAINT({
@@ -40,10 +54,20 @@ void LayerView::draw(const Context& ctx) const {
         });
 
         if (e->intersectsArea(minX, minY, maxX - minX, maxY - minY)) {
-            ElementView::createFromElement(e)->draw(ctx);
+            const auto* stroke = e->getType() == ELEMENT_STROKE ? dynamic_cast<const Stroke*>(e) : nullptr;
+            if (ctx.compactPaths && stroke && StrokeView::isMergeable(ctx, *stroke)) {
+                if (!strokeRun.empty() && !StrokeView::haveSameStyle(*strokeRun.front(), *stroke)) {
+                    drawStrokeRun();
+                }
+                strokeRun.push_back(stroke);
+            } else {
+                drawStrokeRun();
+                ElementView::createFromElement(e)->draw(ctx);
+            }
             IF_DEBUG_REPAINT(drawn++;);
         }
         IF_DEBUG_REPAINT(else { notDrawn++; });
     }
+    drawStrokeRun();
     IF_DEBUG_REPAINT(g_message("DBG:LayerView::draw: draw %i / not draw %i", drawn, notDrawn););
 }
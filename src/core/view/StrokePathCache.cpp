@@ -0,0 +1,123 @@
+#include "StrokePathCache.h"
+
+#include <iterator>  // for next
+#include <utility>   // for move
+
+#include "model/Point.h"   // for Point
+#include "model/Stroke.h"  // for Stroke
+
+#include "StrokeViewHelper.h"  // for pathToCairo
+
+using namespace xoj::view;
+
+namespace {
+auto pathBytes(const std::vector<cairo_path_data_t>& data) -> size_t { return data.size() * sizeof(cairo_path_data_t); }
+
+void appendElement(std::vector<cairo_path_data_t>& data, cairo_path_data_type_t type, const Point& p) {
+    cairo_path_data_t header;
+    header.header.type = type;
+    header.header.length = 2;
+    data.push_back(header);
+
+    cairo_path_data_t point;
+    point.point.x = p.x;
+    point.point.y = p.y;
+    data.push_back(point);
+}
+}  // namespace
+
+auto StrokePathCache::getInstance() -> StrokePathCache& {
+    static StrokePathCache instance;
+    return instance;
+}
+
+auto StrokePathCache::buildPathData(const std::vector<Point>& pts) -> std::vector<cairo_path_data_t> {
+    std::vector<cairo_path_data_t> data;
+    if (pts.empty()) {
+        return data;
+    }
+    data.reserve(2 * pts.size());
+
+    constexpr double squaredTolerance = FLATTEN_TOLERANCE * FLATTEN_TOLERANCE;
+    const Point* last = &pts.front();
+    appendElement(data, CAIRO_PATH_MOVE_TO, *last);
+    for (auto it = std::next(pts.begin()); it != pts.end(); ++it) {
+        const double dx = it->x - last->x;
+        const double dy = it->y - last->y;
+        // The last point is always kept, so that the path ends where the stroke does
+        if (dx * dx + dy * dy >= squaredTolerance || std::next(it) == pts.end()) {
+            last = &*it;
+            appendElement(data, CAIRO_PATH_LINE_TO, *last);
+        }
+    }
+    data.shrink_to_fit();
+    return data;
+}
+
+void StrokePathCache::appendPath(cairo_t* cr, const Stroke& s) {
+    const auto& pts = s.getPointVector();
+    if (pts.size() < MIN_POINTS) {
+        StrokeViewHelper::pathToCairo(cr, pts);
+        return;
+    }
+
+    const uint64_t revision = s.getPointsRevision().get();
+    std::shared_ptr<const std::vector<cairo_path_data_t>> data;
+    {
+        std::lock_guard lock(mutex);
+        auto it = entries.find(&s);
+        if (it != entries.end() && it->second.revision == revision) {
+            lru.splice(lru.begin(), lru, it->second.lruPosition);
+            data = it->second.data;
+        }
+    }
+
+    if (!data) {
+        // Built without the lock: two threads may build the same path, the last one is kept
+        auto built = std::make_shared<const std::vector<cairo_path_data_t>>(buildPathData(pts));
+        data = built;
+
+        std::lock_guard lock(mutex);
+        auto [it, inserted] = entries.try_emplace(&s);
+        Entry& entry = it->second;
+        if (inserted) {
+            lru.push_front(&s);
+            entry.lruPosition = lru.begin();
+        } else {
+            totalBytes -= pathBytes(*entry.data);
+            lru.splice(lru.begin(), lru, entry.lruPosition);
+        }
+        entry.revision = revision;
+        entry.data = std::move(built);
+        totalBytes += pathBytes(*entry.data);
+        evict();
+    }
+
+    cairo_path_t path;
+    path.status = CAIRO_STATUS_SUCCESS;
+    path.data = const_cast<cairo_path_data_t*>(data->data());
+    path.num_data = static_cast<int>(data->size());
+    cairo_append_path(cr, &path);
+}
+
+void StrokePathCache::evict() {
+    // Keep at least the most recently used path, even if it exceeds the budget by itself
+    while (totalBytes > MAX_BYTES && lru.size() > 1) {
+        auto it = entries.find(lru.back());
+        totalBytes -= pathBytes(*it->second.data);
+        entries.erase(it);
+        lru.pop_back();
+    }
+}
+
+auto StrokePathCache::getBytes() -> size_t {
+    std::lock_guard lock(mutex);
+    return totalBytes;
+}
+
+void StrokePathCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+    lru.clear();
+    totalBytes = 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Xournal++
+ *
+ * Cache of the cairo paths of strokes
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <list>           // for list
+#include <memory>         // for shared_ptr
+#include <mutex>          // for mutex
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include <cairo.h>  // for cairo_t, cairo_path_data_t
+
+class Point;
+class Stroke;
+
+namespace xoj::view {
+
+/**
+ * @brief Prepared cairo paths of the strokes, in page coordinates
+ *
+ * Rendering a stroke at another zoom level, printing it or exporting it replays the same path. The path is flattened
+ * once (points closer than FLATTEN_TOLERANCE to the previous one are dropped) and kept as a cairo path, which is
+ * appended to the context in one call.
+ *
+ * An entry is valid as long as the stroke's points revision is unchanged. The paths are bounded by MAX_BYTES: the least
+ * recently used ones are evicted first. Entries of deleted strokes are never matched again (revisions are unique) and
+ * are evicted in the same way.
+ *
+ * The cache is used by the rendering threads as well as by the main thread.
+ */
+class StrokePathCache {
+public:
+    static constexpr size_t MAX_BYTES = 64 * 1024 * 1024;
+
+    /**
+     * Strokes with fewer points are not cached: building their path is as fast as a lookup
+     */
+    static constexpr size_t MIN_POINTS = 16;
+
+    /**
+     * Maximal distance between a dropped point and the previous kept one, in page coordinates (1/72 inch)
+     */
+    static constexpr double FLATTEN_TOLERANCE = 0.01;
+
+    static StrokePathCache& getInstance();
+
+    StrokePathCache(const StrokePathCache&) = delete;
+    StrokePathCache& operator=(const StrokePathCache&) = delete;
+
+    /**
+     * @brief Add the stroke's points to the context, as a single path
+     */
+    void appendPath(cairo_t* cr, const Stroke& s);
+
+    /**
+     * @return The memory used by the cached paths, in bytes
+     */
+    size_t getBytes();
+
+    /**
+     * @brief Remove all the cached paths
+     */
+    void clear();
+
+    /**
+     * @brief Build the flattened cairo path data of the points
+     */
+    static std::vector<cairo_path_data_t> buildPathData(const std::vector<Point>& pts);
+
+private:
+    StrokePathCache() = default;
+
+    struct Entry {
+        uint64_t revision = 0;
+        std::shared_ptr<const std::vector<cairo_path_data_t>> data;
+        std::list<const Stroke*>::iterator lruPosition;
+    };
+
+    void evict();
+
+private:
+    std::mutex mutex;
+
+    std::unordered_map<const Stroke*, Entry> entries;
+
+    /**
+     * The cached strokes, most recently used first
+     */
+    std::list<const Stroke*> lru;
+    size_t totalBytes = 0;
+};
+};  // namespace xoj::view
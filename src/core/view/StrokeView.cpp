@@ -3,16 +3,19 @@
 #include <algorithm>  // for max
 #include <cassert>    // for assert
 #include <cmath>      // for ceil
+#include <vector>     // for vector
 
 #include <glib.h>  // for g_warning
 
 #include "model/Stroke.h"     // for Stroke, StrokeTool::HIGHLIGHTER
 #include "util/Color.h"       // for cairo_set_source_rgbi
 #include "util/Rectangle.h"   // for Rectangle
+#include "util/Util.h"        // for cairo_set_dash_from_vector
 #include "view/Mask.h"        // for Mask
 #include "view/View.h"        // for Context, OPACITY_NO_AUDIO, view
 
 #include "ErasableStrokeView.h"  // for ErasableStrokeView
+#include "StrokePathCache.h"     // for StrokePathCache
 #include "StrokeViewHelper.h"
 #include "filesystem.h"          // for path
 
@@ -33,7 +36,7 @@ void StrokeView::draw(const Context& ctx) const {
 
     const bool highlighter = s->getToolType() == StrokeTool::HIGHLIGHTER;
     const bool filledHighlighter = highlighter && s->getFill() != -1;
-    const bool drawTranslucent = ctx.fadeOutNonAudio && s->getAudioFilename().empty();
+    const bool drawTranslucent = ctx.isFadedOut(*s);
     const bool useMask = (!ctx.noColor && filledHighlighter) || drawTranslucent;
 
     if (ctx.showCurrentEdition && filledHighlighter && s->getErasable() != nullptr) {
@@ -100,7 +103,7 @@ void StrokeView::draw(const Context& ctx) const {
             ErasableStrokeView erasableStrokeView(*erasable);
             erasableStrokeView.drawFilling(cr);
         } else {
-            StrokeViewHelper::pathToCairo(cr, s->getPointVector());
+            StrokePathCache::getInstance().appendPath(cr, *s);
             cairo_fill(cr);
         }
     }
@@ -133,9 +136,13 @@ void StrokeView::draw(const Context& ctx) const {
         ErasableStrokeView erasableStrokeView(*erasable);
         erasableStrokeView.draw(cr);
     } else if (s->hasPressure() && !highlighter) {
-        StrokeViewHelper::drawWithPressure(cr, s->getPointVector(), s->getLineStyle());
+        if (ctx.compactPaths && !s->getLineStyle().hasDashes()) {
+            StrokeViewHelper::fillWithPressure(cr, s->getPointVector(), CAIRO_LINE_CAP[s->getStrokeCapStyle()]);
+        } else {
+            StrokeViewHelper::drawWithPressure(cr, s->getPointVector(), s->getLineStyle());
+        }
     } else {
-        StrokeViewHelper::drawNoPressure(cr, s->getPointVector(), s->getWidth(), s->getLineStyle());
+        StrokeViewHelper::drawNoPressure(cr, *s);
     }
 
     if (useMask) {
@@ -167,3 +174,37 @@ void StrokeView::draw(const Context& ctx) const {
         mask.blitTo(ctx.cr);
     }
 }
+
+auto StrokeView::isMergeable(const Context& ctx, const Stroke& s) -> bool {
+    return !ctx.fadeOutNonAudio && !ctx.noColor && s.getPointCount() >= 2 && !s.hasPressure() &&
+           s.getToolType() != StrokeTool::HIGHLIGHTER && s.getFill() == -1 &&
+           (s.getErasable() == nullptr || !ctx.showCurrentEdition);
+}
+
+auto StrokeView::haveSameStyle(const Stroke& a, const Stroke& b) -> bool {
+    return a.getColor() == b.getColor() && a.getWidth() == b.getWidth() &&
+           a.getStrokeCapStyle() == b.getStrokeCapStyle() && a.getToolType() == b.getToolType() &&
+           a.getLineStyle() == b.getLineStyle();
+}
+
+void StrokeView::drawMerged(const Context& ctx, const std::vector<const Stroke*>& strokes) {
+    assert(!strokes.empty());
+    const Stroke& first = *strokes.front();
+
+    xoj::util::CairoSaveGuard saveGuard(ctx.cr);
+    cairo_t* cr = ctx.cr;
+
+    cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
+    cairo_set_line_cap(cr, CAIRO_LINE_CAP[first.getStrokeCapStyle()]);
+    cairo_set_line_width(cr, first.getWidth());
+    // The dash pattern starts over at the beginning of each subpath, as for separate strokes
+    Util::cairo_set_dash_from_vector(cr, first.getLineStyle().getDashes(), 0);
+    Util::cairo_set_source_rgbi(cr, first.getColor());
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+
+    for (const Stroke* s: strokes) {
+        assert(haveSameStyle(first, *s));
+        StrokePathCache::getInstance().appendPath(cr, *s);
+    }
+    cairo_stroke(cr);
+}
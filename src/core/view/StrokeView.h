@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <vector>  // for vector
+
 #include <cairo.h>  // for cairo_t, CAIRO_LINE_CAP_BUTT, CAIRO_LINE_CAP_ROUND
 
 #include "View.h"  // for ElementView
@@ -32,6 +34,23 @@ public:
      */
     void draw(const Context& ctx) const override;
 
+    /**
+     * @brief Whether the stroke is a plain pen stroke (no pressure, no filling, not being erased), which can be drawn
+     * in the same path as other strokes of the same style (see drawMerged()).
+     */
+    static bool isMergeable(const Context& ctx, const Stroke& s);
+
+    /**
+     * @brief Whether the strokes have the same color, width, cap style, tool and line style
+     */
+    static bool haveSameStyle(const Stroke& a, const Stroke& b);
+
+    /**
+     * @brief Paint consecutive mergeable strokes of the same style with a single cairo_stroke().
+     * For vector outputs: the strokes are written as one path object, instead of one per stroke.
+     */
+    static void drawMerged(const Context& ctx, const std::vector<const Stroke*>& strokes);
+
 private:
     const Stroke* s;
 
@@ -1,13 +1,19 @@
 #include "StrokeViewHelper.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <iterator>
 
 #include "model/LineStyle.h"
 #include "model/Point.h"
+#include "model/Stroke.h"
 #include "util/LoopUtil.h"
 #include "util/PairView.h"
 #include "util/Util.h"  // for cairo_set_dash_from_vector
 
+#include "StrokePathCache.h"
+
 void xoj::view::StrokeViewHelper::pathToCairo(cairo_t* cr, const std::vector<Point>& pts) {
     for_first_then_each(
             pts, [cr](auto const& first) { cairo_move_to(cr, first.x, first.y); },
@@ -28,6 +34,16 @@ void xoj::view::StrokeViewHelper::drawNoPressure(cairo_t* cr, const std::vector<
     cairo_stroke(cr);
 }
 
+void xoj::view::StrokeViewHelper::drawNoPressure(cairo_t* cr, const Stroke& s) {
+    cairo_set_line_width(cr, s.getWidth());
+
+    const auto& dashes = s.getLineStyle().getDashes();
+    Util::cairo_set_dash_from_vector(cr, dashes, 0);
+
+    StrokePathCache::getInstance().appendPath(cr, s);
+    cairo_stroke(cr);
+}
+
 /**
  * Draw a stroke with pressure, for this multiple lines with different widths needs to be drawn
  */
@@ -60,3 +76,132 @@ double xoj::view::StrokeViewHelper::drawWithPressure(cairo_t* cr, const std::vec
     }
     return dashOffset;
 }
+
+namespace {
+struct Segment {
+    double x0, y0;
+    double x1, y1;
+    /// Unit direction
+    double dx, dy;
+    double halfWidth;
+};
+
+/**
+ * Normal pointing to the left of the direction
+ */
+auto normalAngle(double dx, double dy) -> double { return std::atan2(dx, -dy); }
+
+/**
+ * @brief Join the side of segment a to the same side of segment b, around their common point
+ * The side is the left side of the direction of travel (for the right side, the segments are given reversed).
+ */
+void addJoin(cairo_t* cr, const Segment& a, const Segment& b) {
+    const double cross = a.dx * b.dy - a.dy * b.dx;
+    const double x = a.x1;
+    const double y = a.y1;
+    if (cross > 0) {
+        // Inner side: going through the center keeps the overlapping parts of the outline in the same orientation, so
+        // that the nonzero fill rule fills them
+        cairo_line_to(cr, x, y);
+        cairo_line_to(cr, x - b.dy * b.halfWidth, y + b.dx * b.halfWidth);
+        return;
+    }
+
+    // Outer side: round join, unless it would not differ from a straight line
+    const double cosAngle = a.dx * b.dx + a.dy * b.dy;
+    const double sagitta = b.halfWidth * (1 - std::sqrt(std::max(0.0, (1 + cosAngle) / 2)));
+    if (sagitta < xoj::view::StrokePathCache::FLATTEN_TOLERANCE) {
+        cairo_line_to(cr, x - b.dy * b.halfWidth, y + b.dx * b.halfWidth);
+    } else {
+        cairo_arc_negative(cr, x, y, b.halfWidth, normalAngle(a.dx, a.dy), normalAngle(b.dx, b.dy));
+    }
+}
+
+/**
+ * @brief Go around the end of the segment, from its left side to its right side
+ */
+void addCap(cairo_t* cr, const Segment& s, cairo_line_cap_t cap) {
+    const double nx = -s.dy * s.halfWidth;
+    const double ny = s.dx * s.halfWidth;
+    switch (cap) {
+        case CAIRO_LINE_CAP_ROUND: {
+            const double angle = normalAngle(s.dx, s.dy);
+            cairo_arc_negative(cr, s.x1, s.y1, s.halfWidth, angle, angle - M_PI);
+            break;
+        }
+        case CAIRO_LINE_CAP_SQUARE:
+            cairo_line_to(cr, s.x1 + nx + s.dx * s.halfWidth, s.y1 + ny + s.dy * s.halfWidth);
+            cairo_line_to(cr, s.x1 - nx + s.dx * s.halfWidth, s.y1 - ny + s.dy * s.halfWidth);
+            break;
+        default:
+            break;
+    }
+    cairo_line_to(cr, s.x1 - nx, s.y1 - ny);
+}
+
+auto reversed(const Segment& s) -> Segment { return {s.x1, s.y1, s.x0, s.y0, -s.dx, -s.dy, s.halfWidth}; }
+}  // namespace
+
+void xoj::view::StrokeViewHelper::fillWithPressure(cairo_t* cr, const std::vector<Point>& pts, cairo_line_cap_t cap) {
+    if (pts.empty()) {
+        return;
+    }
+
+    /*
+     * Segment k goes from pts[k] to pts[k + 1] with the width pts[k].z, as in drawWithPressure(). Points too close to
+     * the previous one are skipped.
+     */
+    std::vector<Segment> segments;
+    segments.reserve(pts.size());
+    const Point* p = &pts.front();
+    for (auto it = std::next(pts.begin()); it != pts.end(); ++it) {
+        const double length = p->lineLengthTo(*it);
+        if (length < StrokePathCache::FLATTEN_TOLERANCE) {
+            continue;
+        }
+        assert(p->z > 0.0);
+        segments.push_back({p->x, p->y, it->x, it->y, (it->x - p->x) / length, (it->y - p->y) / length, p->z / 2});
+        p = &*it;
+    }
+
+    cairo_new_path(cr);
+    if (segments.empty()) {
+        // A dot
+        const Point& dot = pts.front();
+        if (cap == CAIRO_LINE_CAP_ROUND) {
+            cairo_arc(cr, dot.x, dot.y, dot.z / 2, 0, 2 * M_PI);
+        } else if (cap == CAIRO_LINE_CAP_SQUARE) {
+            cairo_rectangle(cr, dot.x - dot.z / 2, dot.y - dot.z / 2, dot.z, dot.z);
+        }
+        cairo_fill(cr);
+        return;
+    }
+
+    /*
+     * The outline goes forward along the left side, around the end, back along the right side and around the start.
+     * All its parts turn in the same direction.
+     */
+    const Segment& first = segments.front();
+    cairo_move_to(cr, first.x0 - first.dy * first.halfWidth, first.y0 + first.dx * first.halfWidth);
+    for (size_t k = 0; k < segments.size(); k++) {
+        const Segment& s = segments[k];
+        cairo_line_to(cr, s.x1 - s.dy * s.halfWidth, s.y1 + s.dx * s.halfWidth);
+        if (k + 1 < segments.size()) {
+            addJoin(cr, s, segments[k + 1]);
+        }
+    }
+    addCap(cr, segments.back(), cap);
+
+    for (size_t k = segments.size(); k-- > 0;) {
+        const Segment s = reversed(segments[k]);
+        cairo_line_to(cr, s.x1 - s.dy * s.halfWidth, s.y1 + s.dx * s.halfWidth);
+        if (k > 0) {
+            addJoin(cr, s, reversed(segments[k - 1]));
+        }
+    }
+    addCap(cr, reversed(first), cap);
+    cairo_close_path(cr);
+
+    cairo_set_fill_rule(cr, CAIRO_FILL_RULE_WINDING);
+    cairo_fill(cr);
+}
@@ -17,6 +17,7 @@
 
 class LineStyle;
 class Point;
+class Stroke;
 
 namespace xoj::view::StrokeViewHelper {
 
@@ -31,10 +32,23 @@ void pathToCairo(cairo_t* cr, const std::vector<Point>& pts);
 void drawNoPressure(cairo_t* cr, const std::vector<Point>& pts, const double strokeWidth, const LineStyle& lineStyle,
                     double dashOffset = 0);
 
+/**
+ * @brief Same as above, for a whole stroke, with its width and line style. The path is taken from the StrokePathCache.
+ */
+void drawNoPressure(cairo_t* cr, const Stroke& s);
+
 /**
  * @brief Draw a stroke with pressure, for this multiple lines with different widths needs to be drawn.
  * @return New dash offset, if one wants to keep on drawing the same stroke.
  *      Effectively, the return value equals dashOffset + length of the path.
  */
 double drawWithPressure(cairo_t* cr, const std::vector<Point>& pts, const LineStyle& lineStyle, double dashOffset = 0);
+
+/**
+ * @brief Draw a stroke with pressure (without dashes) by filling its outline, as a single path.
+ * Same shape as drawWithPressure(), except for the small steps where the width changes between two segments, with one
+ * fill instead of one cairo_stroke() per segment: vector outputs get one path object per stroke. The outer joins are
+ * round, the ends are drawn with the given cap.
+ */
+void fillWithPressure(cairo_t* cr, const std::vector<Point>& pts, cairo_line_cap_t cap);
 };  // namespace xoj::view::StrokeViewHelper
@@ -37,7 +37,7 @@ void TextView::draw(const Context& ctx) const {
     xoj::util::CairoSaveGuard saveGuard(ctx.cr);
 
     // make elements without audio translucent when highlighting elements with audio
-    if (ctx.fadeOutNonAudio && text->getAudioFilename().empty()) {
+    if (ctx.isFadedOut(*text)) {
         cairo_set_operator(ctx.cr, CAIRO_OPERATOR_OVER);
         Util::cairo_set_source_rgbi(ctx.cr, text->getColor(), OPACITY_NO_AUDIO);
     } else {
@@ -0,0 +1,223 @@
+#include "ThumbnailCache.h"
+
+#include <algorithm>  // for max, clamp
+#include <cmath>      // for ceil
+#include <iterator>   // for prev
+#include <limits>     // for numeric_limits
+#include <utility>    // for move
+
+using namespace xoj::view;
+using xoj::util::CairoSurfaceSPtr;
+
+namespace {
+auto surfaceBytes(cairo_surface_t* surface) -> size_t {
+    return static_cast<size_t>(cairo_image_surface_get_stride(surface)) *
+           static_cast<size_t>(cairo_image_surface_get_height(surface));
+}
+}  // namespace
+
+auto ThumbnailCache::getInstance() -> ThumbnailCache& {
+    static ThumbnailCache instance;
+    return instance;
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    queueNotEmpty.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+auto ThumbnailCache::bucketWidth(double pixelWidth) -> int {
+    int buckets = std::max(1, static_cast<int>(std::ceil(pixelWidth / BUCKET_WIDTH)));
+    return buckets * BUCKET_WIDTH;
+}
+
+auto ThumbnailCache::get(const Source& source, uint64_t revision, double pageWidth, double pageHeight,
+                         double pixelWidth, Renderer render, bool wait, Listener onReady) -> CairoSurfaceSPtr {
+    const Key key{source.get(), bucketWidth(pixelWidth)};
+
+    std::unique_lock lock(mutex);
+    Entry& entry = getEntry(key, source);
+    touch(entry);
+    if (entry.surface && entry.revision == revision) {
+        return entry.surface;
+    }
+
+    Task task{key, source, revision, pageWidth, pageHeight, std::move(render)};
+    if (wait) {
+        lock.unlock();
+        CairoSurfaceSPtr surface = renderThumbnail(task);
+        lock.lock();
+        // The entry may have been evicted in the meantime
+        store(getEntry(key, source), surface, revision);
+        return surface;
+    }
+
+    if (onReady) {
+        entry.listeners.emplace_back(std::move(onReady));
+    }
+    if (!entry.rendering || entry.requestedRevision != revision) {
+        entry.rendering = true;
+        entry.requestedRevision = revision;
+        renderInBackground(std::move(task));
+    }
+
+    if (entry.surface) {
+        // Outdated, but better than nothing
+        return entry.surface;
+    }
+    // Use the thumbnail of another size as placeholder, if there is one
+    for (auto it = entries.lower_bound({key.first, std::numeric_limits<int>::min()});
+         it != entries.end() && it->first.first == key.first; ++it) {
+        if (it->second.surface) {
+            return it->second.surface;
+        }
+    }
+    return {};
+}
+
+auto ThumbnailCache::getBytes() -> size_t {
+    std::lock_guard lock(mutex);
+    return totalBytes;
+}
+
+auto ThumbnailCache::getEntry(const Key& key, const Source& source) -> Entry& {
+    auto [it, inserted] = entries.try_emplace(key);
+    Entry& entry = it->second;
+    if (inserted) {
+        lru.push_front(key);
+        entry.lruPosition = lru.begin();
+    } else if (entry.owner.expired() && !entry.rendering) {
+        // The previous source at this address was deleted
+        totalBytes -= entry.bytes;
+        entry.bytes = 0;
+        entry.surface.reset();
+    }
+    entry.owner = source;
+    return entry;
+}
+
+auto ThumbnailCache::renderThumbnail(const Task& task) -> CairoSurfaceSPtr {
+    const int width = task.key.second;
+    const double scale = width / task.pageWidth;
+    const int height = std::max(1, static_cast<int>(std::ceil(task.pageHeight * scale)));
+
+    CairoSurfaceSPtr surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height), xoj::util::adopt);
+    xoj::util::CairoSPtr cr(cairo_create(surface.get()), xoj::util::adopt);
+    cairo_scale(cr.get(), scale, scale);
+    task.render(cr.get());
+    cairo_surface_flush(surface.get());
+    return surface;
+}
+
+void ThumbnailCache::store(Entry& entry, CairoSurfaceSPtr surface, uint64_t revision) {
+    totalBytes -= entry.bytes;
+    entry.bytes = surfaceBytes(surface.get());
+    totalBytes += entry.bytes;
+    entry.surface = std::move(surface);
+    entry.revision = revision;
+
+    touch(entry);
+    evict();
+}
+
+void ThumbnailCache::touch(Entry& entry) { lru.splice(lru.begin(), lru, entry.lruPosition); }
+
+void ThumbnailCache::evict() {
+    // Forget the thumbnails of deleted sources
+    for (auto it = lru.begin(); it != lru.end();) {
+        auto entryIt = entries.find(*it);
+        if (entryIt->second.owner.expired() && !entryIt->second.rendering) {
+            totalBytes -= entryIt->second.bytes;
+            entries.erase(entryIt);
+            it = lru.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (lru.empty()) {
+        return;
+    }
+
+    // The most recently used thumbnail is never evicted: it is the one which is being drawn
+    for (auto it = std::prev(lru.end()); totalBytes > MAX_BYTES && it != lru.begin();) {
+        auto entryIt = entries.find(*it);
+        Entry& entry = entryIt->second;
+        if (entry.rendering) {
+            // Keep the entry (and its listeners) until the rendering is done
+            totalBytes -= entry.bytes;
+            entry.bytes = 0;
+            entry.surface.reset();
+            --it;
+        } else {
+            totalBytes -= entry.bytes;
+            entries.erase(entryIt);
+            it = std::prev(lru.erase(it));
+        }
+    }
+}
+
+void ThumbnailCache::renderInBackground(Task task) {
+    queue.push_front(std::move(task));
+
+    if (workers.empty()) {
+        unsigned int count = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 2U);
+        for (unsigned int n = 0; n < count; n++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+    queueNotEmpty.notify_one();
+}
+
+void ThumbnailCache::workerLoop() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        queueNotEmpty.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (stopping) {
+            return;
+        }
+        Task task = std::move(queue.front());
+        queue.pop_front();
+
+        auto it = entries.find(task.key);
+        if (it == entries.end() || it->second.requestedRevision != task.revision) {
+            // A newer revision was requested in the meantime
+            continue;
+        }
+        Source source = task.source.lock();
+        if (!source) {
+            // Nobody needs this thumbnail anymore
+            it->second.rendering = false;
+            it->second.listeners.clear();
+            continue;
+        }
+
+        lock.unlock();
+        CairoSurfaceSPtr surface = renderThumbnail(task);
+        // Release the source outside of the lock: it may be its last reference
+        source.reset();
+        lock.lock();
+
+        it = entries.find(task.key);
+        if (it == entries.end() || it->second.requestedRevision != task.revision) {
+            continue;
+        }
+        Entry& entry = it->second;
+        entry.rendering = false;
+        std::vector<Listener> listeners = std::move(entry.listeners);
+        entry.listeners.clear();
+        store(entry, std::move(surface), task.revision);
+
+        lock.unlock();
+        for (auto& listener: listeners) {
+            listener();
+        }
+        lock.lock();
+    }
+}
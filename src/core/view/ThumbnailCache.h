@@ -0,0 +1,161 @@
+/*
+ * Xournal++
+ *
+ * Cache of page thumbnails
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <list>                // for list
+#include <map>                 // for map
+#include <memory>              // for shared_ptr, weak_ptr
+#include <mutex>               // for mutex
+#include <thread>              // for thread
+#include <utility>             // for pair
+#include <vector>              // for vector
+
+#include <cairo.h>  // for cairo_t
+
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+namespace xoj::view {
+
+/**
+ * @brief Thumbnails of pages, shared by the page sidebar and the page selection dialogs
+ *
+ * A thumbnail is identified by its source (a page, a PDF page...), the revision of the source's content and a width
+ * bucket: the thumbnail is rendered at a width rounded up to a multiple of BUCKET_WIDTH pixels, and scaled down by the
+ * caller.
+ *
+ * Thumbnails can be rendered on background workers: until the thumbnail is ready, the caller gets the outdated
+ * thumbnail of the source if there is one, and is then notified. The thumbnails are bounded by MAX_BYTES, the least
+ * recently used ones are evicted first. The cache only keeps weak references to the sources: the thumbnails of deleted
+ * sources are dropped.
+ */
+class ThumbnailCache {
+public:
+    using Source = std::shared_ptr<const void>;
+
+    /**
+     * @brief Draws the source, in its own coordinates, on a context scaled to the thumbnail
+     * The source is kept alive while the renderer runs: the renderer should not hold a reference to it, so that the
+     * queued renderings of deleted sources are skipped.
+     */
+    using Renderer = std::function<void(cairo_t* cr)>;
+
+    /**
+     * @brief Called (on a worker thread) when a thumbnail rendered in the background is ready
+     */
+    using Listener = std::function<void()>;
+
+    static constexpr size_t MAX_BYTES = 64 * 1024 * 1024;
+    static constexpr int BUCKET_WIDTH = 16;
+
+    static ThumbnailCache& getInstance();
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    /**
+     * @return The width (in pixels) of the thumbnails used for drawing the source with the given width
+     */
+    static int bucketWidth(double pixelWidth);
+
+    /**
+     * @brief Get a thumbnail of the source, at least pixelWidth wide
+     *
+     * @param source The page
+     * @param revision The revision of the page's content: a thumbnail of another revision is rendered again
+     * @param pageWidth The width of the page, in its own coordinates
+     * @param pageHeight The height of the page, in its own coordinates
+     * @param pixelWidth The width of the page on the target, in pixels
+     * @param render Draws the page. Must not depend on the calling thread if wait is false.
+     * @param wait If true and the thumbnail is not ready, it is rendered in the calling thread. Otherwise, it is
+     *             rendered in the background: the outdated thumbnail or nullptr is returned, and onReady is called
+     *             once the thumbnail is ready.
+     * @param onReady See wait
+     */
+    xoj::util::CairoSurfaceSPtr get(const Source& source, uint64_t revision, double pageWidth, double pageHeight,
+                                    double pixelWidth, Renderer render, bool wait, Listener onReady = nullptr);
+
+    /**
+     * @return The memory used by the thumbnails, in bytes
+     */
+    size_t getBytes();
+
+private:
+    ThumbnailCache() = default;
+    ~ThumbnailCache();
+
+    using Key = std::pair<const void*, int>;
+
+    struct Entry {
+        std::weak_ptr<const void> owner;
+
+        xoj::util::CairoSurfaceSPtr surface;
+        uint64_t revision = 0;
+        size_t bytes = 0;
+
+        /**
+         * A rendering of requestedRevision is queued or running
+         */
+        bool rendering = false;
+        uint64_t requestedRevision = 0;
+        std::vector<Listener> listeners;
+
+        std::list<Key>::iterator lruPosition;
+    };
+
+    struct Task {
+        Key key;
+        std::weak_ptr<const void> source;
+        uint64_t revision;
+        double pageWidth;
+        double pageHeight;
+        Renderer render;
+    };
+
+    Entry& getEntry(const Key& key, const Source& source);
+
+    static xoj::util::CairoSurfaceSPtr renderThumbnail(const Task& task);
+
+    void store(Entry& entry, xoj::util::CairoSurfaceSPtr surface, uint64_t revision);
+    void touch(Entry& entry);
+    void evict();
+
+    void renderInBackground(Task task);
+    void workerLoop();
+
+private:
+    std::mutex mutex;
+
+    /**
+     * Ordered, so that the thumbnails of a source are next to each other
+     */
+    std::map<Key, Entry> entries;
+
+    /**
+     * The thumbnails, most recently used first
+     */
+    std::list<Key> lru;
+    size_t totalBytes = 0;
+
+    /**
+     * The most recent requests come first: they are the ones for the visible pages
+     */
+    std::deque<Task> queue;
+    std::condition_variable queueNotEmpty;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+};  // namespace xoj::view
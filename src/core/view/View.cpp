@@ -0,0 +1,16 @@
+#include "View.h"
+
+#include "model/AudioElement.h"  // for AudioElement
+
+using namespace xoj::view;
+
+auto Context::isFadedOut(const AudioElement& e) const -> bool {
+    if (!this->fadeOutNonAudio) {
+        return false;
+    }
+    if (e.getAudioFilename().empty()) {
+        return true;
+    }
+    return this->audioReplay && e.getTimestamp() > this->audioReplay->timestamp &&
+           e.getAudioFilename() == this->audioReplay->file;
+}
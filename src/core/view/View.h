@@ -11,10 +11,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 
 #include <gtk/gtk.h>
 
+#include "filesystem.h"
+
+class AudioElement;
 class Element;
 
 namespace xoj {
@@ -23,6 +28,18 @@ namespace view {
 enum NonAudioTreatment : bool { FADE_OUT_NON_AUDIO_ = true, NORMAL_NON_AUDIO = false };
 enum EditionTreatment : bool { SHOW_CURRENT_EDITING = true, HIDE_CURRENT_EDITING = false };
 enum ColorTreatment : bool { COLORBLIND = true, NORMAL_COLOR = false };
+enum ImageLoading : bool { WAIT_FOR_IMAGES = true, LOAD_IMAGES_IN_BACKGROUND = false };
+enum PathCompaction : bool { COMPACT_PATHS = true, NO_PATH_COMPACTION = false };
+
+/**
+ * The recording being played, and the playback position
+ */
+struct AudioReplay {
+    /// The audio file, as stored in the elements
+    fs::path file;
+    /// In milliseconds
+    size_t timestamp;
+};
 
 class Context {
 public:
@@ -30,6 +47,17 @@ public:
     NonAudioTreatment fadeOutNonAudio;
     EditionTreatment showCurrentEdition;
     ColorTreatment noColor;
+    ImageLoading waitForImages = WAIT_FOR_IMAGES;
+    /// For vector outputs (PDF export): draw the strokes with as few paths as possible
+    PathCompaction compactPaths = NO_PATH_COMPACTION;
+    /// While fading out non-audio elements, the elements of this recording written after the playback position are
+    /// faded out as well
+    std::optional<AudioReplay> audioReplay = std::nullopt;
+
+    /**
+     * @return Whether the element is drawn translucent, see fadeOutNonAudio and audioReplay
+     */
+    bool isFadedOut(const AudioElement& e) const;
 
     static Context createDefault(cairo_t* cr) { return {cr, NORMAL_NON_AUDIO, HIDE_CURRENT_EDITING, NORMAL_COLOR}; }
     static Context createColorBlind(cairo_t* cr) { return {cr, NORMAL_NON_AUDIO, HIDE_CURRENT_EDITING, COLORBLIND}; }
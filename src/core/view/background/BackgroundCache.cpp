@@ -0,0 +1,95 @@
+#include "BackgroundCache.h"
+
+#include <algorithm>  // for remove_if
+
+#include <cairo.h>  // for CAIRO_CONTENT_COLOR_ALPHA
+
+#include "model/XojPage.h"  // for XojPage
+#include "util/Range.h"     // for Range
+#include "util/Util.h"      // for npos
+#include "view/Mask.h"      // for Mask
+
+#include "BackgroundView.h"  // for BackgroundView, BACKGROUND_SHOW_ALL
+
+using namespace xoj::view;
+
+bool BackgroundCache::Key::operator==(const Key& other) const {
+    // Background images are compared by content: the pixbuf is shared by all copies of a BackgroundImage
+    return type == other.type && color == other.color && image.getPixbuf() == other.image.getPixbuf() &&
+           pdfPageNr == other.pdfPageNr && width == other.width && height == other.height && zoom == other.zoom &&
+           dpiScaling == other.dpiScaling && transparent == other.transparent;
+}
+
+bool BackgroundCache::Key::isShareable() const { return transparent || !type.isSpecial(); }
+
+auto BackgroundCache::makeKey(const PageRef& page, double zoom, int dpiScaling) -> Key {
+    Key key;
+    key.width = page->getWidth();
+    key.height = page->getHeight();
+    key.zoom = zoom;
+    key.dpiScaling = dpiScaling;
+    key.transparent = !page->isLayerVisible(0);
+    if (key.transparent) {
+        // The checkerboard only depends on the page size
+        key.pdfPageNr = npos;
+        return key;
+    }
+
+    key.type = page->getBackgroundType();
+    if (key.type.isPdfPage()) {
+        key.pdfPageNr = page->getPdfPageNr();
+    } else if (key.type.isImagePage()) {
+        key.pdfPageNr = npos;
+        key.image = page->getBackgroundImage();
+    } else {
+        key.pdfPageNr = npos;
+        key.color = page->getBackgroundColor();
+    }
+    return key;
+}
+
+auto BackgroundCache::render(const PageRef& page, const Key& key, PdfCache* pdfCache) -> std::shared_ptr<const Mask> {
+    auto buffer = std::make_shared<Mask>(key.dpiScaling, Range(0, 0, key.width, key.height), key.zoom,
+                                         CAIRO_CONTENT_COLOR_ALPHA);
+    auto view = BackgroundView::createForPage(page, BACKGROUND_SHOW_ALL, pdfCache);
+    if (view) {
+        view->draw(buffer->get());
+    }
+    return buffer;
+}
+
+void BackgroundCache::update(Entry& entry, const PageRef& page, double zoom, int dpiScaling, PdfCache* pdfCache) {
+    Key key = makeKey(page, zoom, dpiScaling);
+    if (entry.buffer && entry.key == key) {
+        return;
+    }
+
+    if (!key.isShareable()) {
+        entry.buffer = render(page, key, pdfCache);
+        entry.key = std::move(key);
+        return;
+    }
+
+    std::lock_guard lock(sharedMutex);
+    shared.erase(std::remove_if(shared.begin(), shared.end(), [](const auto& e) { return e.second.expired(); }),
+                 shared.end());
+
+    for (const auto& [sharedKey, sharedBuffer]: shared) {
+        if (sharedKey == key) {
+            if (auto buffer = sharedBuffer.lock(); buffer) {
+                entry.buffer = std::move(buffer);
+                entry.key = std::move(key);
+                return;
+            }
+        }
+    }
+
+    entry.buffer = render(page, key, pdfCache);
+    shared.emplace_back(key, entry.buffer);
+    entry.key = std::move(key);
+}
+
+void BackgroundCache::clear() {
+    std::lock_guard lock(sharedMutex);
+    shared.clear();
+}
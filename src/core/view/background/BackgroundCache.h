@@ -0,0 +1,106 @@
+/*
+ * Xournal++
+ *
+ * Cache of rasterized page backgrounds
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr, weak_ptr
+#include <mutex>    // for mutex
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "model/BackgroundImage.h"  // for BackgroundImage
+#include "model/PageRef.h"          // for PageRef
+#include "model/PageType.h"         // for PageType
+#include "util/Color.h"             // for Color
+
+class PdfCache;
+
+namespace xoj::view {
+class Mask;
+
+/**
+ * @brief Rasterizes page backgrounds once per page and zoom level.
+ *
+ * The annotation layers are then painted on top of a copy of the cached background, so that changes of the
+ * annotations never require drawing the background again.
+ *
+ * Ruled backgrounds (plain, lined, graph...) only depend on a few parameters: pages with identical rulings share the
+ * same surface. A shared surface lives as long as one of the entries uses it.
+ */
+class BackgroundCache {
+public:
+    BackgroundCache() = default;
+    ~BackgroundCache() = default;
+
+    BackgroundCache(const BackgroundCache&) = delete;
+    BackgroundCache& operator=(const BackgroundCache&) = delete;
+
+    /**
+     * @brief Everything the rendered background of a page depends on
+     */
+    struct Key {
+        PageType type;
+        Color color{};
+        BackgroundImage image;
+        size_t pdfPageNr{};
+        double width{};
+        double height{};
+        double zoom{};
+        int dpiScaling{};
+
+        /**
+         * The background layer is hidden: a checkerboard is drawn instead
+         */
+        bool transparent{};
+
+        bool operator==(const Key& other) const;
+
+        /**
+         * @return true if the background only depends on its ruling, and can be shared between pages
+         */
+        bool isShareable() const;
+    };
+
+    /**
+     * @brief The rasterized background of a page, with the parameters it was rendered for
+     */
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Mask> buffer;
+    };
+
+    /**
+     * @brief Make sure the entry contains the page's current background, rendered at the given zoom.
+     * Does nothing if the background is unchanged since the entry was filled.
+     * The document must be locked.
+     *
+     * @param entry The entry to update
+     * @param page The page
+     * @param zoom The zoom level of the rendering
+     * @param dpiScaling The DPI scaling of the targeted monitor
+     * @param pdfCache The cache used for drawing PDF backgrounds (may be nullptr)
+     */
+    void update(Entry& entry, const PageRef& page, double zoom, int dpiScaling, PdfCache* pdfCache);
+
+    /**
+     * @brief Forget all shared backgrounds
+     */
+    void clear();
+
+private:
+    static Key makeKey(const PageRef& page, double zoom, int dpiScaling);
+    static std::shared_ptr<const Mask> render(const PageRef& page, const Key& key, PdfCache* pdfCache);
+
+    std::mutex sharedMutex;
+    std::vector<std::pair<Key, std::weak_ptr<const Mask>>> shared;
+};
+};  // namespace xoj::view
@@ -0,0 +1,70 @@
+#include "BackgroundRecorder.h"
+
+#include <utility>  // for move
+
+#include "model/XojPage.h"  // for XojPage
+
+using namespace xoj::view;
+
+bool BackgroundRecorder::Key::operator==(const Key& other) const {
+    // Background images are compared by content: the pixbuf is shared by all copies of a BackgroundImage
+    return type == other.type && color == other.color && image.getPixbuf() == other.image.getPixbuf() &&
+           width == other.width && height == other.height && transparent == other.transparent &&
+           showImage == other.showImage && showRuling == other.showRuling;
+}
+
+void BackgroundRecorder::draw(const PageRef& page, cairo_t* cr, BackgroundFlags bgFlags) {
+    Key key;
+    key.width = page->getWidth();
+    key.height = page->getHeight();
+    key.transparent = !page->isLayerVisible(0);
+    if (!key.transparent) {
+        key.type = page->getBackgroundType();
+        if (key.type.isPdfPage()) {
+            auto view = BackgroundView::createForPage(page, bgFlags);
+            if (view) {
+                view->draw(cr);
+            }
+            return;
+        }
+        if (key.type.isImagePage()) {
+            key.image = page->getBackgroundImage();
+            key.showImage = bgFlags.showImage;
+        } else {
+            key.color = page->getBackgroundColor();
+            key.showRuling = bgFlags.showRuling;
+        }
+    }
+
+    auto it = recordings.begin();
+    while (it != recordings.end() && !(it->key == key)) {
+        ++it;
+    }
+    if (it != recordings.end()) {
+        recordings.splice(recordings.begin(), recordings, it);
+    } else {
+        recordings.push_front({std::move(key), record(page, bgFlags)});
+        if (recordings.size() > MAX_RECORDINGS) {
+            recordings.pop_back();
+        }
+    }
+
+    cairo_save(cr);
+    cairo_set_source_surface(cr, recordings.front().surface.get(), 0, 0);
+    cairo_paint(cr);
+    cairo_restore(cr);
+}
+
+auto BackgroundRecorder::size() const -> size_t { return recordings.size(); }
+
+auto BackgroundRecorder::record(const PageRef& page, BackgroundFlags bgFlags) -> xoj::util::CairoSurfaceSPtr {
+    cairo_rectangle_t extents = {0, 0, page->getWidth(), page->getHeight()};
+    xoj::util::CairoSurfaceSPtr surface(cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents),
+                                        xoj::util::adopt);
+    xoj::util::CairoSPtr cr(cairo_create(surface.get()), xoj::util::adopt);
+    auto view = BackgroundView::createForPage(page, bgFlags);
+    if (view) {
+        view->draw(cr.get());
+    }
+    return surface;
+}
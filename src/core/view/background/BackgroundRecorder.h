@@ -0,0 +1,81 @@
+/*
+ * Xournal++
+ *
+ * Shares the recorded backgrounds of identical pages in vector outputs
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <list>     // for list
+
+#include <cairo.h>  // for cairo_t
+
+#include "model/BackgroundImage.h"    // for BackgroundImage
+#include "model/PageRef.h"            // for PageRef
+#include "model/PageType.h"           // for PageType
+#include "util/Color.h"               // for Color
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+#include "BackgroundView.h"  // for BackgroundFlags
+
+namespace xoj::view {
+
+/**
+ * @brief Draws page backgrounds on vector surfaces (PDF export) through recording surfaces
+ *
+ * Pages with the same ruling, color and size, or with the same background image, are drawn from the same recording
+ * surface. The PDF surface emits a source surface it already knows as a reference to the same object: each distinct
+ * background (and each background image) is written once to the file, instead of once per page.
+ *
+ * At most MAX_RECORDINGS backgrounds are kept, the least recently used one is dropped first. PDF backgrounds are not
+ * recorded: they are drawn directly.
+ */
+class BackgroundRecorder {
+public:
+    static constexpr size_t MAX_RECORDINGS = 32;
+
+    /**
+     * @brief Draw the background of the page, in page coordinates
+     */
+    void draw(const PageRef& page, cairo_t* cr, BackgroundFlags bgFlags);
+
+    /**
+     * @return The number of recorded backgrounds
+     */
+    size_t size() const;
+
+private:
+    struct Key {
+        PageType type;
+        Color color{};
+        /// Keeps the pixbuf alive, so that it is a valid identity of the image
+        BackgroundImage image;
+        double width{};
+        double height{};
+        bool transparent{};
+        bool showImage{};
+        bool showRuling{};
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct Recording {
+        Key key;
+        xoj::util::CairoSurfaceSPtr surface;
+    };
+
+    static xoj::util::CairoSurfaceSPtr record(const PageRef& page, BackgroundFlags bgFlags);
+
+private:
+    /**
+     * Most recently used first
+     */
+    std::list<Recording> recordings;
+};
+};  // namespace xoj::view
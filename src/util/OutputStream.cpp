@@ -18,8 +18,9 @@ void OutputStream::write(const char* str) { write(str, strlen(str)); }
 /// GzOutputStream /////////////////////////////////////
 ////////////////////////////////////////////////////////
 
-GzOutputStream::GzOutputStream(fs::path file): file(std::move(file)) {
-    this->fp = GzUtil::openPath(this->file, "w");
+GzOutputStream::GzOutputStream(fs::path file, bool compress): file(std::move(file)) {
+    // "T" makes zlib write the data without gzip header and compression
+    this->fp = GzUtil::openPath(this->file, compress ? "w" : "wT");
     if (this->fp == nullptr) {
         this->error = FS(_F("Error opening file: \"{1}\"") % this->file.u8string());
     }
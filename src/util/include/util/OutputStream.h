@@ -32,7 +32,11 @@ public:
 
 class GzOutputStream: public OutputStream {
 public:
-    GzOutputStream(fs::path file);
+    /**
+     * @param file The file to write
+     * @param compress If false, the data is written as is, without gzip compression
+     */
+    GzOutputStream(fs::path file, bool compress = true);
     ~GzOutputStream() override;
 
 public:
@@ -0,0 +1,132 @@
+/*
+ * Xournal++
+ *
+ * Benchmarks for eraser sweeps across a page, following what EraseHandler does on each motion event
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>         // for unique_ptr, make_unique
+#include <unordered_map>  // for unordered_map
+
+#include <benchmark/benchmark.h>
+
+#include "model/Element.h"                // for Element, ELEMENT_STROKE
+#include "model/Layer.h"                  // for Layer
+#include "model/Stroke.h"                 // for Stroke
+#include "model/XojPage.h"                // for XojPage
+#include "model/eraser/ErasableStroke.h"  // for ErasableStroke
+#include "model/eraser/PaddedBox.h"       // for PaddedBox
+#include "util/Range.h"                   // for Range
+#include "util/SmallVector.h"             // for SmallVector
+
+#include "SyntheticDocument.h"  // for SyntheticDocument, SyntheticDocumentParameters
+
+namespace {
+constexpr double HALF_ERASER_SIZE = 5.0;
+constexpr double PADDING_COEFFICIENT = 0.4;
+
+/**
+ * Distance between two consecutive eraser positions: a quick sweep with the mouse
+ */
+constexpr double ERASER_STEP = 2.0;
+
+/**
+ * Calls f(x, y) for every eraser position of a zigzag sweep over the page
+ */
+template <typename Fun>
+void sweep(const PageRef& page, int lines, Fun f) {
+    const double dy = page->getHeight() / (lines + 1);
+    for (int line = 1; line <= lines; line++) {
+        for (double x = 0; x < page->getWidth(); x += ERASER_STEP) {
+            f(line % 2 ? x : page->getWidth() - x, line * dy);
+        }
+    }
+}
+}  // namespace
+
+/**
+ * Arguments: strokes per page, number of horizontal sweeps
+ */
+static void BM_EraseStandard(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = 1;
+    params.strokesPerPage = static_cast<size_t>(state.range(0));
+    SyntheticDocument synth(params);
+    PageRef page = synth.getDocument().getPage(0);
+    Layer* layer = page->getSelectedLayer();
+
+    size_t events = 0;
+    for (auto _: state) {
+        std::unordered_map<const Stroke*, std::unique_ptr<ErasableStroke>> erasables;
+        sweep(page, static_cast<int>(state.range(1)), [&](double x, double y) {
+            Range range(x, y);
+            for (Element* e: layer->getElements()) {
+                if (e->getType() != ELEMENT_STROKE ||
+                    !e->intersectsArea(x - HALF_ERASER_SIZE, y - HALF_ERASER_SIZE, 2 * HALF_ERASER_SIZE,
+                                       2 * HALF_ERASER_SIZE)) {
+                    continue;
+                }
+                auto* s = static_cast<Stroke*>(e);
+                const PaddedBox box{{x, y}, HALF_ERASER_SIZE, HALF_ERASER_SIZE + PADDING_COEFFICIENT * s->getWidth()};
+                if (auto it = erasables.find(s); it != erasables.end()) {
+                    it->second->erase(box, range);
+                } else if (auto intersections = s->intersectWithPaddedBox(box); !intersections.empty()) {
+                    auto erasable = std::make_unique<ErasableStroke>(*s);
+                    erasable->beginErasure(intersections, range);
+                    erasables.emplace(s, std::move(erasable));
+                }
+            }
+            benchmark::DoNotOptimize(range);
+            events++;
+        });
+        for (auto& [stroke, erasable]: erasables) {
+            benchmark::DoNotOptimize(erasable->getStrokes());
+        }
+    }
+    state.counters["events/s"] = benchmark::Counter(static_cast<double>(events), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EraseStandard)
+        ->ArgNames({"strokes", "sweeps"})
+        ->Args({200, 4})
+        ->Args({2000, 4})
+        ->Args({2000, 16})
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Arguments: strokes per page, number of horizontal sweeps
+ */
+static void BM_EraseDeleteStroke(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = 1;
+    params.strokesPerPage = static_cast<size_t>(state.range(0));
+    SyntheticDocument synth(params);
+    PageRef page = synth.getDocument().getPage(0);
+    Layer* layer = page->getSelectedLayer();
+
+    size_t events = 0;
+    for (auto _: state) {
+        size_t hits = 0;
+        sweep(page, static_cast<int>(state.range(1)), [&](double x, double y) {
+            for (Element* e: layer->getElements()) {
+                if (e->getType() == ELEMENT_STROKE &&
+                    e->intersectsArea(x - HALF_ERASER_SIZE, y - HALF_ERASER_SIZE, 2 * HALF_ERASER_SIZE,
+                                      2 * HALF_ERASER_SIZE) &&
+                    static_cast<Stroke*>(e)->intersects(x, y, HALF_ERASER_SIZE)) {
+                    hits++;
+                }
+            }
+            events++;
+        });
+        benchmark::DoNotOptimize(hits);
+    }
+    state.counters["events/s"] = benchmark::Counter(static_cast<double>(events), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EraseDeleteStroke)
+        ->ArgNames({"strokes", "sweeps"})
+        ->Args({200, 4})
+        ->Args({2000, 4})
+        ->Unit(benchmark::kMillisecond);
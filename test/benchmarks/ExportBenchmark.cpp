@@ -0,0 +1,152 @@
+/*
+ * Xournal++
+ *
+ * Benchmarks for PDF and PNG export
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <algorithm>  // for max
+#include <cstddef>    // for size_t
+#include <fstream>    // for ifstream
+#include <memory>     // for unique_ptr
+#include <string>     // for string, getline
+
+#include <benchmark/benchmark.h>
+
+#include "control/jobs/ImageExport.h"       // for ImageExport, EXPORT_GRAPHICS_PNG
+#include "control/jobs/ProgressListener.h"  // for DummyProgressListener
+#include "pdf/base/XojPdfExport.h"          // for XojPdfExport
+#include "pdf/base/XojPdfExportFactory.h"   // for XojPdfExportFactory
+#include "util/ElementRange.h"              // for PageRangeVector
+
+#include "SyntheticDocument.h"  // for SyntheticDocument, SyntheticDocumentParameters
+#include "filesystem.h"         // for path, file_size
+
+/**
+ * Arguments: pages, strokes per page, PDF background (0 or 1)
+ */
+static void BM_ExportPdf(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = static_cast<size_t>(state.range(0));
+    params.strokesPerPage = static_cast<size_t>(state.range(1));
+    params.textsPerPage = 5;
+    params.imagesPerPage = 1;
+    params.pdfBackground = state.range(2) != 0;
+    SyntheticDocument synth(params);
+    Document& doc = synth.getDocument();
+    const auto file = synth.getTempFile("export.pdf");
+
+    for (auto _: state) {
+        std::unique_ptr<XojPdfExport> pdfExport = XojPdfExportFactory::createExport(&doc, nullptr);
+        if (!pdfExport->createPdf(file, false)) {
+            state.SkipWithError(pdfExport->getLastError().c_str());
+            break;
+        }
+    }
+    state.counters["fileSize"] = static_cast<double>(fs::file_size(file));
+    state.counters["pages/s"] =
+            benchmark::Counter(static_cast<double>(doc.getPageCount()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_ExportPdf)
+        ->ArgNames({"pages", "strokes", "pdf"})
+        ->Args({10, 200, 0})
+        ->Args({10, 2000, 0})
+        ->Args({10, 200, 1})
+        ->Args({100, 200, 1})
+        ->Unit(benchmark::kMillisecond);
+
+namespace {
+/**
+ * @return The resident memory of the process, in bytes, or 0 if unknown (only available on Linux)
+ */
+size_t residentMemory() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            return std::stoul(line.substr(6)) * 1024;
+        }
+    }
+    return 0;
+}
+}  // namespace
+
+/**
+ * Long exports, as done by archive jobs: the memory used by the export should not depend on the number of pages.
+ * Arguments: pages, background image (0: identical lined backgrounds, 1: identical image backgrounds)
+ */
+static void BM_ExportPdfLarge(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = static_cast<size_t>(state.range(0));
+    params.strokesPerPage = 20;
+    params.textsPerPage = 1;
+    params.imageBackground = state.range(1) != 0;
+    SyntheticDocument synth(params);
+    Document& doc = synth.getDocument();
+    const auto file = synth.getTempFile("export.pdf");
+
+    size_t memoryGrowth = 0;
+    for (auto _: state) {
+        const size_t before = residentMemory();
+        std::unique_ptr<XojPdfExport> pdfExport = XojPdfExportFactory::createExport(&doc, nullptr);
+        if (!pdfExport->createPdf(file, false)) {
+            state.SkipWithError(pdfExport->getLastError().c_str());
+            break;
+        }
+        const size_t after = residentMemory();
+        memoryGrowth = std::max(memoryGrowth, after > before ? after - before : 0);
+    }
+    state.counters["fileSize"] = static_cast<double>(fs::file_size(file));
+    state.counters["bytes/page"] = static_cast<double>(fs::file_size(file)) / static_cast<double>(doc.getPageCount());
+    state.counters["memoryGrowth"] = benchmark::Counter(static_cast<double>(memoryGrowth),
+                                                        benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    state.counters["pages/s"] =
+            benchmark::Counter(static_cast<double>(doc.getPageCount()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_ExportPdfLarge)
+        ->ArgNames({"pages", "image"})
+        ->Args({500, 0})
+        ->Args({2000, 0})
+        ->Args({500, 1})
+        ->Args({2000, 1})
+        ->Iterations(1)
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Arguments: DPI, strokes per page
+ */
+static void BM_ExportPng(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = 4;
+    params.strokesPerPage = static_cast<size_t>(state.range(1));
+    params.textsPerPage = 5;
+    params.imagesPerPage = 1;
+    SyntheticDocument synth(params);
+    Document& doc = synth.getDocument();
+
+    PageRangeVector range;
+    range.emplace_back(0, doc.getPageCount() - 1);
+    DummyProgressListener progress;
+
+    for (auto _: state) {
+        ImageExport imgExport(&doc, synth.getTempFile("export.png"), EXPORT_GRAPHICS_PNG, EXPORT_BACKGROUND_ALL, range);
+        imgExport.setQualityParameter(EXPORT_QUALITY_DPI, static_cast<int>(state.range(0)));
+        imgExport.exportGraphics(&progress);
+        if (!imgExport.getLastErrorMsg().empty()) {
+            state.SkipWithError(imgExport.getLastErrorMsg().c_str());
+            break;
+        }
+    }
+    state.counters["pages/s"] =
+            benchmark::Counter(static_cast<double>(doc.getPageCount()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_ExportPng)
+        ->ArgNames({"dpi", "strokes"})
+        ->Args({150, 200})
+        ->Args({300, 200})
+        ->Args({300, 2000})
+        ->Unit(benchmark::kMillisecond);
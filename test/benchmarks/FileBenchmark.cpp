@@ -0,0 +1,89 @@
+/*
+ * Xournal++
+ *
+ * Benchmarks for loading and saving .xopp files
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "control/xojfile/LoadHandler.h"  // for LoadHandler
+#include "control/xojfile/SaveHandler.h"  // for SaveHandler
+
+#include "SyntheticDocument.h"  // for SyntheticDocument, SyntheticDocumentParameters
+#include "filesystem.h"         // for path, file_size
+
+namespace {
+auto makeParameters(const benchmark::State& state) -> SyntheticDocumentParameters {
+    SyntheticDocumentParameters params;
+    params.pageCount = static_cast<size_t>(state.range(0));
+    params.strokesPerPage = static_cast<size_t>(state.range(1));
+    params.textsPerPage = 5;
+    params.imagesPerPage = static_cast<size_t>(state.range(2));
+    return params;
+}
+
+void setFileCounters(benchmark::State& state, const fs::path& file, const Document& doc) {
+    const auto fileSize = fs::file_size(file);
+    state.counters["fileSize"] = static_cast<double>(fileSize);
+    state.counters["pages/s"] =
+            benchmark::Counter(static_cast<double>(doc.getPageCount()), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+}
+}  // namespace
+
+static void BM_SaveDocument(benchmark::State& state) {
+    SyntheticDocument synth(makeParameters(state));
+    Document& doc = synth.getDocument();
+    const auto file = synth.getTempFile("save.xopp");
+
+    for (auto _: state) {
+        SaveHandler handler;
+        handler.prepareSave(&doc);
+        handler.saveTo(file);
+        if (!handler.getErrorMessage().empty()) {
+            state.SkipWithError(handler.getErrorMessage().c_str());
+            break;
+        }
+    }
+    setFileCounters(state, file, doc);
+}
+BENCHMARK(BM_SaveDocument)
+        ->ArgNames({"pages", "strokes", "images"})
+        ->Args({10, 200, 0})
+        ->Args({10, 1000, 0})
+        ->Args({100, 200, 0})
+        ->Args({10, 200, 4})
+        ->Unit(benchmark::kMillisecond);
+
+static void BM_LoadDocument(benchmark::State& state) {
+    SyntheticDocument synth(makeParameters(state));
+    const auto file = synth.getTempFile("load.xopp");
+    {
+        SaveHandler handler;
+        handler.prepareSave(&synth.getDocument());
+        handler.saveTo(file);
+    }
+
+    for (auto _: state) {
+        LoadHandler handler;
+        Document* doc = handler.loadDocument(file);
+        if (!doc) {
+            state.SkipWithError(handler.getLastError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(doc->getPageCount());
+    }
+    setFileCounters(state, file, synth.getDocument());
+}
+BENCHMARK(BM_LoadDocument)
+        ->ArgNames({"pages", "strokes", "images"})
+        ->Args({10, 200, 0})
+        ->Args({10, 1000, 0})
+        ->Args({100, 200, 0})
+        ->Args({10, 200, 4})
+        ->Unit(benchmark::kMillisecond);
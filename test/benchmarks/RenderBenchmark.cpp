@@ -0,0 +1,94 @@
+/*
+ * Xournal++
+ *
+ * Benchmarks for rendering full pages, as done by RenderJob
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <benchmark/benchmark.h>
+#include <cairo.h>  // for CAIRO_CONTENT_COLOR_ALPHA
+
+#include "control/PdfCache.h"      // for PdfCache
+#include "model/XojPage.h"         // for XojPage
+#include "util/Range.h"            // for Range
+#include "view/DocumentView.h"     // for DocumentView
+#include "view/Mask.h"             // for Mask
+#include "view/StrokePathCache.h"  // for StrokePathCache
+
+#include "SyntheticDocument.h"  // for SyntheticDocument, SyntheticDocumentParameters
+
+/**
+ * Arguments: zoom (in percent), strokes per page, images per page, PDF background (0 or 1)
+ */
+static void BM_RenderPage(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = 1;
+    params.strokesPerPage = static_cast<size_t>(state.range(1));
+    params.textsPerPage = 5;
+    params.imagesPerPage = static_cast<size_t>(state.range(2));
+    params.pdfBackground = state.range(3) != 0;
+    SyntheticDocument synth(params);
+    Document& doc = synth.getDocument();
+
+    const double zoom = static_cast<double>(state.range(0)) / 100.0;
+    PageRef page = doc.getPage(0);
+    PdfCache cache(doc.getPdfDocument(), nullptr);
+
+    for (auto _: state) {
+        xoj::view::Mask mask(1, Range(0, 0, page->getWidth(), page->getHeight()), zoom, CAIRO_CONTENT_COLOR_ALPHA);
+        DocumentView view;
+        view.setPdfCache(&cache);
+        view.drawPage(page, mask.get(), false);
+        cairo_surface_flush(cairo_get_target(mask.get()));
+    }
+    state.counters["pages/s"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_RenderPage)
+        ->ArgNames({"zoom", "strokes", "images", "pdf"})
+        ->ArgsProduct({{50, 100, 200, 400}, {200, 2000}, {0}, {0}})
+        ->Args({100, 200, 4, 0})
+        ->Args({100, 200, 0, 1})
+        ->Args({400, 200, 0, 1})
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Rerender a page of strokes without pressure, alternating between zoom levels, as done when zooming in and out.
+ * Arguments: whether the cached stroke paths are kept between two renderings (0 or 1), points per stroke
+ */
+static void BM_RerenderStrokePaths(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = 1;
+    params.strokesPerPage = 1000;
+    params.pointsPerStroke = static_cast<size_t>(state.range(1));
+    params.pressure = false;
+    SyntheticDocument synth(params);
+    PageRef page = synth.getDocument().getPage(0);
+
+    const bool keepPaths = state.range(0) != 0;
+    auto& pathCache = xoj::view::StrokePathCache::getInstance();
+    pathCache.clear();
+
+    const double zooms[] = {0.5, 1.0, 2.0};
+    size_t n = 0;
+    for (auto _: state) {
+        if (!keepPaths) {
+            pathCache.clear();
+        }
+        const double zoom = zooms[n++ % 3];
+        xoj::view::Mask mask(1, Range(0, 0, page->getWidth(), page->getHeight()), zoom, CAIRO_CONTENT_COLOR_ALPHA);
+        DocumentView view;
+        view.drawPage(page, mask.get(), false);
+        cairo_surface_flush(cairo_get_target(mask.get()));
+    }
+    state.counters["pages/s"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["cacheBytes"] = static_cast<double>(pathCache.getBytes());
+    pathCache.clear();
+}
+BENCHMARK(BM_RerenderStrokePaths)
+        ->ArgNames({"cached", "points"})
+        ->ArgsProduct({{0, 1}, {100, 1000}})
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,79 @@
+/*
+ * Xournal++
+ *
+ * Benchmarks for applying selection transforms to the selected elements, as done by EditSelectionContents
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>  // for unique_ptr
+#include <vector>  // for vector
+
+#include <benchmark/benchmark.h>
+
+#include "model/Element.h"  // for Element
+#include "model/Layer.h"    // for Layer
+#include "model/XojPage.h"  // for XojPage
+
+#include "SyntheticDocument.h"  // for SyntheticDocument, SyntheticDocumentParameters
+
+namespace {
+enum Transform { MOVE = 0, SCALE, ROTATE };
+
+auto cloneElements(const Layer* layer) -> std::vector<std::unique_ptr<Element>> {
+    std::vector<std::unique_ptr<Element>> elements;
+    elements.reserve(layer->getElements().size());
+    for (const Element* e: layer->getElements()) {
+        elements.emplace_back(e->clone());
+    }
+    return elements;
+}
+}  // namespace
+
+/**
+ * Arguments: selected strokes, transform type (0: move, 1: scale, 2: rotate)
+ */
+static void BM_TransformSelection(benchmark::State& state) {
+    SyntheticDocumentParameters params;
+    params.pageCount = 1;
+    params.strokesPerPage = static_cast<size_t>(state.range(0));
+    params.textsPerPage = 5;
+    SyntheticDocument synth(params);
+    PageRef page = synth.getDocument().getPage(0);
+
+    const double cx = page->getWidth() / 2;
+    const double cy = page->getHeight() / 2;
+
+    for (auto _: state) {
+        state.PauseTiming();
+        auto elements = cloneElements(page->getSelectedLayer());
+        state.ResumeTiming();
+
+        for (auto& e: elements) {
+            switch (state.range(1)) {
+                case MOVE:
+                    e->move(12.5, -7.25);
+                    break;
+                case SCALE:
+                    e->scale(cx, cy, 1.5, 0.75, 0, false);
+                    break;
+                case ROTATE:
+                    e->rotate(cx, cy, 0.3);
+                    break;
+            }
+            // The new bounding box is needed for the rerendering of the selection
+            benchmark::DoNotOptimize(e->boundingRect());
+        }
+
+        state.PauseTiming();
+        elements.clear();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_TransformSelection)
+        ->ArgNames({"strokes", "transform"})
+        ->ArgsProduct({{200, 2000}, {MOVE, SCALE, ROTATE}})
+        ->Unit(benchmark::kMillisecond);
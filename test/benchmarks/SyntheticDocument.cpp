@@ -0,0 +1,212 @@
+/*
+ * Xournal++
+ *
+ * Deterministic generator of synthetic documents, used by the benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "SyntheticDocument.h"
+
+#include <algorithm>  // for clamp
+#include <cmath>      // for cos, sin
+#include <iterator>   // for size
+#include <memory>     // for make_shared
+#include <random>     // for mt19937, uniform_real_distribution
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include <cairo-pdf.h>  // for cairo_pdf_surface_create
+#include <cairo.h>      // for cairo_create, cairo_destroy, ...
+#include <glib.h>       // for g_dir_make_tmp, g_free, g_error, g_file_set_contents
+
+#include "model/BackgroundImage.h"  // for BackgroundImage
+#include "model/Font.h"             // for XojFont
+#include "model/Image.h"            // for Image
+#include "model/Layer.h"            // for Layer
+#include "model/PageType.h"         // for PageType, PageTypeFormat
+#include "model/Point.h"            // for Point
+#include "model/Stroke.h"           // for Stroke
+#include "model/Text.h"             // for Text
+#include "model/XojPage.h"          // for XojPage
+#include "util/Color.h"             // for Color
+#include "util/PathUtil.h"          // for fromGFilename
+
+namespace {
+/**
+ * A4, in points
+ */
+constexpr double PAGE_WIDTH = 595.275591;
+constexpr double PAGE_HEIGHT = 841.889764;
+
+constexpr Color STROKE_COLORS[] = {Color(0xff000000U), Color(0xff3333ccU), Color(0xffdc143cU), Color(0xff008000U),
+                                   Color(0xffffff00U)};
+
+cairo_status_t appendToString(std::string* out, const unsigned char* data, unsigned int length) {
+    out->append(reinterpret_cast<const char*>(data), length);
+    return CAIRO_STATUS_SUCCESS;
+}
+}  // namespace
+
+SyntheticDocument::SyntheticDocument(const SyntheticDocumentParameters& params): params(params), doc(&handler) {
+    GError* err = nullptr;
+    gchar* dir = g_dir_make_tmp("xournalpp-benchmark-XXXXXX", &err);
+    if (!dir) {
+        g_error("Could not create a temporary directory: %s", err->message);
+    }
+    this->tmpDir = Util::fromGFilename(dir);
+
+    if (params.pdfBackground) {
+        auto pdfFile = getTempFile("background.pdf");
+        createPdfBackground(pdfFile);
+        if (!doc.readPdf(pdfFile, true, false)) {
+            g_error("Could not read the generated PDF background: %s", doc.getLastErrorMsg().c_str());
+        }
+    } else {
+        BackgroundImage backgroundImage;
+        if (params.imageBackground) {
+            auto imageFile = getTempFile("background.png");
+            std::string png = createPngData(1240, 1754, params.seed);
+            if (!g_file_set_contents(imageFile.u8string().c_str(), png.data(), static_cast<gssize>(png.size()), &err)) {
+                g_error("Could not write the background image: %s", err->message);
+            }
+            backgroundImage.loadFile(imageFile, &err);
+            if (err) {
+                g_error("Could not read the background image: %s", err->message);
+            }
+        }
+        for (size_t n = 0; n < params.pageCount; n++) {
+            auto page = std::make_shared<XojPage>(PAGE_WIDTH, PAGE_HEIGHT);
+            if (params.imageBackground) {
+                page->setBackgroundImage(backgroundImage);
+                page->setBackgroundType(PageType(PageTypeFormat::Image));
+            }
+            doc.addPage(std::move(page));
+        }
+    }
+
+    for (size_t n = 0; n < doc.getPageCount(); n++) {
+        fillPage(doc.getPage(n), params.seed + static_cast<uint32_t>(n));
+    }
+}
+
+SyntheticDocument::~SyntheticDocument() {
+    doc.clearDocument(true);
+    std::error_code ec;
+    fs::remove_all(tmpDir, ec);
+}
+
+auto SyntheticDocument::getDocument() -> Document& { return doc; }
+
+auto SyntheticDocument::getTempFile(const std::string& name) const -> fs::path { return tmpDir / name; }
+
+auto SyntheticDocument::createPngData(int width, int height, uint32_t seed) -> std::string {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_RGB24, width, height);
+    cairo_t* cr = cairo_create(surface);
+    cairo_set_source_rgb(cr, unit(gen), unit(gen), unit(gen));
+    cairo_paint(cr);
+    for (int i = 0; i < 32; i++) {
+        cairo_set_source_rgb(cr, unit(gen), unit(gen), unit(gen));
+        cairo_rectangle(cr, unit(gen) * width, unit(gen) * height, unit(gen) * width / 2, unit(gen) * height / 2);
+        cairo_fill(cr);
+    }
+    cairo_destroy(cr);
+
+    std::string data;
+    cairo_surface_write_to_png_stream(surface, reinterpret_cast<cairo_write_func_t>(appendToString), &data);
+    cairo_surface_destroy(surface);
+    return data;
+}
+
+void SyntheticDocument::createPdfBackground(const fs::path& file) const {
+    std::mt19937 gen(params.seed);
+    std::uniform_real_distribution<double> posX(0.0, PAGE_WIDTH);
+    std::uniform_real_distribution<double> posY(0.0, PAGE_HEIGHT);
+
+    cairo_surface_t* surface = cairo_pdf_surface_create(file.u8string().c_str(), PAGE_WIDTH, PAGE_HEIGHT);
+    cairo_t* cr = cairo_create(surface);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 11);
+    for (size_t n = 0; n < params.pageCount; n++) {
+        // Some text lines and vector graphics, similar to a typical slide or article page
+        for (int line = 0; line < 40; line++) {
+            cairo_move_to(cr, 50, 60 + 18 * line);
+            cairo_show_text(cr, "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.");
+        }
+        cairo_set_line_width(cr, 0.8);
+        for (int i = 0; i < 20; i++) {
+            cairo_move_to(cr, posX(gen), posY(gen));
+            cairo_curve_to(cr, posX(gen), posY(gen), posX(gen), posY(gen), posX(gen), posY(gen));
+            cairo_stroke(cr);
+        }
+        cairo_show_page(cr);
+    }
+    cairo_destroy(cr);
+    cairo_surface_finish(surface);
+    cairo_surface_destroy(surface);
+}
+
+void SyntheticDocument::fillPage(const PageRef& page, uint32_t pageSeed) const {
+    std::mt19937 gen(pageSeed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::normal_distribution<double> angleStep(0.0, 0.3);
+
+    const double width = page->getWidth();
+    const double height = page->getHeight();
+
+    Layer* layer = page->getSelectedLayer();
+
+    for (size_t n = 0; n < params.strokesPerPage; n++) {
+        auto* stroke = new Stroke();
+        stroke->setWidth(0.8 + 2.0 * unit(gen));
+        stroke->setColor(STROKE_COLORS[n % std::size(STROKE_COLORS)]);
+        if (n % 17 == 0) {
+            stroke->setToolType(StrokeTool::HIGHLIGHTER);
+            stroke->setWidth(8.0);
+        }
+
+        // A smooth random walk, looking like handwriting
+        double x = width * unit(gen);
+        double y = height * unit(gen);
+        double angle = 2 * M_PI * unit(gen);
+        std::vector<Point> points;
+        points.reserve(params.pointsPerStroke);
+        for (size_t i = 0; i < params.pointsPerStroke; i++) {
+            angle += angleStep(gen);
+            x = std::clamp(x + 1.5 * std::cos(angle), 0.0, width);
+            y = std::clamp(y + 1.5 * std::sin(angle), 0.0, height);
+            double z = params.pressure && stroke->getToolType().isPressureSensitive() ?
+                               stroke->getWidth() * (0.3 + 0.7 * unit(gen)) :
+                               Point::NO_PRESSURE;
+            points.emplace_back(x, y, z);
+        }
+        stroke->setPointVector(std::move(points));
+        layer->addElement(stroke);
+    }
+
+    for (size_t n = 0; n < params.textsPerPage; n++) {
+        auto* text = new Text();
+        text->setFont(XojFont("Sans", 12));
+        text->setText("The quick brown fox jumps over the lazy dog\nSphinx of black quartz, judge my vow");
+        text->setColor(STROKE_COLORS[n % std::size(STROKE_COLORS)]);
+        text->setX(0.8 * width * unit(gen));
+        text->setY(0.9 * height * unit(gen));
+        layer->addElement(text);
+    }
+
+    for (size_t n = 0; n < params.imagesPerPage; n++) {
+        auto* image = new Image();
+        image->setImage(createPngData(640, 480, pageSeed * 31 + static_cast<uint32_t>(n)));
+        image->setX(0.6 * width * unit(gen));
+        image->setY(0.7 * height * unit(gen));
+        image->setWidth(160);
+        image->setHeight(120);
+        layer->addElement(image);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Xournal++
+ *
+ * Deterministic generator of synthetic documents, used by the benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <string>   // for string
+
+#include "model/Document.h"         // for Document
+#include "model/DocumentHandler.h"  // for DocumentHandler
+
+#include "filesystem.h"  // for path
+
+/**
+ * @brief Description of the content of a synthetic document
+ */
+struct SyntheticDocumentParameters {
+    size_t pageCount = 10;
+    size_t strokesPerPage = 200;
+    size_t pointsPerStroke = 100;
+
+    /**
+     * If true, every stroke has pressure values
+     */
+    bool pressure = true;
+
+    size_t textsPerPage = 0;
+    size_t imagesPerPage = 0;
+
+    /**
+     * If true, every page has a (generated) PDF page as background
+     */
+    bool pdfBackground = false;
+
+    /**
+     * If true, every page without PDF background has the same (generated) image as background
+     */
+    bool imageBackground = false;
+
+    /**
+     * Seed of the random generator: the same parameters always give the same document
+     */
+    uint32_t seed = 42;
+};
+
+/**
+ * @brief A document filled with random but reproducible content
+ *
+ * The generated files (PDF background, saved copies) live in a temporary directory which is removed on destruction.
+ */
+class SyntheticDocument {
+public:
+    explicit SyntheticDocument(const SyntheticDocumentParameters& params);
+    ~SyntheticDocument();
+
+    SyntheticDocument(const SyntheticDocument&) = delete;
+    SyntheticDocument& operator=(const SyntheticDocument&) = delete;
+
+public:
+    Document& getDocument();
+
+    /**
+     * @return A path inside the temporary directory of this document
+     */
+    fs::path getTempFile(const std::string& name) const;
+
+    /**
+     * @brief Encode a small opaque RGB image as PNG
+     * @param width The width of the image, in pixels
+     * @param height The height of the image, in pixels
+     * @param seed Seed of the random pattern
+     */
+    static std::string createPngData(int width, int height, uint32_t seed);
+
+private:
+    void createPdfBackground(const fs::path& file) const;
+    void fillPage(const PageRef& page, uint32_t pageSeed) const;
+
+private:
+    SyntheticDocumentParameters params;
+
+    fs::path tmpDir;
+
+    DocumentHandler handler;
+    Document doc;
+};
@@ -0,0 +1,47 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "audio/AudioQueue.h"
+
+TEST(AudioQueue, testPlaybackPosition) {
+    AudioQueue<float> queue;
+    queue.setAudioAttributes(1000, 2);
+    queue.flush(100);
+    EXPECT_EQ(100U, queue.getPosition());
+    EXPECT_EQ(100U, queue.getEndPosition());
+
+    std::vector<float> samples = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_TRUE(queue.emplaceAt(100, samples.begin(), samples.end()));
+    EXPECT_EQ(104U, queue.getEndPosition());
+    // Not contiguous with the queued samples
+    EXPECT_FALSE(queue.emplaceAt(100, samples.begin(), samples.end()));
+    EXPECT_EQ(8U, queue.size());
+
+    std::vector<float> out(6);
+    queue.pop(out.begin(), out.size());
+    EXPECT_EQ((std::vector<float>{1, 2, 3, 4, 5, 6}), out);
+    EXPECT_EQ(103U, queue.getPosition());
+
+    // A seek drops the queued samples
+    queue.flush(500);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(500U, queue.getPosition());
+    EXPECT_FALSE(queue.emplaceAt(104, samples.begin(), samples.end()));
+    EXPECT_TRUE(queue.emplaceAt(500, samples.begin(), samples.begin() + 2));
+    EXPECT_EQ(501U, queue.getEndPosition());
+
+    queue.reset();
+    EXPECT_EQ(0U, queue.getPosition());
+}
@@ -0,0 +1,86 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <chrono>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sndfile.h>
+
+#include "audio/AudioQueue.h"
+#include "audio/SNDFileCpp.h"
+#include "audio/VorbisProducer.h"
+
+#include "filesystem.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr int SAMPLE_RATE = 1000;
+constexpr int FRAMES = 3000;
+
+auto sampleAt(int frame) -> float { return static_cast<float>(frame) / FRAMES; }
+
+/**
+ * Write a mono file whose samples identify their frame
+ */
+void writeTestFile(const fs::path& path) {
+    SF_INFO info{};
+    info.samplerate = SAMPLE_RATE;
+    info.channels = 1;
+    info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+    auto file = xoj::audio::make_snd_file(path, SFM_WRITE, &info);
+    ASSERT_TRUE(file);
+
+    std::vector<float> samples(FRAMES);
+    for (int i = 0; i < FRAMES; i++) { samples[static_cast<size_t>(i)] = sampleAt(i); }
+    ASSERT_EQ(FRAMES, sf_writef_float(file.get(), samples.data(), FRAMES));
+}
+
+/**
+ * Play the queue until the stream ends
+ */
+auto drain(AudioQueue<float>& queue) -> std::vector<float> {
+    std::vector<float> samples;
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!(queue.hasStreamEnded() && queue.empty()) && std::chrono::steady_clock::now() < deadline) {
+        queue.pop(std::back_inserter(samples), 256);
+        std::this_thread::sleep_for(1ms);
+    }
+    return samples;
+}
+}  // namespace
+
+TEST(VorbisProducer, testSeekBackwardsAfterEndOfFile) {
+    auto path = fs::temp_directory_path() / "xournalpp-test-units_VorbisProducer_seek.wav";
+    writeTestFile(path);
+
+    AudioQueue<float> queue;
+    VorbisProducer producer(queue);
+    ASSERT_TRUE(producer.start(path, 0));
+
+    // The whole file is decoded and played
+    auto samples = drain(queue);
+    ASSERT_EQ(static_cast<size_t>(FRAMES), samples.size());
+    EXPECT_TRUE(queue.hasStreamEnded());
+
+    // Seeking back resumes the stream from there
+    producer.seekTo(1000);
+    samples = drain(queue);
+    ASSERT_EQ(static_cast<size_t>(FRAMES - SAMPLE_RATE), samples.size());
+    EXPECT_EQ(sampleAt(SAMPLE_RATE), samples.front());
+    EXPECT_EQ(sampleAt(FRAMES - 1), samples.back());
+
+    producer.abort();
+    fs::remove(path);
+}
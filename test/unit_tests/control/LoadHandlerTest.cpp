@@ -12,6 +12,7 @@
 #include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 
 #include <config-test.h>
 #include <gtest/gtest.h>
@@ -19,6 +20,7 @@
 #include "control/xojfile/LoadHandler.h"
 #include "control/xojfile/SaveHandler.h"
 #include "model/Image.h"
+#include "model/Layer.h"
 #include "model/Stroke.h"
 #include "model/Text.h"
 #include "model/XojPage.h"
@@ -35,7 +37,7 @@ using std::string;
  * \param filepath The path to the actual file to load.
  * \param tol The absolute tolerance used when checking stroke coordinate data.
  */
-void testLoadStoreLoadHelper(const fs::path& filepath, double tol = 1e-8) {
+void testLoadStoreLoadHelper(const fs::path& filepath, double tol = 1e-8, bool compressed = true) {
     auto getElements = [](Document* doc) {
         EXPECT_EQ((size_t)1, doc->getPageCount());
         PageRef page = doc->getPage(0);
@@ -77,6 +79,7 @@ void testLoadStoreLoadHelper(const fs::path& filepath, double tol = 1e-8) {
     auto elements1 = getElements(doc1);
 
     SaveHandler h;
+    h.setCompressed(compressed);
     h.prepareSave(doc1);
     auto tmp = Util::getTmpDirSubfolder() / "save.xopp";
     h.saveTo(tmp);
@@ -359,6 +362,24 @@ TEST(ControlLoadHandler, testImageZipped) {
     EXPECT_TRUE(img);
 }
 
+TEST(ControlLoadHandler, imageAttachmentReadOnDemand) {
+    std::unique_ptr<Element> clone;
+    {
+        LoadHandler handler;
+        Document* doc = handler.loadDocument(GET_TESTFILE("packaged_xopp/imgAttachment/new.xopp"));
+        ASSERT_TRUE(doc);
+        Layer* layer = (*doc->getPage(0)->getLayers())[0];
+        ASSERT_EQ(layer->getElements().size(), 1);
+        clone.reset(layer->getElements()[0]->clone());
+    }
+
+    // The attachment can still be read once the handler is gone
+    auto* img = dynamic_cast<Image*>(clone.get());
+    ASSERT_TRUE(img);
+    EXPECT_TRUE(img->hasData());
+    EXPECT_GT(img->getRawDataLength(), 0U);
+}
+
 namespace {
 void checkImageFormat(Image* img, const char* formatName) {
     GdkPixbufLoader* imgLoader = gdk_pixbuf_loader_new();
@@ -425,6 +446,10 @@ TEST(ControlLoadHandler, testLoadStoreLoadDefault) {
     testLoadStoreLoadHelper(GET_TESTFILE("packaged_xopp/suite.xopp"), /*tol=*/1e-8);
 }
 
+TEST(ControlLoadHandler, testLoadStoreLoadUncompressed) {
+    testLoadStoreLoadHelper(GET_TESTFILE("packaged_xopp/suite.xopp"), /*tol=*/1e-8, /*compressed=*/false);
+}
+
 
 #ifdef __linux__
 TEST(ControlLoadHandler, testLoadStoreLoadGerman) {
@@ -0,0 +1,97 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "control/tools/Selection.h"
+
+namespace {
+using Polygon = std::vector<std::pair<double, double>>;
+
+/**
+ * Reference even-odd test, walking all the edges
+ */
+bool referenceContains(const Polygon& polygon, double x, double y) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        auto [xi, yi] = polygon[i];
+        auto [xj, yj] = polygon[j];
+        if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+RegionSelect createLasso(const Polygon& polygon) {
+    RegionSelect lasso(polygon.front().first, polygon.front().second);
+    for (auto it = std::next(polygon.begin()); it != polygon.end(); ++it) {
+        lasso.currentPos(it->first, it->second);
+    }
+    return lasso;
+}
+
+void expectSameAsReference(const RegionSelect& lasso, const Polygon& polygon) {
+    // Grid points chosen off the vertices and edges
+    for (double x = -10.37; x < 110; x += 1.913) {
+        for (double y = -10.71; y < 110; y += 2.087) {
+            EXPECT_EQ(referenceContains(polygon, x, y), lasso.contains(x, y)) << "at " << x << ", " << y;
+        }
+    }
+}
+}  // namespace
+
+TEST(RegionSelect, testContainsStar) {
+    // A star with many spikes: concave, with a long boundary
+    Polygon star;
+    const int n = 2000;
+    for (int i = 0; i < n; i++) {
+        double angle = 2 * M_PI * i / n;
+        double radius = i % 2 == 0 ? 50 : 20;
+        star.emplace_back(50 + radius * std::cos(angle), 50 + radius * std::sin(angle));
+    }
+
+    expectSameAsReference(createLasso(star), star);
+}
+
+TEST(RegionSelect, testContainsSpiral) {
+    // The same band is crossed by many edges
+    Polygon spiral;
+    for (int i = 0; i < 500; i++) {
+        double angle = 0.05 * i;
+        double radius = 5 + 0.09 * i;
+        spiral.emplace_back(50 + radius * std::cos(angle), 50 + radius * std::sin(angle));
+    }
+
+    expectSameAsReference(createLasso(spiral), spiral);
+}
+
+TEST(RegionSelect, testBoundaryChanges) {
+    Polygon square = {{0, 0}, {100, 0}, {100, 100}, {0, 100}};
+    RegionSelect lasso = createLasso(square);
+    EXPECT_TRUE(lasso.contains(50, 50));
+    EXPECT_FALSE(lasso.contains(150, 50));
+
+    // Extending the lasso after a test invalidates the edge bands
+    lasso.currentPos(200, 100);
+    lasso.currentPos(200, 0);
+    square.emplace_back(200, 100);
+    square.emplace_back(200, 0);
+    expectSameAsReference(lasso, square);
+
+    // Degenerate lassos contain nothing
+    RegionSelect line = createLasso({{0, 0}, {100, 0}, {50, 0}});
+    EXPECT_FALSE(line.contains(50, 0));
+}
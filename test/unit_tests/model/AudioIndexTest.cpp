@@ -0,0 +1,103 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/AudioIndex.h"
+#include "model/Document.h"
+#include "model/DocumentHandler.h"
+#include "model/Layer.h"
+#include "model/Point.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+
+namespace {
+Stroke* addStroke(const PageRef& page, const fs::path& audioFile, size_t timestamp) {
+    auto* stroke = new Stroke();
+    stroke->addPoint(Point(0, 0));
+    stroke->addPoint(Point(10, 10));
+    stroke->setAudioFilename(audioFile);
+    stroke->setTimestamp(timestamp);
+    page->getSelectedLayer()->addElement(stroke);
+    return stroke;
+}
+}  // namespace
+
+TEST(AudioIndex, testLookup) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    auto first = std::make_shared<XojPage>(100, 100);
+    auto second = std::make_shared<XojPage>(100, 100);
+    doc.addPage(first);
+    doc.addPage(second);
+
+    Stroke* a = addStroke(first, "a.ogg", 1000);
+    Stroke* b = addStroke(second, "a.ogg", 500);
+    Stroke* c = addStroke(first, "a.ogg", 2000);
+    addStroke(second, "b.ogg", 700);
+    addStroke(second, "", 0);
+
+    const AudioIndex& index = doc.getAudioIndex();
+    EXPECT_EQ((std::vector<fs::path>{"a.ogg", "b.ogg"}), index.getAudioFiles());
+
+    const auto& entries = index.getEntries("a.ogg");
+    ASSERT_EQ(3U, entries.size());
+    EXPECT_EQ(b, entries[0].element);
+    EXPECT_EQ(1U, entries[0].page);
+    EXPECT_EQ(a, entries[1].element);
+    EXPECT_EQ(c, entries[2].element);
+    EXPECT_TRUE(index.getEntries("c.ogg").empty());
+
+    EXPECT_EQ(nullptr, index.findAt("a.ogg", 499));
+    EXPECT_EQ(b, index.findAt("a.ogg", 500)->element);
+    EXPECT_EQ(a, index.findAt("a.ogg", 1999)->element);
+    EXPECT_EQ(c, index.findAt("a.ogg", 5000)->element);
+
+    EXPECT_EQ(a, index.findAfter("a.ogg", 500)->element);
+    EXPECT_EQ(nullptr, index.findAfter("a.ogg", 2000));
+
+    auto [begin, end] = index.findBetween("a.ogg", 500, 2000);
+    ASSERT_EQ(2, end - begin);
+    EXPECT_EQ(b, begin->element);
+    EXPECT_EQ(a, std::next(begin)->element);
+}
+
+TEST(AudioIndex, testUpdates) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    auto first = std::make_shared<XojPage>(100, 100);
+    auto second = std::make_shared<XojPage>(100, 100);
+    doc.addPage(first);
+    doc.addPage(second);
+
+    addStroke(first, "a.ogg", 1000);
+    EXPECT_EQ(1U, doc.getAudioIndex().getEntries("a.ogg").size());
+
+    // New elements are indexed
+    Stroke* late = addStroke(second, "a.ogg", 3000);
+    ASSERT_EQ(2U, doc.getAudioIndex().getEntries("a.ogg").size());
+    EXPECT_EQ(late, doc.getAudioIndex().findAt("a.ogg", 3000)->element);
+    EXPECT_EQ(1U, doc.getAudioIndex().findAt("a.ogg", 3000)->page);
+
+    // Page positions follow the document
+    doc.deletePage(0);
+    ASSERT_EQ(1U, doc.getAudioIndex().getEntries("a.ogg").size());
+    EXPECT_EQ(0U, doc.getAudioIndex().findAt("a.ogg", 3000)->page);
+
+    // Removed elements are dropped
+    second->getSelectedLayer()->removeElement(late, true);
+    EXPECT_TRUE(doc.getAudioIndex().getEntries("a.ogg").empty());
+    EXPECT_TRUE(doc.getAudioIndex().getAudioFiles().empty());
+}
@@ -0,0 +1,75 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/DocumentOutline.h"
+#include "pdf/base/XojPdfDocument.h"
+
+namespace {
+DocumentOutline::Entry makeEntry(const std::string& title, size_t pdfPage,
+                                 std::vector<DocumentOutline::Entry> children = {}) {
+    LinkDestination dest;
+    dest.setPdfPage(pdfPage);
+    dest.setName(title);
+    return DocumentOutline::Entry{title, dest, std::move(children)};
+}
+
+DocumentOutline makeOutline() {
+    std::vector<DocumentOutline::Entry> chapter1;
+    chapter1.emplace_back(makeEntry("1.1", 1));
+    chapter1.emplace_back(makeEntry("1.2", 3, {makeEntry("1.2.1", 4)}));
+
+    std::vector<DocumentOutline::Entry> entries;
+    entries.emplace_back(makeEntry("1", 0, std::move(chapter1)));
+    entries.emplace_back(makeEntry("2", 4));
+    return DocumentOutline(std::move(entries));
+}
+}  // namespace
+
+TEST(DocumentOutline, testSize) {
+    DocumentOutline outline = makeOutline();
+    EXPECT_EQ(5U, outline.size());
+    EXPECT_FALSE(outline.empty());
+    EXPECT_EQ(2U, outline.getEntries().size());
+
+    EXPECT_TRUE(DocumentOutline().empty());
+    EXPECT_EQ(0U, DocumentOutline().size());
+}
+
+TEST(DocumentOutline, testFindPdfPage) {
+    DocumentOutline outline = makeOutline();
+
+    auto path = outline.findPdfPage(3);
+    ASSERT_TRUE(path);
+    EXPECT_EQ((DocumentOutline::Path{0, 1}), *path);
+    EXPECT_EQ("1.2", outline.getEntry(*path).title);
+
+    // The first entry in document order, not the shallowest one
+    path = outline.findPdfPage(4);
+    ASSERT_TRUE(path);
+    EXPECT_EQ((DocumentOutline::Path{0, 1, 0}), *path);
+    EXPECT_EQ("1.2.1", outline.getEntry(*path).title);
+
+    EXPECT_FALSE(outline.findPdfPage(2));
+}
+
+TEST(DocumentOutline, testReadWithoutPdf) {
+    XojPdfDocument pdf;
+    std::atomic<bool> cancelled = false;
+    DocumentOutline outline = DocumentOutline::read(pdf, cancelled);
+    EXPECT_TRUE(outline.empty());
+}
@@ -0,0 +1,92 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/Document.h"
+#include "model/DocumentHandler.h"
+#include "model/DocumentListener.h"
+#include "model/XojPage.h"
+#include "util/Util.h"
+
+
+TEST(DocumentPageIndex, testIndexFollowsInsertAndDelete) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    auto first = std::make_shared<XojPage>(100, 100);
+    auto second = std::make_shared<XojPage>(100, 100);
+    auto third = std::make_shared<XojPage>(100, 100);
+    doc.addPage(first);
+    doc.addPage(second);
+
+    EXPECT_EQ(0U, doc.indexOf(first));
+    EXPECT_EQ(1U, doc.indexOf(second));
+    EXPECT_EQ(npos, doc.indexOf(third));
+
+    // Appending extends the index
+    doc.addPage(third);
+    EXPECT_EQ(2U, doc.indexOf(third));
+
+    doc.deletePage(0);
+    EXPECT_EQ(npos, doc.indexOf(first));
+    EXPECT_EQ(0U, doc.indexOf(second));
+    EXPECT_EQ(1U, doc.indexOf(third));
+
+    doc.insertPage(first, 1);
+    EXPECT_EQ(0U, doc.indexOf(second));
+    EXPECT_EQ(1U, doc.indexOf(first));
+    EXPECT_EQ(2U, doc.indexOf(third));
+}
+
+namespace {
+class CountingListener: public DocumentListener {
+public:
+    void pageChanged(size_t page) override { singleNotifications++; }
+
+    int singleNotifications = 0;
+};
+
+class BatchListener: public DocumentListener {
+public:
+    void pagesChanged(const std::vector<size_t>& pages) override {
+        batches++;
+        lastBatch = pages;
+    }
+
+    int batches = 0;
+    std::vector<size_t> lastBatch;
+};
+}  // namespace
+
+TEST(DocumentPageIndex, testPagesChangedBatch) {
+    DocumentHandler handler;
+    CountingListener counting;
+    BatchListener batch;
+    counting.registerListener(&handler);
+    batch.registerListener(&handler);
+
+    handler.firePagesChanged({1, 4, 7});
+
+    // By default, a batch is forwarded page by page
+    EXPECT_EQ(3, counting.singleNotifications);
+    EXPECT_EQ(1, batch.batches);
+    EXPECT_EQ((std::vector<size_t>{1, 4, 7}), batch.lastBatch);
+
+    // Empty batches are not notified
+    handler.firePagesChanged({});
+    EXPECT_EQ(1, batch.batches);
+
+    counting.unregisterListener();
+    batch.unregisterListener();
+}
@@ -0,0 +1,93 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "model/Document.h"
+#include "model/DocumentHandler.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+
+
+TEST(DocumentSnapshot, testUnchangedPagesAreShared) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    doc.addPage(std::make_shared<XojPage>(100, 100));
+    doc.addPage(std::make_shared<XojPage>(100, 100));
+
+    auto first = doc.createSnapshot();
+    auto second = doc.createSnapshot();
+
+    ASSERT_EQ(2U, first->getPageCount());
+    EXPECT_NE(doc.getPage(0), first->getPage(0));
+    EXPECT_EQ(first->getPage(0), second->getPage(0));
+    EXPECT_EQ(first->getPage(1), second->getPage(1));
+}
+
+TEST(DocumentSnapshot, testModifiedPageIsCopied) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    doc.addPage(std::make_shared<XojPage>(100, 100));
+    doc.addPage(std::make_shared<XojPage>(100, 100));
+
+    auto before = doc.createSnapshot();
+
+    auto* stroke = new Stroke();
+    stroke->addPoint(Point(10, 10));
+    stroke->addPoint(Point(20, 20));
+    doc.getPage(1)->getSelectedLayer()->addElement(stroke);
+
+    auto after = doc.createSnapshot();
+
+    // Only the modified page is copied again
+    EXPECT_EQ(before->getPage(0), after->getPage(0));
+    EXPECT_NE(before->getPage(1), after->getPage(1));
+
+    // The older snapshot is unaffected
+    EXPECT_TRUE(after->getPage(1)->isAnnotated());
+    EXPECT_FALSE(before->getPage(1)->isAnnotated());
+}
+
+TEST(DocumentSnapshot, testPageNotificationInvalidatesCopy) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    doc.addPage(std::make_shared<XojPage>(100, 100));
+
+    auto* stroke = new Stroke();
+    stroke->addPoint(Point(10, 10));
+    stroke->addPoint(Point(20, 20));
+    doc.getPage(0)->getSelectedLayer()->addElement(stroke);
+
+    auto before = doc.createSnapshot();
+
+    // Elements are modified in place, and the change is notified to the page
+    stroke->move(5, 5);
+    doc.getPage(0)->fireElementChanged(stroke);
+
+    auto after = doc.createSnapshot();
+    EXPECT_NE(before->getPage(0), after->getPage(0));
+}
+
+TEST(DocumentSnapshot, testUnusedCopiesAreNotKept) {
+    DocumentHandler handler;
+    Document doc(&handler);
+    doc.addPage(std::make_shared<XojPage>(100, 100));
+
+    std::weak_ptr<XojPage> copy = doc.getPageSnapshot(doc.getPage(0));
+    // Nobody uses the copy: the document does not keep it
+    EXPECT_TRUE(copy.expired());
+
+    auto snapshot = doc.createSnapshot();
+    EXPECT_EQ(snapshot->getPage(0), doc.getPageSnapshot(doc.getPage(0)));
+}
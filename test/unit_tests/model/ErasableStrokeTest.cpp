@@ -78,6 +78,60 @@ TEST(ErasableStroke, testOverlapTree) {
     }
 }
 
+TEST(ErasableStroke, testSegmentTree) {
+
+    // clang format off
+    std::vector<Point> testPath = {{0, 0},  {2, 2},  {5, 2}, {7, 4}, {3, 6}, {2, 8},
+                                   {5, 11}, {7, 10}, {7, 6}, {6, 7}, {4, 4}, {1, 3}};
+    // clang format on
+
+    Stroke stroke;
+    std::vector<Point>& strokePoints = const_cast<std::vector<Point>&>(stroke.getPointVector());
+    strokePoints.swap(testPath);
+
+    stroke.setWidth(2);
+    stroke.setFill(-1);
+    stroke.setToolType(StrokeTool::PEN);
+
+    const std::array<ErasableStroke::SubSection, 6> sections = {
+            ErasableStroke::SubSection{{0, 0.0}, {3, 0.5}}, ErasableStroke::SubSection{{2, 0.5}, {5, 1.0}},
+            ErasableStroke::SubSection{{0, 0.5}, {0, 0.75}}, ErasableStroke::SubSection{{5, 0.0}, {9, 0.0}},
+            ErasableStroke::SubSection{{7, 0.5}, {9, 1.0}}, ErasableStroke::SubSection{{8, 0.0}, {10, 1.0}}};
+
+    std::array<ErasableStroke::OverlapTree, 6> trees;
+    for (size_t i = 0; i < sections.size(); i++) { trees[i].populate(sections[i], stroke); }
+
+    ErasableStroke::OverlapTree segmentTree;
+    segmentTree.populate({{0, 0.0}, {10, 1.0}}, stroke);
+
+    // The tree of the whole stroke finds the same overlaps as the trees of the subsections
+    for (size_t i = 0; i < sections.size(); i++) {
+        for (size_t j = i + 1; j < sections.size(); j++) {
+            Range expected(5, 5);
+            trees[i].addOverlapsToRange(trees[j], 1, expected);
+            Range range(5, 5);
+            segmentTree.addOverlapsToRange(sections[i], sections[j], 1, range);
+            assertRangesEq(range, expected);
+        }
+    }
+
+    // Segments 1 and 2 meet at (5, 2)
+    auto segments = segmentTree.getSegmentsIntersecting(Rectangle<double>(4.5, 1.5, 1, 1));
+    ASSERT_EQ(segments.size(), 1U);
+    EXPECT_EQ(segments[0].min, 1U);
+    EXPECT_EQ(segments[0].max, 2U);
+
+    // Segments 0 and 10 pass by, at both ends of the stroke
+    segments = segmentTree.getSegmentsIntersecting(Rectangle<double>(0.5, 1.5, 1, 2));
+    ASSERT_EQ(segments.size(), 2U);
+    EXPECT_EQ(segments[0].min, 0U);
+    EXPECT_EQ(segments[0].max, 0U);
+    EXPECT_EQ(segments[1].min, 10U);
+    EXPECT_EQ(segments[1].max, 10U);
+
+    EXPECT_TRUE(segmentTree.getSegmentsIntersecting(Rectangle<double>(20, 20, 1, 1)).empty());
+}
+
 TEST(ErasableStroke, testGetStrokes) {
     std::array<Stroke, 3> strokes;
 
@@ -10,11 +10,13 @@
  */
 
 #include <fstream>
+#include <memory>
 
 #include <config-test.h>
 #include <gtest/gtest.h>
 
 #include "model/Image.h"
+#include "view/ImageCache.h"
 
 
 TEST(Image, testGetImageApplyOrientation) {
@@ -47,6 +49,32 @@ TEST(Image, testGetImageApplyOrientation) {
     // Test image now have the correct size - which is the image has been rotated.
     EXPECT_EQ(image.getImageSize(), rotatedImageSize);
     EXPECT_EQ(image.getImageSize(), std::make_pair(130, 500));
-    EXPECT_EQ(std::make_pair(cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface)),
+    EXPECT_EQ(std::make_pair(cairo_image_surface_get_width(surface.get()),
+                             cairo_image_surface_get_height(surface.get())),
               rotatedImageSize);
 }
+
+TEST(Image, testCacheLevels) {
+    std::ifstream imageFile{GET_TESTFILE("images/r90.jpg"), std::ios::binary};
+    auto image = Image();
+    image.setImage(std::string(std::istreambuf_iterator<char>(imageFile), {}));
+
+    // Clones share the encoded data, hence the decoded image
+    std::unique_ptr<Element> clone(image.clone());
+    EXPECT_EQ(image.getSharedData(), static_cast<Image*>(clone.get())->getSharedData());
+
+    auto& cache = xoj::view::ImageCache::getInstance();
+    auto full = cache.getSurface(image.getSharedData(), 1000, true);
+    ASSERT_TRUE(full);
+    EXPECT_EQ(cairo_image_surface_get_width(full.get()), 130);
+    EXPECT_EQ(full.get(), image.getImage().get());
+
+    // The smallest level at least as wide as requested
+    auto small = cache.getSurface(image.getSharedData(), 40, true);
+    ASSERT_TRUE(small);
+    EXPECT_EQ(cairo_image_surface_get_width(small.get()), 65);
+    EXPECT_EQ(cairo_image_surface_get_height(small.get()), 250);
+
+    // Already decoded: no need to wait
+    EXPECT_EQ(small.get(), cache.getSurface(image.getSharedData(), 40, false).get());
+}
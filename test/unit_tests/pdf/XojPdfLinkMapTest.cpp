@@ -0,0 +1,69 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdf/base/XojPdfLinkMap.h"
+#include "pdf/base/XojPdfPage.h"
+
+namespace {
+std::vector<XojPdfPage::Link> createLinks(const std::vector<XojPdfRectangle>& rects) {
+    std::vector<XojPdfPage::Link> links;
+    for (const auto& rect: rects) {
+        links.push_back(XojPdfPage::Link{rect, nullptr});
+    }
+    return links;
+}
+}  // namespace
+
+TEST(XojPdfLinkMap, testFindLink) {
+    // Two columns of index entries, and a tall link overlapping the right column
+    std::vector<XojPdfRectangle> rects;
+    for (int row = 0; row < 50; row++) {
+        rects.emplace_back(10, 10 + 12 * row, 90, 20 + 12 * row);
+        rects.emplace_back(110, 10 + 12 * row, 190, 20 + 12 * row);
+    }
+    rects.emplace_back(150, 0, 200, 400);
+    XojPdfLinkMap map(createLinks(rects));
+    EXPECT_EQ(101U, map.size());
+
+    EXPECT_EQ(&map.getLinks()[0], map.findLink(50, 15));
+    EXPECT_EQ(&map.getLinks()[2 * 20 + 1], map.findLink(120, 10 + 12 * 20 + 5));
+    // Borders are included
+    EXPECT_EQ(&map.getLinks()[2 * 49], map.findLink(10, 20 + 12 * 49));
+    EXPECT_EQ(&map.getLinks()[2 * 49], map.findLink(90, 10 + 12 * 49));
+
+    // The first link of the page wins
+    EXPECT_EQ(&map.getLinks()[2 * 3 + 1], map.findLink(160, 10 + 12 * 3 + 5));
+    EXPECT_EQ(&map.getLinks()[100], map.findLink(195, 10 + 12 * 3 + 5));
+    EXPECT_EQ(&map.getLinks()[100], map.findLink(160, 5));
+
+    // Between the rows, the columns, and outside of the links
+    EXPECT_EQ(nullptr, map.findLink(50, 21));
+    EXPECT_EQ(nullptr, map.findLink(100, 15));
+    EXPECT_EQ(nullptr, map.findLink(50, 5));
+    EXPECT_EQ(nullptr, map.findLink(50, 1000));
+    EXPECT_EQ(nullptr, map.findLink(195, 401));
+}
+
+TEST(XojPdfLinkMap, testDegenerateLinks) {
+    EXPECT_EQ(nullptr, XojPdfLinkMap().findLink(0, 0));
+    EXPECT_TRUE(XojPdfLinkMap().empty());
+
+    // Flat links, given with their corners swapped
+    XojPdfLinkMap map(createLinks({XojPdfRectangle(30, 10, 10, 10), XojPdfRectangle(50, 10, 40, 10)}));
+    EXPECT_EQ(&map.getLinks()[0], map.findLink(20, 10));
+    EXPECT_EQ(&map.getLinks()[1], map.findLink(45, 10));
+    EXPECT_EQ(nullptr, map.findLink(35, 10));
+    EXPECT_EQ(nullptr, map.findLink(20, 11));
+}
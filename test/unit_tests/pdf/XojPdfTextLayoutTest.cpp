@@ -0,0 +1,114 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "pdf/base/XojPdfPage.h"
+#include "pdf/base/XojPdfTextLayout.h"
+
+namespace {
+/**
+ * Lays out the text with 10pt wide and 20pt high characters, the lines 30pt apart
+ */
+XojPdfTextLayout createLayout(const std::string& text) {
+    std::vector<XojPdfTextLayout::Glyph> glyphs;
+    double x = 0;
+    double y = 0;
+    for (char c: text) {
+        glyphs.push_back({XojPdfRectangle(x, y, x + 10, y + 20), std::string(1, c)});
+        if (c == '\n') {
+            x = 0;
+            y += 30;
+        } else {
+            x += 10;
+        }
+    }
+    return XojPdfTextLayout(std::move(glyphs));
+}
+
+const std::string TEXT = "hello world\nsecond line\nthird";
+}  // namespace
+
+TEST(XojPdfTextLayout, testLines) {
+    XojPdfTextLayout layout = createLayout(TEXT);
+    EXPECT_EQ(3U, layout.getLineCount());
+    // The line breaks are not glyphs
+    EXPECT_EQ(TEXT.size() - 2, layout.getGlyphs().size());
+
+    EXPECT_TRUE(createLayout("").empty());
+    EXPECT_EQ(0U, createLayout("\n\n").getLineCount());
+}
+
+TEST(XojPdfTextLayout, testLinearSelection) {
+    XojPdfTextLayout layout = createLayout(TEXT);
+
+    // From the middle of "hello" to the middle of "second"
+    XojPdfRectangle rect(22, 10, 32, 40);
+    EXPECT_EQ("llo world\nsec", layout.selectText(rect, XojPdfPageSelectionStyle::Linear));
+
+    // The end point may be before the start point
+    XojPdfRectangle backwards(32, 40, 22, 10);
+    EXPECT_EQ("llo world\nsec", layout.selectText(backwards, XojPdfPageSelectionStyle::Linear));
+
+    auto selection = layout.selectTextLines(rect, XojPdfPageSelectionStyle::Linear);
+    ASSERT_EQ(2U, selection.rects.size());
+    EXPECT_DOUBLE_EQ(20, selection.rects[0].x1);
+    EXPECT_DOUBLE_EQ(110, selection.rects[0].x2);
+    EXPECT_DOUBLE_EQ(0, selection.rects[1].x1);
+    EXPECT_DOUBLE_EQ(30, selection.rects[1].x2);
+    EXPECT_DOUBLE_EQ(30, selection.rects[1].y1);
+
+    ASSERT_TRUE(selection.region);
+    EXPECT_TRUE(cairo_region_contains_point(selection.region.get(), 50, 10));
+    EXPECT_TRUE(cairo_region_contains_point(selection.region.get(), 5, 35));
+    EXPECT_FALSE(cairo_region_contains_point(selection.region.get(), 5, 10));
+    EXPECT_FALSE(cairo_region_contains_point(selection.region.get(), 50, 35));
+}
+
+TEST(XojPdfTextLayout, testWordAndLineSelection) {
+    XojPdfTextLayout layout = createLayout(TEXT);
+
+    XojPdfRectangle point(72, 10, 72, 10);
+    EXPECT_EQ("world", layout.selectText(point, XojPdfPageSelectionStyle::Word));
+    EXPECT_EQ("hello world", layout.selectText(point, XojPdfPageSelectionStyle::Line));
+
+    XojPdfRectangle twoLines(72, 10, 12, 70);
+    EXPECT_EQ("world\nsecond line\nthird", layout.selectText(twoLines, XojPdfPageSelectionStyle::Word));
+}
+
+TEST(XojPdfTextLayout, testAreaSelection) {
+    XojPdfTextLayout layout = createLayout(TEXT);
+
+    // Columns 1 to 3 of the first two lines
+    XojPdfRectangle area(15, 5, 35, 45);
+    EXPECT_EQ("ell\neco", layout.selectText(area, XojPdfPageSelectionStyle::Area));
+    auto selection = layout.selectTextLines(area, XojPdfPageSelectionStyle::Area);
+    EXPECT_EQ(2U, selection.rects.size());
+
+    XojPdfRectangle empty(200, 200, 300, 300);
+    EXPECT_EQ("", layout.selectText(empty, XojPdfPageSelectionStyle::Area));
+    EXPECT_TRUE(layout.selectTextLines(empty, XojPdfPageSelectionStyle::Area).rects.empty());
+}
+
+TEST(XojPdfTextLayout, testEmptyLayout) {
+    XojPdfTextLayout layout;
+    XojPdfRectangle rect(0, 0, 100, 100);
+    EXPECT_EQ("", layout.selectText(rect, XojPdfPageSelectionStyle::Linear));
+    auto selection = layout.selectTextLines(rect, XojPdfPageSelectionStyle::Linear);
+    EXPECT_TRUE(selection.rects.empty());
+    ASSERT_TRUE(selection.region);
+    EXPECT_EQ(0, cairo_region_num_rectangles(selection.region.get()));
+}
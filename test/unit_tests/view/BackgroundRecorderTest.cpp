@@ -0,0 +1,79 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "model/PageType.h"
+#include "model/XojPage.h"
+#include "util/Color.h"
+#include "util/raii/CairoWrappers.h"
+#include "view/background/BackgroundRecorder.h"
+
+using xoj::view::BackgroundRecorder;
+
+namespace {
+constexpr xoj::view::BackgroundFlags FLAGS = {xoj::view::HIDE_PDF_BACKGROUND, xoj::view::SHOW_IMAGE_BACKGROUND,
+                                              xoj::view::SHOW_RULING_BACKGROUND};
+
+xoj::util::CairoSPtr createContext() {
+    xoj::util::CairoSurfaceSPtr surface(cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, nullptr),
+                                        xoj::util::adopt);
+    return xoj::util::CairoSPtr(cairo_create(surface.get()), xoj::util::adopt);
+}
+}  // namespace
+
+TEST(BackgroundRecorder, testIdenticalBackgroundsAreShared) {
+    BackgroundRecorder recorder;
+    auto cr = createContext();
+
+    for (int n = 0; n < 10; n++) {
+        recorder.draw(std::make_shared<XojPage>(200, 300), cr.get(), FLAGS);
+    }
+    EXPECT_EQ(1U, recorder.size());
+
+    auto graph = std::make_shared<XojPage>(200, 300);
+    graph->setBackgroundType(PageType(PageTypeFormat::Graph));
+    recorder.draw(graph, cr.get(), FLAGS);
+    EXPECT_EQ(2U, recorder.size());
+
+    auto colored = std::make_shared<XojPage>(200, 300);
+    colored->setBackgroundColor(Color(0xffff0000U));
+    recorder.draw(colored, cr.get(), FLAGS);
+    EXPECT_EQ(3U, recorder.size());
+
+    recorder.draw(std::make_shared<XojPage>(300, 200), cr.get(), FLAGS);
+    EXPECT_EQ(4U, recorder.size());
+
+    EXPECT_EQ(CAIRO_STATUS_SUCCESS, cairo_status(cr.get()));
+}
+
+TEST(BackgroundRecorder, testPdfBackgroundsAreNotRecorded) {
+    BackgroundRecorder recorder;
+    auto cr = createContext();
+
+    auto page = std::make_shared<XojPage>(200, 300);
+    page->setBackgroundPdfPageNr(0);
+    recorder.draw(page, cr.get(), FLAGS);
+    EXPECT_EQ(0U, recorder.size());
+}
+
+TEST(BackgroundRecorder, testRecordingsAreBounded) {
+    BackgroundRecorder recorder;
+    auto cr = createContext();
+
+    for (size_t n = 0; n < 2 * BackgroundRecorder::MAX_RECORDINGS; n++) {
+        recorder.draw(std::make_shared<XojPage>(100 + static_cast<double>(n), 100), cr.get(), FLAGS);
+    }
+    EXPECT_EQ(BackgroundRecorder::MAX_RECORDINGS, recorder.size());
+}
@@ -0,0 +1,105 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <vector>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "model/Point.h"
+#include "model/Stroke.h"
+#include "view/StrokePathCache.h"
+
+using xoj::view::StrokePathCache;
+
+namespace {
+/**
+ * @return The points of the current path of the context
+ */
+std::vector<Point> currentPath(cairo_t* cr) {
+    std::vector<Point> pts;
+    cairo_path_t* path = cairo_copy_path(cr);
+    for (int i = 0; i < path->num_data; i += path->data[i].header.length) {
+        pts.emplace_back(path->data[i + 1].point.x, path->data[i + 1].point.y);
+    }
+    cairo_path_destroy(path);
+    cairo_new_path(cr);
+    return pts;
+}
+
+Stroke* createStroke(size_t pointCount) {
+    auto* s = new Stroke();
+    s->setWidth(1);
+    for (size_t i = 0; i < pointCount; i++) {
+        s->addPoint(Point(static_cast<double>(i), 2.0 * static_cast<double>(i)));
+    }
+    return s;
+}
+}  // namespace
+
+TEST(StrokePathCache, testFlattening) {
+    // The duplicated and almost equal points are dropped, except for the last point
+    std::vector<Point> pts = {Point(0, 0), Point(0, 0), Point(1, 1), Point(1.001, 1), Point(2, 1), Point(2, 1.001)};
+    auto data = StrokePathCache::buildPathData(pts);
+
+    ASSERT_EQ(8U, data.size());
+    EXPECT_EQ(CAIRO_PATH_MOVE_TO, data[0].header.type);
+    EXPECT_EQ(CAIRO_PATH_LINE_TO, data[2].header.type);
+    EXPECT_DOUBLE_EQ(1.0, data[3].point.x);
+    EXPECT_DOUBLE_EQ(2.0, data[5].point.x);
+    EXPECT_DOUBLE_EQ(1.001, data[7].point.y);
+
+    EXPECT_TRUE(StrokePathCache::buildPathData({}).empty());
+}
+
+TEST(StrokePathCache, testInvalidationByStrokeChanges) {
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 10, 10);
+    cairo_t* cr = cairo_create(surface);
+
+    StrokePathCache& cache = StrokePathCache::getInstance();
+    cache.clear();
+
+    Stroke* s = createStroke(StrokePathCache::MIN_POINTS);
+    cache.appendPath(cr, *s);
+    auto pts = currentPath(cr);
+    ASSERT_EQ(StrokePathCache::MIN_POINTS, pts.size());
+    EXPECT_DOUBLE_EQ(3.0, pts[3].x);
+    EXPECT_GT(cache.getBytes(), 0U);
+
+    // Drawing again reuses the cached path
+    const size_t bytes = cache.getBytes();
+    cache.appendPath(cr, *s);
+    EXPECT_EQ(pts.size(), currentPath(cr).size());
+    EXPECT_EQ(bytes, cache.getBytes());
+
+    s->move(10, 0);
+    cache.appendPath(cr, *s);
+    pts = currentPath(cr);
+    EXPECT_DOUBLE_EQ(13.0, pts[3].x);
+
+    s->addPoint(Point(100, 100));
+    cache.appendPath(cr, *s);
+    pts = currentPath(cr);
+    ASSERT_EQ(StrokePathCache::MIN_POINTS + 1, pts.size());
+    EXPECT_DOUBLE_EQ(100.0, pts.back().x);
+
+    // Small strokes are not cached
+    cache.clear();
+    Stroke* small = createStroke(2);
+    cache.appendPath(cr, *small);
+    EXPECT_EQ(2U, currentPath(cr).size());
+    EXPECT_EQ(0U, cache.getBytes());
+
+    delete small;
+    delete s;
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+}
@@ -0,0 +1,101 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "model/LineStyle.h"
+#include "model/Point.h"
+#include "util/raii/CairoWrappers.h"
+#include "view/StrokeViewHelper.h"
+
+namespace {
+constexpr int SIZE = 100;
+
+xoj::util::CairoSurfaceSPtr createSurface() {
+    return xoj::util::CairoSurfaceSPtr(cairo_image_surface_create(CAIRO_FORMAT_A8, SIZE, SIZE), xoj::util::adopt);
+}
+
+/**
+ * @return {number of painted pixels in a, number of pixels painted in only one of a and b}
+ */
+std::pair<int, int> compareCoverage(cairo_surface_t* a, cairo_surface_t* b) {
+    cairo_surface_flush(a);
+    cairo_surface_flush(b);
+    const int stride = cairo_image_surface_get_stride(a);
+    const unsigned char* dataA = cairo_image_surface_get_data(a);
+    const unsigned char* dataB = cairo_image_surface_get_data(b);
+    int painted = 0;
+    int different = 0;
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            const int alphaA = dataA[y * stride + x];
+            const int alphaB = dataB[y * stride + x];
+            painted += alphaA > 127;
+            different += std::abs(alphaA - alphaB) > 127;
+        }
+    }
+    return {painted, different};
+}
+
+void expectSameShape(const std::vector<Point>& pts, cairo_line_cap_t cap) {
+    auto stroked = createSurface();
+    auto filled = createSurface();
+    {
+        xoj::util::CairoSPtr cr(cairo_create(stroked.get()), xoj::util::adopt);
+        cairo_set_line_cap(cr.get(), cap);
+        xoj::view::StrokeViewHelper::drawWithPressure(cr.get(), pts, LineStyle());
+    }
+    {
+        xoj::util::CairoSPtr cr(cairo_create(filled.get()), xoj::util::adopt);
+        xoj::view::StrokeViewHelper::fillWithPressure(cr.get(), pts, cap);
+        EXPECT_EQ(CAIRO_STATUS_SUCCESS, cairo_status(cr.get()));
+    }
+
+    auto [painted, different] = compareCoverage(stroked.get(), filled.get());
+    EXPECT_GT(painted, 0);
+    // Only antialiasing differences along the edges
+    EXPECT_LE(different, painted / 50);
+}
+}  // namespace
+
+TEST(StrokeViewHelper, testFillWithPressureZigZag) {
+    std::vector<Point> pts = {Point(10, 10, 6), Point(30, 80, 6), Point(50, 20, 6), Point(70, 85, 6),
+                              Point(90, 15, 6)};
+    expectSameShape(pts, CAIRO_LINE_CAP_ROUND);
+    expectSameShape(pts, CAIRO_LINE_CAP_BUTT);
+    expectSameShape(pts, CAIRO_LINE_CAP_SQUARE);
+}
+
+TEST(StrokeViewHelper, testFillWithPressureSharpTurns) {
+    // Turns back on itself, in both directions: the overlapping parts of the outline must be filled
+    std::vector<Point> pts = {Point(10, 50, 8), Point(90, 50, 8), Point(20, 55, 8), Point(80, 20, 8),
+                              Point(80, 90, 8)};
+    expectSameShape(pts, CAIRO_LINE_CAP_ROUND);
+}
+
+TEST(StrokeViewHelper, testFillWithPressureVaryingWidth) {
+    std::vector<Point> pts;
+    for (int i = 0; i <= 40; i++) {
+        const double t = i / 40.0;
+        pts.emplace_back(10 + 80 * t, 50 + 30 * t * (1 - t) * (i % 2 ? 1 : 0.9), 2 + 6 * t);
+    }
+    expectSameShape(pts, CAIRO_LINE_CAP_ROUND);
+}
+
+TEST(StrokeViewHelper, testFillWithPressureDot) {
+    std::vector<Point> pts = {Point(50, 50, 10), Point(50, 50, 10)};
+    expectSameShape(pts, CAIRO_LINE_CAP_ROUND);
+}
@@ -0,0 +1,85 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "view/ThumbnailCache.h"
+
+using xoj::view::ThumbnailCache;
+
+TEST(ThumbnailCache, testBucketWidth) {
+    EXPECT_EQ(ThumbnailCache::BUCKET_WIDTH, ThumbnailCache::bucketWidth(0));
+    EXPECT_EQ(ThumbnailCache::BUCKET_WIDTH, ThumbnailCache::bucketWidth(1));
+    EXPECT_EQ(ThumbnailCache::BUCKET_WIDTH, ThumbnailCache::bucketWidth(ThumbnailCache::BUCKET_WIDTH));
+    EXPECT_EQ(2 * ThumbnailCache::BUCKET_WIDTH, ThumbnailCache::bucketWidth(ThumbnailCache::BUCKET_WIDTH + 0.5));
+}
+
+TEST(ThumbnailCache, testRevisions) {
+    auto& cache = ThumbnailCache::getInstance();
+    auto page = std::make_shared<int>(0);
+    int renderings = 0;
+    auto render = [&renderings](cairo_t* cr) {
+        renderings++;
+        cairo_paint(cr);
+    };
+
+    auto first = cache.get(page, 1, 200, 100, 50, render, true);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(1, renderings);
+    EXPECT_EQ(ThumbnailCache::bucketWidth(50), cairo_image_surface_get_width(first.get()));
+    EXPECT_EQ(ThumbnailCache::bucketWidth(50) / 2, cairo_image_surface_get_height(first.get()));
+
+    // Same revision and bucket: reused
+    EXPECT_EQ(first, cache.get(page, 1, 200, 100, 49, render, true));
+    EXPECT_EQ(1, renderings);
+
+    // New revision: rendered again
+    auto second = cache.get(page, 2, 200, 100, 50, render, true);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(2, renderings);
+
+    // Another size
+    cache.get(page, 2, 200, 100, 100, render, true);
+    EXPECT_EQ(3, renderings);
+}
+
+TEST(ThumbnailCache, testBackgroundRendering) {
+    auto& cache = ThumbnailCache::getInstance();
+    auto page = std::make_shared<int>(0);
+    std::atomic<int> renderings = 0;
+    auto render = [&renderings](cairo_t* cr) {
+        renderings++;
+        cairo_paint(cr);
+    };
+
+    std::promise<void> ready;
+    auto placeholder = cache.get(page, 1, 100, 100, 64, render, false, [&ready]() { ready.set_value(); });
+    EXPECT_FALSE(placeholder);
+    ASSERT_EQ(std::future_status::ready, ready.get_future().wait_for(std::chrono::seconds(10)));
+    EXPECT_EQ(1, renderings);
+
+    auto thumbnail = cache.get(page, 1, 100, 100, 64, render, false);
+    ASSERT_TRUE(thumbnail);
+    EXPECT_EQ(64, cairo_image_surface_get_width(thumbnail.get()));
+    EXPECT_EQ(1, renderings);
+
+    // While the new revision is rendered, the outdated thumbnail is the placeholder
+    std::promise<void> updated;
+    EXPECT_EQ(thumbnail, cache.get(page, 2, 100, 100, 64, render, false, [&updated]() { updated.set_value(); }));
+    ASSERT_EQ(std::future_status::ready, updated.get_future().wait_for(std::chrono::seconds(10)));
+    EXPECT_NE(thumbnail, cache.get(page, 2, 100, 100, 64, render, false));
+}